@@ -0,0 +1,112 @@
+/*
+Heap accounting for the host build: malloc and friends are replaced by counting wrappers around
+glibc's own allocator, so every allocation is seen - operator new, String, the C library and the
+firmware alike. The device heap has no such hook; this is how the benchmark attributes
+allocations to routes.
+*/
+#include "hal_sim.h"
+
+#include <errno.h>
+#include <malloc.h>
+
+#include <atomic>
+
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t n, size_t size);
+    void *__libc_realloc(void *ptr, size_t size);
+    void *__libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void *ptr);
+}
+
+static std::atomic<uint64_t> allocCount(0);
+static std::atomic<uint64_t> freeCount(0);
+static std::atomic<uint64_t> allocBytes(0);
+static std::atomic<int64_t> liveBytes(0);
+static std::atomic<int64_t> peakBytes(0);
+
+static void *counted(void *p, size_t size)
+{
+    if (!p)
+        return p;
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(size, std::memory_order_relaxed);
+    int64_t live = liveBytes.fetch_add((int64_t)malloc_usable_size(p), std::memory_order_relaxed) +
+                   (int64_t)malloc_usable_size(p);
+    int64_t peak = peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        ;
+    return p;
+}
+
+static void released(void *p)
+{
+    if (!p)
+        return;
+    freeCount.fetch_add(1, std::memory_order_relaxed);
+    liveBytes.fetch_sub((int64_t)malloc_usable_size(p), std::memory_order_relaxed);
+}
+
+extern "C"
+{
+    void *malloc(size_t size)
+    {
+        return counted(__libc_malloc(size), size);
+    }
+
+    void *calloc(size_t n, size_t size)
+    {
+        return counted(__libc_calloc(n, size), n * size);
+    }
+
+    void *realloc(void *ptr, size_t size)
+    {
+        size_t before = ptr ? malloc_usable_size(ptr) : 0;
+        void *p = __libc_realloc(ptr, size);
+        if (!p && size)
+            return p; // Failed, ptr is still allocated
+        if (ptr)
+        {
+            freeCount.fetch_add(1, std::memory_order_relaxed);
+            liveBytes.fetch_sub((int64_t)before, std::memory_order_relaxed);
+        }
+        return counted(p, size);
+    }
+
+    void free(void *ptr)
+    {
+        released(ptr);
+        __libc_free(ptr);
+    }
+
+    void *memalign(size_t alignment, size_t size)
+    {
+        return counted(__libc_memalign(alignment, size), size);
+    }
+
+    void *aligned_alloc(size_t alignment, size_t size)
+    {
+        return counted(__libc_memalign(alignment, size), size);
+    }
+
+    int posix_memalign(void **out, size_t alignment, size_t size)
+    {
+        void *p = counted(__libc_memalign(alignment, size), size);
+        if (!p)
+            return ENOMEM;
+        *out = p;
+        return 0;
+    }
+}
+
+HostAllocStats hostAllocStats()
+{
+    HostAllocStats s;
+    s.allocs = allocCount.load(std::memory_order_relaxed);
+    s.frees = freeCount.load(std::memory_order_relaxed);
+    s.bytes = allocBytes.load(std::memory_order_relaxed);
+    s.live = liveBytes.load(std::memory_order_relaxed);
+    s.peak = peakBytes.load(std::memory_order_relaxed);
+    return s;
+}
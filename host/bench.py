@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""
+End-to-end load benchmark for the host-native firmware (host/build/brew_host).
+
+Starts the binary, then drives each route in turn with tools/http_bench.py's keep-alive clients
+at every concurrency level. For each run it reports throughput, latency percentiles and the heap
+allocations per request; allocations are read from the simulation's /host/stats before and after
+the run, so everything the firmware allocated while serving the route is counted. An idle window
+measures the background rate (sampling, history, beacons) so it is not charged to routes.
+The binary runs with --no-admission, so the rate limits do not cap what is being measured;
+host/flood.py exercises them.
+
+    make -C host bench
+    python3 host/bench.py --binary host/build/brew_host --json result.json
+    python3 host/bench.py --binary host/build/brew_host --baseline result.json    # CI gate
+
+With --baseline, the run fails (exit 1) if any route gains allocations per request, loses more
+than --tolerance percent of its throughput, or sees errors. The load generator is Python, so the
+absolute req/s is bounded by the client on fast machines; compare runs from the same machine.
+"""
+import argparse
+import json
+import os
+import socket
+import subprocess
+import sys
+import time
+import urllib.request
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "tools"))
+import http_bench  # noqa: E402
+
+# Method, path - /events is a long-lived stream and /ota/* needs an upload session, both are left out
+ROUTES = [
+    ("GET", "/"),
+    ("GET", "/metrics"),
+    ("GET", "/metrics?format=cbor"),
+    ("GET", "/metrics/batch"),
+    ("GET", "/history"),
+    ("GET", "/schedule"),
+    ("GET", "/beacon"),
+    ("GET", "/debug/perf"),
+    ("GET", "/debug/perf?format=prometheus"),
+    ("POST", "/press"),
+    ("GET", "/missing"),
+]
+IDLE_S = 2.0  # Background allocation window
+
+
+def stats(port):
+    with urllib.request.urlopen(f"http://127.0.0.1:{port}/host/stats", timeout=5) as resp:
+        return json.loads(resp.read())
+
+
+def wait_for_port(port, proc, timeout=10.0):
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        if proc.poll() is not None:
+            sys.exit(f"brew_host exited with {proc.returncode} during start-up")
+        try:
+            with socket.create_connection(("127.0.0.1", port), timeout=0.2):
+                return
+        except OSError:
+            time.sleep(0.05)
+    sys.exit(f"port {port} did not open within {timeout:.0f} s")
+
+
+def run_route(args, method, path, clients, idle_rate):
+    load = argparse.Namespace(host="127.0.0.1", port=args.port, paths=[path], method=method,
+                              timeout=args.timeout, no_keepalive=False, duration=args.duration)
+    before = stats(args.control_port)
+    t0 = time.monotonic()
+    r = http_bench.run(load, clients)
+    elapsed = time.monotonic() - t0
+    after = stats(args.control_port)
+    served = after["http"]["requests"] - before["http"]["requests"]
+    allocs = max(0.0, after["allocs"] - before["allocs"] - idle_rate["allocs"] * elapsed)
+    nbytes = max(0.0, after["alloc_bytes"] - before["alloc_bytes"] - idle_rate["bytes"] * elapsed)
+    r.update({
+        "route": f"{method} {path}",
+        "served": served,
+        "allocs_per_req": allocs / served if served else 0.0,
+        "alloc_bytes_per_req": nbytes / served if served else 0.0,
+    })
+    return r
+
+
+def compare(results, baseline, tolerance):
+    failures = []
+    base = {(b["route"], b["clients"]): b for b in baseline["results"]}
+    for r in results:
+        b = base.get((r["route"], r["clients"]))
+        label = f"{r['route']} x{r['clients']}"
+        if r["errors"]:
+            failures.append(f"{label}: {r['errors']} errors")
+        if not b:
+            continue
+        if r["allocs_per_req"] > b["allocs_per_req"] + 0.05:
+            failures.append(f"{label}: {r['allocs_per_req']:.2f} allocations/request, baseline {b['allocs_per_req']:.2f}")
+        if b["rps"] and r["rps"] < b["rps"] * (1 - tolerance / 100.0):
+            failures.append(f"{label}: {r['rps']:.0f} req/s, baseline {b['rps']:.0f} (-{tolerance:.0f}% allowed)")
+    return failures
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("--binary", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "build", "brew_host"))
+    ap.add_argument("--port", type=int, default=8080, help="main server port (BREW_HTTP_PORT)")
+    ap.add_argument("--control-port", type=int, default=0, help="stats port (default: port + 1)")
+    ap.add_argument("--clients", type=int, nargs="+", default=[1, 8], help="concurrency levels per route")
+    ap.add_argument("--duration", type=float, default=2.0, help="seconds per route and level")
+    ap.add_argument("--timeout", type=float, default=5.0)
+    ap.add_argument("--routes", nargs="+", help="only routes whose path starts with one of these")
+    ap.add_argument("--json", help="write results to this file")
+    ap.add_argument("--baseline", help="compare against a previous --json file and fail on regressions")
+    ap.add_argument("--tolerance", type=float, default=30.0, help="allowed req/s drop against the baseline, percent")
+    args = ap.parse_args()
+    args.control_port = args.control_port or args.port + 1
+
+    env = dict(os.environ, BREW_HTTP_PORT=str(args.port))
+    proc = subprocess.Popen([args.binary, "--quiet", "--no-admission", "--control-port", str(args.control_port)],
+                            env=env, stdout=subprocess.DEVNULL)
+    try:
+        wait_for_port(args.port, proc)
+        wait_for_port(args.control_port, proc)
+        routes = [r for r in ROUTES if not args.routes or any(r[1].startswith(p) for p in args.routes)]
+        for method, path in routes:  # Warm-up: first-use allocations are not a per-request cost
+            http_bench.run(argparse.Namespace(host="127.0.0.1", port=args.port, paths=[path], method=method,
+                                              timeout=args.timeout, no_keepalive=False, duration=0.2), 1)
+        s0 = stats(args.control_port)
+        time.sleep(IDLE_S)
+        s1 = stats(args.control_port)
+        idle = {"allocs": (s1["allocs"] - s0["allocs"]) / IDLE_S, "bytes": (s1["alloc_bytes"] - s0["alloc_bytes"]) / IDLE_S}
+
+        print(f"[BENCH] host build on :{args.port}, {args.duration:g} s per run, idle {idle['allocs']:.1f} allocations/s")
+        print("%-32s %7s %8s %6s %9s %8s %8s %8s %8s %9s %10s"
+              % ("route", "clients", "requests", "errors", "req/s", "p50 ms", "p90 ms", "p99 ms", "max ms", "allocs/req", "bytes/req"))
+        results = []
+        for method, path in routes:
+            for clients in args.clients:
+                r = run_route(args, method, path, clients, idle)
+                results.append(r)
+                print("%-32s %7d %8d %6d %9.1f %8.2f %8.2f %8.2f %8.2f %9.2f %10.1f"
+                      % (r["route"][:32], clients, r["requests"], r["errors"], r["rps"], r["p50"], r["p90"], r["p99"],
+                         r["max"], r["allocs_per_req"], r["alloc_bytes_per_req"]))
+        final = stats(args.control_port)
+    finally:
+        proc.terminate()
+        proc.wait(timeout=10)
+
+    print(f"[BENCH] peak heap {final['peak_bytes']} bytes, {final['http']['timeouts']} timeouts, "
+          f"{final['http']['evicted_idle']} idle evictions, {final['http']['bad_requests']} bad requests")
+    doc = {"idle_allocs_per_s": idle["allocs"], "peak_bytes": final["peak_bytes"], "results": results}
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(doc, f, indent=1)
+    if args.baseline:
+        with open(args.baseline) as f:
+            failures = compare(results, json.load(f), args.tolerance)
+        for line in failures:
+            print("   FAIL: " + line)
+        print("FAILED" if failures else "OK (no regression against %s)" % args.baseline)
+        sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+"""
+/press flood test for the host-native firmware (host/build/brew_host): does admission control
+keep /metrics responsive while a script hammers the brew button?
+
+A prober fetches /metrics at a steady, browser-like rate from 127.0.0.1 and records its latency,
+first on an otherwise idle server, then while --flood-clients keep-alive clients POST /press as
+fast as they can from 127.0.0.2 (another client address as far as the server can tell). Once the
+flood is running, 127.0.0.1 also presses once, as a person at the UI would. The flood runs in a
+separate process so it does not share the prober's interpreter lock. Reports the prober's
+percentiles for both phases, the flood's status codes, the server's refusal counters, the
+bystander's press and how often the simulated coffee maker was actually toggled.
+
+    make -C host flood
+    python3 host/flood.py --binary host/build/brew_host --duration 20 --compare
+
+--compare repeats the run with --no-admission to show what the limits buy. Exits 1 if, with
+admission on, the flooded p99 exceeds --p99-factor times the idle p99 (plus --p99-slack-ms), the
+prober is refused or fails, the bystander's press is refused, or the flood toggled the machine more
+often than one address's /press bucket allows.
+"""
+import argparse
+import http.client
+import json
+import os
+import subprocess
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "tools"))
+import http_bench  # noqa: E402
+from bench import stats, wait_for_port  # noqa: E402
+
+PRESS_BURST = 5      # ADMIT_PRESS in src/main.cpp: 5 back-to-back per address, then one per 3 s
+PRESS_PERIOD_S = 3.0
+FLOOD_SOURCE = "127.0.0.2"
+
+
+def probe(port, rate, duration):
+    """GET /metrics every 1/rate seconds on one keep-alive connection, return latencies and failures."""
+    lat, codes, errors = [], {}, 0
+    conn = None
+    interval = 1.0 / rate
+    next_at = time.monotonic()
+    stop_at = next_at + duration
+    while next_at < stop_at:
+        time.sleep(max(0.0, next_at - time.monotonic()))
+        next_at += interval
+        t0 = time.perf_counter()
+        try:
+            if conn is None:
+                conn = http.client.HTTPConnection("127.0.0.1", port, timeout=5)
+            conn.request("GET", "/metrics")
+            resp = conn.getresponse()
+            resp.read()
+            lat.append((time.perf_counter() - t0) * 1000.0)
+            codes[resp.status] = codes.get(resp.status, 0) + 1
+            if resp.getheader("Connection", "").lower() == "close":
+                conn.close()
+                conn = None
+        except (OSError, http.client.HTTPException):
+            errors += 1
+            if conn is not None:
+                conn.close()
+            conn = None
+    if conn is not None:
+        conn.close()
+    lat.sort()
+    return {
+        "requests": len(lat),
+        "errors": errors,
+        "codes": codes,
+        "p50": http_bench.percentile(lat, 50),
+        "p99": http_bench.percentile(lat, 99),
+        "max": lat[-1] if lat else float("nan"),
+    }
+
+
+def press_once(port, attempts=3):
+    """POST /press from 127.0.0.1, retrying while the relay is busy; return the last status (0 = failed)."""
+    status = 0
+    for _ in range(attempts):
+        conn = http.client.HTTPConnection("127.0.0.1", port, timeout=5)
+        try:
+            conn.request("POST", "/press")
+            resp = conn.getresponse()
+            resp.read()
+            status = resp.status
+            if status != 409:
+                break
+            time.sleep(float(resp.getheader("Retry-After", "1")))
+        except (OSError, http.client.HTTPException):
+            status = 0
+        finally:
+            conn.close()
+    return status
+
+
+def flood_worker(args):
+    """Child process: flood POST /press and print http_bench's result as JSON."""
+    load = argparse.Namespace(host="127.0.0.1", port=args.port, paths=["/press"], method="POST",
+                              timeout=5.0, no_keepalive=False, duration=args.duration, source=FLOOD_SOURCE)
+    print(json.dumps(http_bench.run(load, args.flood_clients)))
+
+
+def scenario(args, admission):
+    cmd = [args.binary, "--quiet", "--control-port", str(args.port + 1)]
+    if not admission:
+        cmd.append("--no-admission")
+    proc = subprocess.Popen(cmd, env=dict(os.environ, BREW_HTTP_PORT=str(args.port)), stdout=subprocess.DEVNULL)
+    try:
+        wait_for_port(args.port, proc)
+        wait_for_port(args.port + 1, proc)
+        idle = probe(args.port, args.rate, args.duration)
+        before = stats(args.port + 1)
+        flood = subprocess.Popen([sys.executable, os.path.abspath(__file__), "--flood-worker", "--port", str(args.port),
+                                  "--duration", str(args.duration), "--flood-clients", str(args.flood_clients)],
+                                 stdout=subprocess.PIPE)
+        time.sleep(0.5)  # Let the flood reach full speed and drain its /press bucket before pressing and probing
+        bystander = press_once(args.port)
+        flooded = probe(args.port, args.rate, args.duration - 1.0)
+        out, _ = flood.communicate(timeout=args.duration + 30)
+        after = stats(args.port + 1)
+    finally:
+        proc.terminate()
+        proc.wait(timeout=10)
+    return {
+        "admission": admission,
+        "idle": idle,
+        "flooded": flooded,
+        "flood": json.loads(out),
+        "bystander": bystander,
+        "presses": after["machine"]["presses"] - before["machine"]["presses"],
+        "rate_limited": after["http"]["rate_limited"] - before["http"]["rate_limited"],
+        "shed": after["http"]["shed"] - before["http"]["shed"],
+        "queue_peak": after["http"]["queue_peak"],
+        "requests": after["http"]["requests"] - before["http"]["requests"],
+    }
+
+
+def report(r):
+    label = "admission on" if r["admission"] else "admission off"
+    f = r["flood"]
+    print(f"[FLOOD] {label}")
+    for phase in ("idle", "flooded"):
+        p = r[phase]
+        print("   /metrics %-8s %5d requests %3d errors  p50 %7.2f ms  p99 %7.2f ms  max %7.2f ms  status %s"
+              % (phase, p["requests"], p["errors"], p["p50"], p["p99"], p["max"], p["codes"]))
+    codes = " ".join(f"{c} x{n}" for c, n in f["codes"].items())
+    print(f"   /press flood  {f['requests']} responses ({f['rps']:.0f}/s), {f['errors']} errors, status {codes}")
+    print(f"   bystander     POST /press from 127.0.0.1 answered {r['bystander']}")
+    print(f"   server        {r['requests']} dispatched, {r['rate_limited']} rate limited, {r['shed']} shed, "
+          f"queue peak {r['queue_peak']}; machine toggled {r['presses']} times")
+
+
+def check(args, r):
+    failures = []
+    idle, flooded = r["idle"], r["flooded"]
+    limit = idle["p99"] * args.p99_factor + args.p99_slack_ms
+    if flooded["p99"] > limit:
+        failures.append(f"/metrics p99 {flooded['p99']:.2f} ms under flood, limit {limit:.2f} ms")
+    for phase in ("idle", "flooded"):
+        if r[phase]["errors"] or set(r[phase]["codes"]) - {200}:
+            failures.append(f"/metrics prober refused or failed while {phase}: {r[phase]['codes']}, {r[phase]['errors']} errors")
+    if r["bystander"] != 303:
+        failures.append(f"bystander's press answered {r['bystander']} during the flood, expected 303")
+    allowed = PRESS_BURST + int(args.duration / PRESS_PERIOD_S) + 1 + 1  # + the bystander's press
+    if r["presses"] > allowed:
+        failures.append(f"machine toggled {r['presses']} times, one flooding address's /press bucket allows {allowed - 1}")
+    return failures
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("--binary", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "build", "brew_host"))
+    ap.add_argument("--port", type=int, default=8090, help="main server port, stats on port + 1")
+    ap.add_argument("--duration", type=float, default=10.0, help="seconds per phase")
+    ap.add_argument("--rate", type=float, default=10.0, help="/metrics probes per second (keep under the per-client limit)")
+    ap.add_argument("--flood-clients", type=int, default=8)
+    ap.add_argument("--compare", action="store_true", help="also run without admission control")
+    ap.add_argument("--p99-factor", type=float, default=3.0)
+    ap.add_argument("--p99-slack-ms", type=float, default=5.0)
+    ap.add_argument("--flood-worker", action="store_true", help=argparse.SUPPRESS)
+    args = ap.parse_args()
+    if args.flood_worker:
+        flood_worker(args)
+        return
+
+    results = [scenario(args, True)]
+    if args.compare:
+        results.append(scenario(args, False))
+    for r in results:
+        report(r)
+    failures = check(args, results[0])
+    for line in failures:
+        print("   FAIL: " + line)
+    print("FAILED" if failures else "OK (/metrics held up under the /press flood)")
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+"""
+Sketch preprocessing for the host build, as the Arduino builder does it for the device.
+
+src/main.cpp is written as an Arduino sketch: it never includes Arduino.h and calls functions
+before their definitions. This writes a translation unit that includes Arduino.h, declares a
+prototype for every top-level function ahead of the first definition, and keeps #line markers so
+compiler errors point at src/main.cpp.
+
+    python3 host/gen_sketch.py src/main.cpp host/build/sketch.cpp
+"""
+import os
+import re
+import sys
+
+# Top-level definition: return type and name on one line, opening brace on the next
+DEFINITION = re.compile(r"^((?:const )?[A-Za-z_][\w:<>]*\s*\*?\s*([A-Za-z_]\w*)\(([^;{)]*)\))\s*\n\{", re.M)
+KEYWORDS = {"if", "while", "for", "switch", "return"}
+
+
+def prototypes(source):
+    protos = []
+    for m in DEFINITION.finditer(source):
+        if m.group(2) in KEYWORDS:
+            continue
+        protos.append(re.sub(r"\s*=\s*[^,)]+", "", m.group(1)) + ";")  # Default arguments stay on the definition
+    return protos
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__.strip())
+    src, out = sys.argv[1], sys.argv[2]
+    with open(src) as f:
+        source = f.read()
+    first = DEFINITION.search(source)
+    if not first:
+        sys.exit(f"{src}: no function definitions")
+    line = source.count("\n", 0, first.start()) + 1
+    path = os.path.abspath(src)
+    text = (
+        "#include <Arduino.h>\n"
+        f'#line 1 "{path}"\n'
+        + source[: first.start()]
+        + "\n".join(prototypes(source))
+        + f'\n#line {line} "{path}"\n'
+        + source[first.start() :]
+    )
+    os.makedirs(os.path.dirname(out) or ".", exist_ok=True)
+    with open(out, "w") as f:
+        f.write(text)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,481 @@
+#include "hal_sim.h"
+
+#include <Arduino.h>
+#include <ElegantOTA.h>
+#include <ESPmDNS.h>
+#include <Preferences.h>
+#include <Update.h>
+#include <WiFi.h>
+#include <esp_timer.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+static HostOptions options;
+static const std::chrono::steady_clock::time_point realStart = std::chrono::steady_clock::now();
+
+void hostConfigure(const HostOptions &opts)
+{
+    options = opts;
+}
+
+const HostOptions &hostOptions()
+{
+    return options;
+}
+
+uint64_t hostMicros()
+{
+    auto real = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - realStart);
+    return (uint64_t)options.millisStart * 1000ULL + (uint64_t)real.count();
+}
+
+uint16_t hostHttpPort()
+{
+    const char *env = getenv("BREW_HTTP_PORT");
+    int port = env ? atoi(env) : 0;
+    return port > 0 && port < 65536 ? (uint16_t)port : 8080;
+}
+
+/*------- Core -------*/
+
+HardwareSerial Serial;
+EspClass ESP;
+MDNSResponder MDNS;
+ElegantOTAClass ElegantOTA;
+
+unsigned long millis()
+{
+    return (uint32_t)(hostMicros() / 1000ULL);
+}
+
+unsigned long micros()
+{
+    return (uint32_t)hostMicros();
+}
+
+void delay(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void yield()
+{
+    std::this_thread::yield();
+}
+
+static std::atomic<uint8_t> pinLevel[64];
+
+void pinMode(uint8_t, uint8_t)
+{
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    if (pin >= 64)
+        return;
+    uint8_t before = pinLevel[pin].exchange(value);
+    if (pin == HOST_RELAY_PIN && before != value)
+        machineRelay(value == LOW, hostMicros());
+}
+
+int digitalRead(uint8_t pin)
+{
+    return pin < 64 ? pinLevel[pin].load() : LOW;
+}
+
+static uint32_t cpuMhz = 160;
+
+bool setCpuFrequencyMhz(uint32_t mhz)
+{
+    cpuMhz = mhz;
+    return true;
+}
+
+uint32_t getCpuFrequencyMhz()
+{
+    return cpuMhz;
+}
+
+uint32_t esp_random()
+{
+    static std::mt19937 rng(std::random_device{}());
+    return rng();
+}
+
+void configTzTime(const char *tz, const char *, const char *, const char *)
+{
+    setenv("TZ", tz, 1); // The host clock stands in for SNTP - it is valid from the start
+    tzset();
+}
+
+#if !(__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 38))
+size_t strlcpy(char *dst, const char *src, size_t size)
+{
+    size_t len = strlen(src);
+    if (size)
+    {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+String::String(const char *s)
+{
+    len = strlen(s);
+    buf = (char *)malloc(len + 1);
+    memcpy(buf, s, len + 1);
+}
+
+String::String(const String &other) : String(other.c_str())
+{
+}
+
+String &String::operator=(const String &other)
+{
+    if (this != &other)
+    {
+        free(buf);
+        len = other.len;
+        buf = (char *)malloc(len + 1);
+        memcpy(buf, other.c_str(), len + 1);
+    }
+    return *this;
+}
+
+String::~String()
+{
+    free(buf);
+}
+
+String IPAddress::toString() const
+{
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", addr[0], addr[1], addr[2], addr[3]);
+    return String(text);
+}
+
+size_t HardwareSerial::printf(const char *fmt, ...)
+{
+    if (options.quiet)
+        return 0;
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vprintf(fmt, ap);
+    va_end(ap);
+    fflush(stdout);
+    return n > 0 ? (size_t)n : 0;
+}
+
+size_t HardwareSerial::print(const char *s)
+{
+    return printf("%s", s);
+}
+
+size_t HardwareSerial::println(const char *s)
+{
+    return printf("%s\n", s);
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+    int64_t live = hostAllocStats().live;
+    return live >= (int64_t)HOST_HEAP_BYTES ? 0 : HOST_HEAP_BYTES - (uint32_t)live;
+}
+
+uint32_t EspClass::getMaxAllocHeap()
+{
+    return getFreeHeap();
+}
+
+uint32_t EspClass::getMinFreeHeap()
+{
+    int64_t peak = hostAllocStats().peak;
+    return peak >= (int64_t)HOST_HEAP_BYTES ? 0 : HOST_HEAP_BYTES - (uint32_t)peak;
+}
+
+void EspClass::restart()
+{
+    printf("[HOST] ESP.restart() - exiting\n");
+    fflush(stdout);
+    exit(0);
+}
+
+/*------- esp_timer -------*/
+
+struct esp_timer
+{
+    esp_timer_create_args_t args;
+    std::mutex lock;
+    std::condition_variable cv;
+    int64_t deadlineUs = -1; // esp_timer_get_time() of the pending shot (-1 = not armed)
+    std::thread worker;
+};
+
+// One thread per timer, standing in for the esp_timer task
+static void timerThread(esp_timer *t)
+{
+    std::unique_lock<std::mutex> guard(t->lock);
+    for (;;)
+    {
+        if (t->deadlineUs < 0)
+        {
+            t->cv.wait(guard);
+            continue;
+        }
+        int64_t left = t->deadlineUs - esp_timer_get_time();
+        if (left > 0)
+        {
+            t->cv.wait_for(guard, std::chrono::microseconds(left));
+            continue;
+        }
+        t->deadlineUs = -1; // Disarmed before the callback, which may start it again
+        guard.unlock();
+        t->args.callback(t->args.arg);
+        guard.lock();
+    }
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out)
+{
+    esp_timer *t = new esp_timer();
+    t->args = *args;
+    t->worker = std::thread(timerThread, t);
+    t->worker.detach(); // Timers live as long as the firmware
+    *out = t;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t t, uint64_t timeoutUs)
+{
+    std::lock_guard<std::mutex> guard(t->lock);
+    if (t->deadlineUs >= 0)
+        return ESP_ERR_INVALID_STATE; // Already running, as on the device
+    t->deadlineUs = esp_timer_get_time() + (int64_t)timeoutUs;
+    t->cv.notify_one();
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t t)
+{
+    std::lock_guard<std::mutex> guard(t->lock);
+    if (t->deadlineUs < 0)
+        return ESP_ERR_INVALID_STATE;
+    t->deadlineUs = -1;
+    t->cv.notify_one();
+    return ESP_OK;
+}
+
+int64_t esp_timer_get_time()
+{
+    return (int64_t)(hostMicros() - (uint64_t)options.millisStart * 1000ULL);
+}
+
+/*------- Wi-Fi -------*/
+
+const uint32_t WIFI_ASSOC_MS = 300; // Simulated association + DHCP time
+WiFiClass WiFi;
+static wifi_mode_t wifiMode = WIFI_OFF;
+static uint32_t staBeginMs = 0;
+static bool staStarted = false;
+static bool apUp = false;
+static uint8_t bssid[6] = {0x02, 0x00, 0x00, 0x00, 0xAC, 0x01};
+static const uint8_t MAC[6] = {0x02, 0x00, 0x00, 0xB5, 0xE7, 0x01}; // Locally administered
+
+bool WiFiClass::mode(wifi_mode_t m)
+{
+    wifiMode = m;
+    if (m == WIFI_AP)
+        staStarted = false;
+    return true;
+}
+
+bool WiFiClass::setTxPower(wifi_power_t)
+{
+    return true;
+}
+
+bool WiFiClass::setSleep(bool)
+{
+    return true;
+}
+
+bool WiFiClass::setAutoReconnect(bool)
+{
+    return true;
+}
+
+bool WiFiClass::disconnect(bool, bool)
+{
+    staStarted = false;
+    return true;
+}
+
+bool WiFiClass::config(IPAddress, IPAddress, IPAddress, IPAddress)
+{
+    return true;
+}
+
+wl_status_t WiFiClass::begin(const char *, const char *, int32_t, const uint8_t *)
+{
+    staStarted = true;
+    staBeginMs = millis();
+    return WL_DISCONNECTED;
+}
+
+wl_status_t WiFiClass::status()
+{
+    if (!staStarted || !options.wifi || wifiMode == WIFI_AP || wifiMode == WIFI_OFF)
+        return WL_DISCONNECTED;
+    return (uint32_t)millis() - staBeginMs >= WIFI_ASSOC_MS ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+IPAddress WiFiClass::localIP()
+{
+    return status() == WL_CONNECTED ? IPAddress(127, 0, 0, 1) : IPAddress();
+}
+
+IPAddress WiFiClass::gatewayIP()
+{
+    return status() == WL_CONNECTED ? IPAddress(127, 0, 0, 1) : IPAddress();
+}
+
+IPAddress WiFiClass::subnetMask()
+{
+    return IPAddress(255, 0, 0, 0);
+}
+
+IPAddress WiFiClass::dnsIP()
+{
+    return IPAddress(127, 0, 0, 1);
+}
+
+uint8_t *WiFiClass::BSSID()
+{
+    return bssid;
+}
+
+int32_t WiFiClass::channel()
+{
+    return 6;
+}
+
+int8_t WiFiClass::RSSI()
+{
+    return status() == WL_CONNECTED ? (int8_t)(-58 - (int)(esp_random() % 5)) : 0;
+}
+
+uint8_t *WiFiClass::macAddress(uint8_t *mac)
+{
+    memcpy(mac, MAC, sizeof(MAC));
+    return mac;
+}
+
+bool WiFiClass::softAP(const char *, const char *)
+{
+    apUp = true;
+    return true;
+}
+
+bool WiFiClass::softAPdisconnect(bool)
+{
+    apUp = false;
+    return true;
+}
+
+IPAddress WiFiClass::softAPIP()
+{
+    return apUp ? IPAddress(192, 168, 4, 1) : IPAddress();
+}
+
+/*------- NVS -------*/
+
+static std::mutex nvsLock;
+static std::map<std::string, std::string> nvs; // "namespace/key" -> value bytes
+
+bool Preferences::begin(const char *name, bool)
+{
+    strlcpy(ns, name, sizeof(ns));
+    return true;
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen)
+{
+    std::lock_guard<std::mutex> guard(nvsLock);
+    auto it = nvs.find(std::string(ns) + "/" + key);
+    if (it == nvs.end() || it->second.size() > maxLen)
+        return 0;
+    memcpy(buf, it->second.data(), it->second.size());
+    return it->second.size();
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t len)
+{
+    std::lock_guard<std::mutex> guard(nvsLock);
+    nvs[std::string(ns) + "/" + key].assign((const char *)value, len);
+    return len;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t defaultValue)
+{
+    uint32_t v;
+    return getBytes(key, &v, sizeof(v)) == sizeof(v) ? v : defaultValue;
+}
+
+size_t Preferences::putUInt(const char *key, uint32_t value)
+{
+    return putBytes(key, &value, sizeof(value));
+}
+
+/*------- OTA partition -------*/
+
+UpdateClass Update;
+
+bool UpdateClass::begin(size_t size, int)
+{
+    expected = size;
+    written = 0;
+    running = true;
+    error = nullptr;
+    return true;
+}
+
+bool UpdateClass::setMD5(const char *md5)
+{
+    return md5 && strlen(md5) == 32;
+}
+
+size_t UpdateClass::write(uint8_t *, size_t len)
+{
+    if (!running)
+        return 0;
+    written += len;
+    return len;
+}
+
+bool UpdateClass::end(bool evenIfRemaining)
+{
+    if (!running)
+        return false;
+    running = false;
+    if (!evenIfRemaining && expected != UPDATE_SIZE_UNKNOWN && written != expected)
+    {
+        error = "Bad Size Given";
+        return false;
+    }
+    return true;
+}
+
+void UpdateClass::abort()
+{
+    running = false;
+    error = "Aborted";
+}
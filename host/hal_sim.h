@@ -0,0 +1,54 @@
+/*
+Simulated board for the host build of Embedded Brew.
+
+host/include/ holds the Arduino-ESP32 API the sketch uses; this is the other side of that boundary.
+hal_sim.cpp provides the clock, GPIO, Wi-Fi, NVS, OTA and timer services. sim_machine.cpp provides
+the hardware: a BMP280 on the I2C bus and a drip coffee maker whose toggle button is the relay.
+alloc_count.cpp counts every heap allocation. host_main.cpp runs setup()/loop() against all of
+it and exposes the simulation state to benchmarks.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+const uint8_t HOST_RELAY_PIN = 2;        // RELAY_PIN in main.cpp - LOW holds the machine's button
+const uint8_t HOST_BMP_ADDR = 0x76;      // Address the simulated BMP280 answers on
+const uint32_t HOST_HEAP_BYTES = 327680; // Heap reported by ESP.getFreeHeap() before host allocations
+
+struct HostOptions
+{
+    uint32_t millisStart = 0; // millis() at boot, near 2^32 to cross the rollover (unsigned long is
+                              // 64-bit here, so only uint32_t arithmetic wraps as on the device)
+    bool wifi = true;         // STA network reachable (false exercises the AP fallback)
+    bool sensor = true;       // BMP280 present on the bus
+    bool quiet = false;       // Drop Serial output
+};
+
+void hostConfigure(const HostOptions &opts); // Apply before setup()
+const HostOptions &hostOptions();
+uint64_t hostMicros();                        // Microseconds since boot, millisStart included
+uint16_t hostHttpPort();                      // Main server port: BREW_HTTP_PORT from the environment, else 8080
+
+// Simulated coffee maker
+struct MachineState
+{
+    bool on;           // Heater/plate powered
+    uint32_t presses;  // Completed button presses
+    uint32_t onForMs;  // Time since switched on (0 when off)
+    float tempC;       // Sensor temperature at the pot
+    float pressureHpa; // Ambient pressure
+};
+void machineRelay(bool closed, uint64_t nowUs); // Relay edge from digitalWrite()
+MachineState machineState(uint64_t nowUs);
+
+// Heap use by every thread since process start
+struct HostAllocStats
+{
+    uint64_t allocs; // malloc/calloc/realloc/new calls
+    uint64_t frees;
+    uint64_t bytes;  // Bytes requested
+    int64_t live;    // Bytes currently allocated
+    int64_t peak;    // Highest live
+};
+HostAllocStats hostAllocStats();
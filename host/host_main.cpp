@@ -0,0 +1,164 @@
+/*
+Host-native Embedded Brew: runs the firmware's own setup() and loop() on Linux against the
+simulated board in hal_sim.h.
+
+    make -C host
+    BREW_HTTP_PORT=8080 host/build/brew_host [options]
+
+Options:
+    --control-port N   simulation stats on GET /host/stats (default: HTTP port + 1, 0 = off)
+    --millis-start N   millis() at boot, e.g. 4294900000 to cross the rollover a minute in
+    --no-wifi          STA network never answers (AP fallback path)
+    --no-sensor        no BMP280 on the bus
+    --run-for S        exit after S seconds
+    --quiet            drop Serial output
+    --no-admission     after setup(), drop the server's rate limits and queue bounds (raw throughput)
+
+/host/stats reports heap allocations (every thread, since start), the main server's counters and
+the coffee maker's state; host/bench.py reads it before and after each route to attribute
+allocations. The control port is served on its own thread, so a reading is not held back while
+loop() waits (up to POWER_MAX_WAIT_MS) for the firmware's sockets; the server counters it reports
+are read without locking and may be a request behind. SIGINT/SIGTERM end the run after the
+current loop() iteration.
+*/
+#include <signal.h>
+
+#include <thread>
+
+#include <Arduino.h>
+
+#include "hal_sim.h"
+#include "http_server.h"
+#include "json_writer.h"
+
+void setup();
+void loop();
+extern HttpServer server;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int)
+{
+    stopRequested = 1;
+}
+
+static void handleHostStats(const HttpRequest &, HttpResponse &res)
+{
+    HostAllocStats a = hostAllocStats();
+    const HttpServerStats &h = server.stats();
+    MachineState m = machineState(hostMicros());
+    char buf[640];
+    JsonWriter w(buf, sizeof(buf));
+    w.beginObject();
+    w.key("millis").number((uint32_t)millis());
+    w.key("allocs").number64(a.allocs);
+    w.key("frees").number64(a.frees);
+    w.key("alloc_bytes").number64(a.bytes);
+    w.key("live_bytes").number64((uint64_t)a.live);
+    w.key("peak_bytes").number64((uint64_t)a.peak);
+    w.key("http").beginObject();
+    w.key("accepted").number(h.accepted);
+    w.key("requests").number(h.requests);
+    w.key("keepalive_reuse").number(h.keepAliveReuse);
+    w.key("timeouts").number(h.timeouts);
+    w.key("evicted_idle").number(h.evictedIdle);
+    w.key("bad_requests").number(h.badRequests);
+    w.key("event_drops").number(h.eventDrops);
+    w.key("rate_limited").number(h.rateLimited);
+    w.key("shed").number(h.shed);
+    w.key("queue_peak").number(h.queuePeak);
+    w.endObject();
+    w.key("machine").beginObject();
+    w.key("on").boolean(m.on);
+    w.key("presses").number(m.presses);
+    w.key("on_for_ms").number(m.onForMs);
+    w.key("temp_c").fixed<2>(m.tempC);
+    w.key("pressure_hpa").fixed<2>(m.pressureHpa);
+    w.endObject();
+    w.endObject();
+    res.header("Cache-Control", "no-store");
+    res.send(200, "application/json", buf, w.length());
+}
+
+// Control server loop - select() returns as soon as a request arrives, the timeout only bounds shutdown
+static void controlThread(HttpServer *control)
+{
+    while (!stopRequested)
+        control->poll(50);
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr, "usage: %s [--control-port N] [--millis-start N] [--no-wifi] [--no-sensor] [--run-for S] [--quiet] [--no-admission]\n",
+            argv0);
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    HostOptions opts;
+    long controlPort = -1;
+    double runFor = 0;
+    bool admission = true;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(a, "--control-port") && hasValue)
+            controlPort = atol(argv[++i]);
+        else if (!strcmp(a, "--millis-start") && hasValue)
+            opts.millisStart = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(a, "--run-for") && hasValue)
+            runFor = atof(argv[++i]);
+        else if (!strcmp(a, "--no-wifi"))
+            opts.wifi = false;
+        else if (!strcmp(a, "--no-sensor"))
+            opts.sensor = false;
+        else if (!strcmp(a, "--quiet"))
+            opts.quiet = true;
+        else if (!strcmp(a, "--no-admission"))
+            admission = false;
+        else
+            usage(argv[0]);
+    }
+    hostConfigure(opts);
+    signal(SIGPIPE, SIG_IGN); // lwIP has no SIGPIPE - a peer that went away is a send() error
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    if (controlPort < 0)
+        controlPort = hostHttpPort() + 1;
+    static HttpServer control((uint16_t)controlPort);
+    control.on("/host/stats", (uint8_t)HttpMethod::Get, handleHostStats);
+    bool controlUp = controlPort > 0 && control.begin();
+    if (controlPort > 0 && !controlUp)
+        fprintf(stderr, "[HOST] Control port %ld unavailable\n", controlPort);
+    else if (controlUp)
+        printf("[HOST] Simulation stats on http://127.0.0.1:%ld/host/stats\n", controlPort);
+
+    setup();
+    if (!admission)
+    { // /press keeps its own debounce - that is the handler, not the server
+        server.onAdmit(nullptr);
+        server.maxDispatchPerPoll = server.maxQueued = server.maxConnsPerIp = HTTP_MAX_CONNS;
+    }
+    std::thread controlWorker;
+    if (controlUp)
+        controlWorker = std::thread(controlThread, &control);
+    uint32_t startMs = millis();
+    while (!stopRequested)
+    {
+        loop();
+        if (runFor > 0 && (uint32_t)(millis() - startMs) >= runFor * 1000.0)
+            break;
+    }
+    stopRequested = 1;
+    if (controlWorker.joinable())
+        controlWorker.join();
+
+    HostAllocStats a = hostAllocStats();
+    const HttpServerStats &h = server.stats();
+    printf("[HOST] %u requests on %u connections, %llu allocations (%llu bytes), peak heap %lld bytes\n", h.requests,
+           h.accepted, (unsigned long long)a.allocs, (unsigned long long)a.bytes, (long long)a.peak);
+    return 0;
+}
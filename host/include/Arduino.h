@@ -0,0 +1,115 @@
+/*
+Host build: the part of the Arduino-ESP32 core that Embedded Brew uses, backed by the simulation in
+host/hal_sim.cpp. millis() runs at real speed but can start anywhere (to cross the 32-bit rollover),
+GPIO writes reach the simulated relay, and String allocates from the heap like the real one so
+allocation counts stay comparable.
+*/
+#pragma once
+
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+
+using std::max;
+using std::min;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+unsigned long millis(); // 32-bit like the device, so rollover behaves the same
+unsigned long micros();
+void delay(uint32_t ms);
+void yield();
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+bool setCpuFrequencyMhz(uint32_t mhz);
+uint32_t getCpuFrequencyMhz();
+uint32_t esp_random();
+void configTzTime(const char *tz, const char *server1, const char *server2 = nullptr, const char *server3 = nullptr);
+#if !(__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 38))
+size_t strlcpy(char *dst, const char *src, size_t size);
+#endif
+
+// FreeRTOS critical sections - a spinlock, the esp_timer callback runs on another thread here too
+struct portMUX_TYPE
+{
+    std::atomic<bool> locked;
+};
+#define portMUX_INITIALIZER_UNLOCKED {false}
+inline void portENTER_CRITICAL(portMUX_TYPE *mux)
+{
+    while (mux->locked.exchange(true, std::memory_order_acquire))
+        ;
+}
+inline void portEXIT_CRITICAL(portMUX_TYPE *mux) { mux->locked.store(false, std::memory_order_release); }
+
+class String
+{
+public:
+    String(const char *s = "");
+    String(const String &other);
+    String &operator=(const String &other);
+    ~String();
+    const char *c_str() const { return buf ? buf : ""; }
+    size_t length() const { return len; }
+
+private:
+    char *buf = nullptr;
+    size_t len = 0;
+};
+
+class IPAddress
+{
+public:
+    IPAddress() : addr{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : addr{a, b, c, d} {}
+    IPAddress(uint32_t raw) { memcpy(addr, &raw, 4); } // Network byte order, as lwIP stores it
+    uint8_t operator[](int i) const { return addr[i]; }
+    operator uint32_t() const
+    {
+        uint32_t raw;
+        memcpy(&raw, addr, 4);
+        return raw;
+    }
+    String toString() const;
+
+private:
+    uint8_t addr[4];
+};
+
+class HardwareSerial
+{
+public:
+    void begin(unsigned long) {}
+    size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+    size_t print(const char *s);
+    size_t println(const char *s = "");
+};
+extern HardwareSerial Serial;
+
+class EspClass
+{
+public:
+    uint32_t getFreeHeap();    // Simulated heap size minus live host allocations
+    uint32_t getMaxAllocHeap();
+    uint32_t getMinFreeHeap();
+    void restart();            // Ends the host process (exit code 0)
+};
+extern EspClass ESP;
@@ -0,0 +1,9 @@
+#pragma once
+// Host build: mDNS is not simulated, the server is reached by address
+class MDNSResponder
+{
+public:
+    bool begin(const char *) { return true; }
+    void addService(const char *, const char *, int) {}
+};
+extern MDNSResponder MDNS;
@@ -0,0 +1,10 @@
+#pragma once
+// Host build: ElegantOTA is not simulated, compressed OTA on the main server is (see Update.h)
+#include "WebServer.h"
+
+class ElegantOTAClass
+{
+public:
+    void begin(WebServer *) {}
+};
+extern ElegantOTAClass ElegantOTA;
@@ -0,0 +1,18 @@
+#pragma once
+// Host build: NVS in memory - settings survive ESP.restart() no more than the process does
+#include <stddef.h>
+#include <stdint.h>
+
+class Preferences
+{
+public:
+    bool begin(const char *name, bool readOnly = false);
+    void end() {}
+    size_t getBytes(const char *key, void *buf, size_t maxLen);
+    size_t putBytes(const char *key, const void *value, size_t len);
+    uint32_t getUInt(const char *key, uint32_t defaultValue = 0);
+    size_t putUInt(const char *key, uint32_t value);
+
+private:
+    char ns[16] = "";
+};
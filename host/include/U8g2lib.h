@@ -0,0 +1,14 @@
+#pragma once
+// Host build: the OLED is powered down at boot, only the calls the sketch makes exist
+#include <stdint.h>
+
+#define U8G2_R0 0
+#define U8X8_PIN_NONE 255
+
+class U8G2_SSD1306_72X40_ER_F_HW_I2C
+{
+public:
+    U8G2_SSD1306_72X40_ER_F_HW_I2C(int, uint8_t, uint8_t, uint8_t) {}
+    bool begin() { return true; }
+    void setPowerSave(uint8_t) {}
+};
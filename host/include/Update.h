@@ -0,0 +1,25 @@
+#pragma once
+// Host build: OTA partition writes are counted and the length checked, the image MD5 is not
+#include "Arduino.h"
+
+#define U_FLASH 0
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+
+class UpdateClass
+{
+public:
+    bool begin(size_t size = UPDATE_SIZE_UNKNOWN, int command = U_FLASH);
+    bool setMD5(const char *md5);
+    size_t write(uint8_t *data, size_t len);
+    bool end(bool evenIfRemaining = false);
+    void abort();
+    bool hasError() { return error != nullptr; }
+    const char *errorString() { return error ? error : "No Error"; }
+
+private:
+    size_t expected = 0;
+    size_t written = 0;
+    bool running = false;
+    const char *error = nullptr;
+};
+extern UpdateClass Update;
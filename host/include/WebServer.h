@@ -0,0 +1,11 @@
+#pragma once
+// Host build: the blocking Arduino WebServer (ElegantOTA's :8080) is not simulated
+#include "Arduino.h"
+
+class WebServer
+{
+public:
+    explicit WebServer(int) {}
+    void begin() {}
+    void handleClient() {}
+};
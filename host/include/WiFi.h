@@ -0,0 +1,54 @@
+/*
+Host build: simulated Wi-Fi. The STA link comes up a moment after WiFi.begin() (never with
+--no-wifi, which exercises the access-point fallback) and reports the loopback address.
+*/
+#pragma once
+
+#include <netinet/in.h> // INADDR_NONE, a macro from lwIP on the device too
+
+#include "Arduino.h"
+
+enum wifi_power_t
+{
+    WIFI_POWER_19_5dBm = 78,
+    WIFI_POWER_5dBm = 20,
+};
+typedef enum
+{
+    WIFI_OFF,
+    WIFI_STA,
+    WIFI_AP,
+    WIFI_AP_STA,
+} wifi_mode_t;
+typedef enum
+{
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_DISCONNECTED = 6,
+} wl_status_t;
+
+class WiFiClass
+{
+public:
+    bool mode(wifi_mode_t m);
+    bool setTxPower(wifi_power_t power);
+    bool setSleep(bool enable);
+    bool setAutoReconnect(bool enable);
+    bool disconnect(bool wifiOff = false, bool eraseAp = false);
+    bool config(IPAddress local, IPAddress gateway, IPAddress subnet, IPAddress dns1 = IPAddress());
+    wl_status_t begin(const char *ssid, const char *pass = nullptr, int32_t channel = 0, const uint8_t *bssid = nullptr);
+    wl_status_t status();
+    IPAddress localIP();
+    IPAddress gatewayIP();
+    IPAddress subnetMask();
+    IPAddress dnsIP();
+    uint8_t *BSSID();
+    int32_t channel();
+    int8_t RSSI();
+    uint8_t *macAddress(uint8_t *mac);
+    bool softAP(const char *ssid, const char *pass = nullptr);
+    bool softAPdisconnect(bool wifiOff = false);
+    IPAddress softAPIP();
+};
+extern WiFiClass WiFi;
@@ -0,0 +1,24 @@
+#pragma once
+// Host build: I2C bus with the simulated BMP280 attached (host/sim_machine.cpp)
+#include "Arduino.h"
+
+class TwoWire
+{
+public:
+    bool begin(int sda, int scl, uint32_t frequency = 0);
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t value);
+    uint8_t endTransmission(bool sendStop = true); // 0 = ACK, 2 = address NACK
+    uint8_t requestFrom(int address, int quantity);
+    int available();
+    int read();
+
+private:
+    uint8_t txAddr = 0;
+    uint8_t tx[32];
+    uint8_t txLen = 0;
+    uint8_t rx[32];
+    uint8_t rxLen = 0;
+    uint8_t rxPos = 0;
+};
+extern TwoWire Wire;
@@ -0,0 +1,6 @@
+#pragma once
+// Host build: ESP-IDF error codes used by the sketch and its modules
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_STATE 0x103
@@ -0,0 +1,9 @@
+#pragma once
+// Host build: lwIP's BSD socket API is the host's own
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
@@ -0,0 +1,4 @@
+#pragma once
+// Host build: flash and RAM share one address space, PROGMEM data is read directly
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
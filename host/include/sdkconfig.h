@@ -0,0 +1,5 @@
+#pragma once
+// Host build: no power-management framework, PowerManager falls back to setCpuFrequencyMhz()
+#define CONFIG_PM_ENABLE 0
+#define CONFIG_FREERTOS_USE_TICKLESS_IDLE 0
+#define ESP_IDF_VERSION_MAJOR 5
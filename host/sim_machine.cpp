@@ -0,0 +1,242 @@
+/*
+Simulated hardware for the host build: a drip coffee maker whose toggle button is wired to the
+relay, and the BMP280 on the I2C bus next to its warming plate.
+
+Each completed press of at least MACHINE_MIN_PRESS_MS toggles the machine. The temperature follows
+the same shape as tools/brew_replay.cpp's synthetic cycle: heater full on towards 70 C while the
+water runs through, then the plate cycling around 55 C, and cooling back to the room once it is
+switched off. The BMP280 answers with the Bosch datasheet's example trim values, and each forced
+conversion encodes the current temperature and pressure into raw ADC values that
+src/bmp280.cpp's compensation turns back into the same numbers.
+*/
+#include "hal_sim.h"
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#include <mutex>
+#include <random>
+
+#include "bmp280.h"
+
+const float AMBIENT_C = 22.0f;              // Room temperature
+const float BREW_TARGET_C = 70.0f;          // Sensor temperature the heater approaches while brewing
+const float PLATE_TARGET_C = 55.0f;         // Warming plate mean
+const uint32_t BREW_WATER_S = 540;          // Heater time until the reservoir is empty
+const float PRESSURE_HPA = 1013.25f;        // Mean ambient pressure
+const uint32_t MACHINE_MIN_PRESS_MS = 50;   // Shorter button contacts are ignored
+const uint8_t BMP_CHIP_ID = 0x58;
+
+static std::mutex machineLock;
+static bool machineOn = false;
+static uint32_t presses = 0;
+static bool pressing = false;
+static uint64_t pressStartUs = 0;
+static uint64_t onSinceUs = 0;
+static uint64_t modelUs = 0; // Simulated time the thermal model has been advanced to
+static float potC = AMBIENT_C;
+static std::mt19937 rng(2025);
+
+// Advance the thermal model to nowUs in one-second steps (machineLock held)
+static void advance(uint64_t nowUs)
+{
+    if (!modelUs)
+        modelUs = nowUs;
+    while (nowUs - modelUs >= 1000000ULL)
+    {
+        modelUs += 1000000ULL;
+        float target = AMBIENT_C, tau = 900.0f;
+        if (machineOn)
+        {
+            uint32_t onS = (uint32_t)((modelUs - onSinceUs) / 1000000ULL);
+            if (onS < BREW_WATER_S)
+            {
+                target = BREW_TARGET_C;
+                tau = 240.0f;
+            }
+            else
+            { // Plate thermostat with a 4 minute cycle
+                target = PLATE_TARGET_C + sinf((onS - BREW_WATER_S) * 6.2832f / 240.0f);
+                tau = 120.0f;
+            }
+        }
+        potC += (target - potC) / tau;
+    }
+}
+
+void machineRelay(bool closed, uint64_t nowUs)
+{
+    std::lock_guard<std::mutex> guard(machineLock);
+    advance(nowUs);
+    if (closed)
+    {
+        pressing = true;
+        pressStartUs = nowUs;
+        return;
+    }
+    if (!pressing || nowUs - pressStartUs < MACHINE_MIN_PRESS_MS * 1000ULL)
+        return; // Pin initialised HIGH at boot, or contact bounce
+    pressing = false;
+    presses++;
+    machineOn = !machineOn;
+    onSinceUs = nowUs;
+    if (!hostOptions().quiet)
+        printf("[SIM] Button press %u, machine %s\n", presses, machineOn ? "on" : "off");
+}
+
+MachineState machineState(uint64_t nowUs)
+{
+    std::lock_guard<std::mutex> guard(machineLock);
+    advance(nowUs);
+    MachineState s;
+    s.on = machineOn;
+    s.presses = presses;
+    s.onForMs = machineOn ? (uint32_t)((nowUs - onSinceUs) / 1000ULL) : 0;
+    s.tempC = potC;
+    s.pressureHpa = PRESSURE_HPA + 0.6f * sinf((float)(nowUs / 1000000ULL % 21600) * 6.2832f / 21600.0f);
+    return s;
+}
+
+/*------- BMP280 -------*/
+
+// Datasheet section 3.12 example trim values, little-endian in register order
+static const uint16_t CALIB[12] = {27504, 26435, (uint16_t)-1000, 36477, (uint16_t)-10685, 3024,
+                                   2855, 140, (uint16_t)-7, 15500, (uint16_t)-14600, 6000};
+static uint8_t regs[256];
+static uint8_t regPtr = 0;
+static bool bmpReady = false;
+
+static void bmpReset()
+{
+    memset(regs, 0, sizeof(regs));
+    for (int i = 0; i < 12; i++)
+    {
+        regs[0x88 + 2 * i] = (uint8_t)CALIB[i];
+        regs[0x89 + 2 * i] = (uint8_t)(CALIB[i] >> 8);
+    }
+    regs[0xD0] = BMP_CHIP_ID;
+    regs[0xF7] = regs[0xFA] = 0x80; // Data registers read 0x80000 until the first conversion
+    bmpReady = true;
+}
+
+// Forced conversion: encode the model's temperature and pressure as the ADC values that compensate back to them
+static void bmpConvert()
+{
+    MachineState m = machineState(hostMicros());
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    float tempC = m.tempC + 0.02f * noise(rng);
+    float pressPa = (m.pressureHpa + 0.03f * noise(rng)) * 100.0f;
+    Bmp280Calib cal;
+    bmp280ParseCalib(regs + 0x88, cal);
+
+    int32_t want = (int32_t)lroundf(tempC * 100.0f), tFine = 0;
+    int32_t lo = 0, hi = 0xFFFFF;
+    while (lo < hi)
+    { // Temperature rises with adc_T
+        int32_t mid = (lo + hi) / 2;
+        if (bmp280CompensateTemp(cal, mid, tFine) < want)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    int32_t adcT = lo;
+    bmp280CompensateTemp(cal, adcT, tFine);
+
+    uint32_t wantQ8 = (uint32_t)lroundf(pressPa * 256.0f);
+    lo = 0;
+    hi = 0xFFFFF;
+    while (lo < hi)
+    { // Pressure falls as adc_P rises
+        int32_t mid = (lo + hi) / 2;
+        if (bmp280CompensatePress(cal, mid, tFine) > wantQ8)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    int32_t adcP = lo;
+
+    regs[0xF7] = (uint8_t)(adcP >> 12);
+    regs[0xF8] = (uint8_t)(adcP >> 4);
+    regs[0xF9] = (uint8_t)(adcP << 4);
+    regs[0xFA] = (uint8_t)(adcT >> 12);
+    regs[0xFB] = (uint8_t)(adcT >> 4);
+    regs[0xFC] = (uint8_t)(adcT << 4);
+}
+
+static void bmpWrite(uint8_t reg, uint8_t value)
+{
+    if (reg == 0xE0 && value == 0xB6)
+        bmpReset();
+    else if (reg == 0xF5)
+        regs[reg] = value;
+    else if (reg == 0xF4)
+    {
+        regs[reg] = value;
+        if (value & 0x03)
+        { // Forced (or normal) mode: the result is ready long before the driver's conversion wait ends
+            bmpConvert();
+            regs[reg] = value & 0xFC; // Back to sleep
+        }
+    }
+}
+
+/*------- I2C bus -------*/
+
+TwoWire Wire;
+
+static bool bmpAt(uint8_t address)
+{
+    return hostOptions().sensor && address == HOST_BMP_ADDR;
+}
+
+bool TwoWire::begin(int, int, uint32_t)
+{
+    if (!bmpReady)
+        bmpReset();
+    return true;
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+    txAddr = address;
+    txLen = 0;
+}
+
+size_t TwoWire::write(uint8_t value)
+{
+    if (txLen >= sizeof(tx))
+        return 0;
+    tx[txLen++] = value;
+    return 1;
+}
+
+uint8_t TwoWire::endTransmission(bool)
+{
+    if (!bmpAt(txAddr))
+        return 2;
+    if (txLen)
+        regPtr = tx[0];
+    for (uint8_t i = 1; i < txLen; i++)
+        bmpWrite((uint8_t)(regPtr + i - 1), tx[i]);
+    return 0;
+}
+
+uint8_t TwoWire::requestFrom(int address, int quantity)
+{
+    rxLen = rxPos = 0;
+    if (!bmpAt((uint8_t)address) || quantity <= 0 || quantity > (int)sizeof(rx))
+        return 0;
+    for (int i = 0; i < quantity; i++)
+        rx[rxLen++] = regs[(uint8_t)(regPtr + i)];
+    return rxLen;
+}
+
+int TwoWire::available()
+{
+    return rxLen - rxPos;
+}
+
+int TwoWire::read()
+{
+    return rxPos < rxLen ? rx[rxPos++] : -1;
+}
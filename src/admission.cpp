@@ -0,0 +1,125 @@
+#include "admission.h"
+
+#include <string.h>
+
+void Admission::limitClients(AdmitLimit limit)
+{
+    clientLimit = limit;
+    for (Client &c : clients)
+        c.ip = 0; // Buckets restart full under the new limit
+}
+
+bool Admission::limitRoute(const char *path, AdmitLimit limit)
+{
+    Route *r = route(path, true);
+    if (!r)
+        return false;
+    r->limit = limit;
+    for (Client &c : r->clients)
+        c.ip = 0;
+    return true;
+}
+
+bool Admission::exempt(const char *path)
+{
+    Route *r = route(path, true);
+    if (r)
+        r->exempt = true;
+    return r != nullptr;
+}
+
+Admission::Route *Admission::route(const char *path, bool create)
+{
+    for (uint8_t i = 0; i < routeCount; i++)
+    {
+        if (strcmp(routes[i].path, path) == 0)
+            return &routes[i];
+    }
+    if (!create || routeCount >= ADMIT_MAX_ROUTES)
+        return nullptr;
+    Route &r = routes[routeCount++];
+    r = {path, {0, 0}, false, {}};
+    return &r;
+}
+
+// Bucket of ip in table, recycling the least recently seen slot for a new address - a free slot starts
+// full, a recycled one keeps its bucket (refilled as usual) so rotating addresses cannot reset it
+Admission::Client &Admission::client(Client *table, uint8_t size, const AdmitLimit &limit, uint32_t ip, uint32_t nowMs)
+{
+    Client *oldest = &table[0];
+    for (uint8_t i = 0; i < size; i++)
+    {
+        Client &c = table[i];
+        if (c.ip == ip)
+        {
+            c.seenMs = nowMs;
+            return c;
+        }
+        if (oldest->ip && (!c.ip || nowMs - c.seenMs > nowMs - oldest->seenMs))
+            oldest = &c; // Free slots first, then the longest unseen address
+    }
+    if (oldest->ip)
+    {
+        st.clientsReused++;
+    }
+    else
+    {
+        oldest->bucket.milli = (uint32_t)limit.burst * 1000;
+        oldest->bucket.lastMs = nowMs;
+    }
+    oldest->ip = ip;
+    oldest->seenMs = nowMs;
+    return *oldest;
+}
+
+// Add the tokens earned since the last refill; lastMs only advances by the time turned into
+// whole thousandths, so a client asking every millisecond still refills at the configured rate
+void Admission::refill(Bucket &b, const AdmitLimit &limit, uint32_t nowMs)
+{
+    uint32_t cap = (uint32_t)limit.burst * 1000;
+    uint64_t add = (uint64_t)(nowMs - b.lastMs) * limit.perMin / 60;
+    if (b.milli + add >= cap)
+    {
+        b.milli = cap;
+        b.lastMs = nowMs;
+        return;
+    }
+    b.milli += (uint32_t)add;
+    b.lastMs += (uint32_t)(add * 60 / limit.perMin);
+}
+
+// Whole seconds until the bucket holds one token again (at least 1)
+uint32_t Admission::waitS(const Bucket &b, const AdmitLimit &limit)
+{
+    uint32_t ms = (uint32_t)(((uint64_t)(1000 - b.milli) * 60 + limit.perMin - 1) / limit.perMin);
+    return ms < 1000 ? 1 : (ms + 999) / 1000;
+}
+
+int Admission::check(uint32_t ip, const char *path, uint32_t nowMs, uint32_t &retryAfterS)
+{
+    Route *r = route(path, false);
+    Client *c = clientLimit.perMin && !(r && r->exempt) ? &client(clients, ADMIT_MAX_CLIENTS, clientLimit, ip, nowMs) : nullptr;
+    Client *rc = r && r->limit.perMin ? &client(r->clients, ADMIT_ROUTE_CLIENTS, r->limit, ip, nowMs) : nullptr;
+    if (c)
+        refill(c->bucket, clientLimit, nowMs);
+    if (rc)
+        refill(rc->bucket, r->limit, nowMs);
+    if (c && c->bucket.milli < 1000)
+    {
+        st.clientLimited++;
+        retryAfterS = waitS(c->bucket, clientLimit);
+        return 429;
+    }
+    if (rc && rc->bucket.milli < 1000)
+    { // Not charged to the client bucket - it was the route's that ran dry
+        st.routeLimited++;
+        retryAfterS = waitS(rc->bucket, r->limit);
+        return 429;
+    }
+    if (c)
+        c->bucket.milli -= 1000;
+    if (rc)
+        rc->bucket.milli -= 1000;
+    st.admitted++;
+    return 0;
+}
@@ -0,0 +1,80 @@
+/*
+Request admission for Embedded Brew's web server.
+
+The server is single-threaded and shares loop() with sampling, auto-off and scheduled brewing, so
+a client that never stops asking (a tab with a runaway setInterval, a script hammering /press)
+must be turned away before its requests reach a handler. Every request takes one token from two
+token buckets, and is answered 429 with Retry-After when either is empty:
+  - one bucket per client IPv4 address, from a small table that recycles the least recently
+    seen client (ADMIT_MAX_CLIENTS addresses are tracked; a new one gets a full bucket from a
+    free slot, but inherits the level of a recycled one, so more addresses than slots taking
+    turns share those buckets instead of each getting a fresh burst)
+  - one bucket per limited route and client address, from a smaller table per route that
+    recycles the same way - /press gets a few presses a minute per address, so one client
+    pressing in a loop cannot use up everyone else's presses
+Routes can be exempted from the client bucket (OTA chunks arrive back-to-back by design).
+Tokens are kept in thousandths so slow rates refill smoothly without floats.
+
+Portable C++ (no Arduino calls), the same code runs in the host build.
+*/
+#pragma once
+
+#include <stdint.h>
+
+const uint8_t ADMIT_MAX_CLIENTS = 8;   // Client addresses with their own bucket
+const uint8_t ADMIT_MAX_ROUTES = 6;    // Routes with their own limit or a client exemption
+const uint8_t ADMIT_ROUTE_CLIENTS = 4; // Client addresses tracked per limited route
+
+struct AdmitLimit
+{
+    uint16_t burst;  // Bucket size - requests allowed back-to-back
+    uint16_t perMin; // Refill rate in requests per minute (0 = no limit)
+};
+
+struct AdmissionStats
+{
+    uint32_t admitted;      // Requests let through
+    uint32_t clientLimited; // Refused because the client's bucket was empty
+    uint32_t routeLimited;  // Refused because the client's bucket for the route was empty
+    uint32_t clientsReused; // Client slots (global or per route) recycled for a new address
+};
+
+class Admission
+{
+public:
+    void limitClients(AdmitLimit limit);                 // Per-address limit for every route
+    bool limitRoute(const char *path, AdmitLimit limit); // Per-address limit for one exact path
+    bool exempt(const char *path);                       // Path is not charged to the client bucket
+    // 0 if the request may proceed, else 429 with retryAfterS set to the wait for the next token
+    int check(uint32_t ip, const char *path, uint32_t nowMs, uint32_t &retryAfterS);
+    const AdmissionStats &stats() const { return st; }
+
+private:
+    struct Bucket
+    {
+        uint32_t milli = 0;  // Tokens x 1000
+        uint32_t lastMs = 0; // Last refill
+    };
+    struct Client
+    {
+        uint32_t ip = 0;     // 0 = free slot
+        uint32_t seenMs = 0; // Last request, for recycling
+        Bucket bucket;
+    };
+    struct Route
+    {
+        const char *path;
+        AdmitLimit limit;
+        bool exempt;
+        Client clients[ADMIT_ROUTE_CLIENTS];
+    };
+    Route *route(const char *path, bool create);
+    Client &client(Client *table, uint8_t size, const AdmitLimit &limit, uint32_t ip, uint32_t nowMs);
+    static void refill(Bucket &b, const AdmitLimit &limit, uint32_t nowMs);
+    static uint32_t waitS(const Bucket &b, const AdmitLimit &limit);
+    AdmitLimit clientLimit = {0, 0};
+    Client clients[ADMIT_MAX_CLIENTS];
+    Route routes[ADMIT_MAX_ROUTES];
+    uint8_t routeCount = 0;
+    AdmissionStats st = {};
+};
@@ -0,0 +1,167 @@
+#include "bmp280.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+// Registers
+const uint8_t REG_CALIB = 0x88;   // 24 bytes of trim values
+const uint8_t REG_CHIP_ID = 0xD0; // 0x58 (BMP280), 0x56/0x57 (samples), 0x60 (BME280)
+const uint8_t REG_RESET = 0xE0;   // Write 0xB6 for a soft reset
+const uint8_t REG_STATUS = 0xF3;  // Bit 0: NVM copy in progress
+const uint8_t REG_CTRL = 0xF4;    // osrs_t[7:5] osrs_p[4:2] mode[1:0]
+const uint8_t REG_CONFIG = 0xF5;  // t_sb[7:5] filter[4:2]
+const uint8_t REG_DATA = 0xF7;    // press msb/lsb/xlsb, temp msb/lsb/xlsb
+const uint8_t MODE_FORCED = 0x01;
+
+/*------- Compensation (Bosch BMP280 datasheet, section 8.2) -------*/
+
+int32_t bmp280CompensateTemp(const Bmp280Calib &cal, int32_t adcT, int32_t &tFine)
+{
+    int32_t var1 = ((((adcT >> 3) - ((int32_t)cal.t1 << 1))) * ((int32_t)cal.t2)) >> 11;
+    int32_t var2 = (((((adcT >> 4) - ((int32_t)cal.t1)) * ((adcT >> 4) - ((int32_t)cal.t1))) >> 12) * ((int32_t)cal.t3)) >> 14;
+    tFine = var1 + var2;
+    return (tFine * 5 + 128) >> 8;
+}
+
+uint32_t bmp280CompensatePress(const Bmp280Calib &cal, int32_t adcP, int32_t tFine)
+{
+    int64_t var1 = ((int64_t)tFine) - 128000;
+    int64_t var2 = var1 * var1 * (int64_t)cal.p6;
+    var2 = var2 + ((var1 * (int64_t)cal.p5) * 131072);
+    var2 = var2 + (((int64_t)cal.p4) * 34359738368LL);
+    var1 = ((var1 * var1 * (int64_t)cal.p3) >> 8) + ((var1 * (int64_t)cal.p2) * 4096);
+    var1 = ((((int64_t)1) << 47) + var1) * ((int64_t)cal.p1) >> 33;
+    if (var1 == 0)
+        return 0; // Avoid division by zero on bad trim data
+    int64_t p = 1048576 - adcP;
+    p = (((p * 2147483648LL) - var2) * 3125) / var1;
+    var1 = (((int64_t)cal.p9) * (p >> 13) * (p >> 13)) >> 25;
+    var2 = (((int64_t)cal.p8) * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (((int64_t)cal.p7) << 4);
+    return (uint32_t)p;
+}
+
+void bmp280ParseCalib(const uint8_t *raw, Bmp280Calib &cal)
+{
+    auto u16 = [raw](uint8_t i) { return (uint16_t)(raw[i] | raw[i + 1] << 8); };
+    cal.t1 = u16(0);
+    cal.t2 = (int16_t)u16(2);
+    cal.t3 = (int16_t)u16(4);
+    cal.p1 = u16(6);
+    cal.p2 = (int16_t)u16(8);
+    cal.p3 = (int16_t)u16(10);
+    cal.p4 = (int16_t)u16(12);
+    cal.p5 = (int16_t)u16(14);
+    cal.p6 = (int16_t)u16(16);
+    cal.p7 = (int16_t)u16(18);
+    cal.p8 = (int16_t)u16(20);
+    cal.p9 = (int16_t)u16(22);
+}
+
+/*------- I2C driver -------*/
+
+#ifdef ARDUINO
+
+bool Bmp280::begin(TwoWire &wire, uint8_t address)
+{
+    bus = &wire;
+    addr = address;
+    uint8_t id = 0;
+    if (!readRegs(REG_CHIP_ID, &id, 1) || (id != 0x58 && id != 0x56 && id != 0x57 && id != 0x60))
+        return false;
+    writeReg(REG_RESET, 0xB6);
+    delay(3); // 2 ms start-up time
+    uint8_t status = 1;
+    for (uint8_t i = 0; i < 10 && (status & 0x01); i++)
+    { // Wait for the trim values to be copied from NVM
+        if (!readRegs(REG_STATUS, &status, 1))
+            return false;
+        if (status & 0x01)
+            delay(1);
+    }
+    uint8_t raw[24];
+    if (!readRegs(REG_CALIB, raw, sizeof(raw)))
+        return false;
+    bmp280ParseCalib(raw, cal);
+    if (cal.t1 == 0 || cal.p1 == 0)
+        return false; // Blank trim data - not a usable sensor
+    setPreset(Bmp280Preset::Idle);
+    return true;
+}
+
+void Bmp280::setPreset(Bmp280Preset preset)
+{
+    // Oversampling codes: 1 = x1, 2 = x2, 3 = x4. Filter codes: 0 = off, 1 = 2.
+    // The IIR filter smooths temperature too, one step per forced conversion: at the 1 Hz idle rate
+    // coefficient 16 would lag a heat-up by ~16 s and delay spotting a press on the machine's own
+    // button, so Idle relies on pressure oversampling for noise and keeps the filter at 2 (~2 s)
+    // Max conversion time: 1.25 + 2.3 * T samples + 2.3 * P samples + 0.575 ms
+    uint8_t osrsT, osrsP, filter;
+    if (preset == Bmp280Preset::Brewing)
+    {
+        osrsT = 2;
+        osrsP = 1;
+        filter = 0;
+        convMs = 9;
+    }
+    else
+    {
+        osrsT = 1;
+        osrsP = 3;
+        filter = 1;
+        convMs = 14;
+    }
+    ctrlMeas = (uint8_t)(osrsT << 5 | osrsP << 2 | MODE_FORCED);
+    writeReg(REG_CONFIG, (uint8_t)(filter << 2)); // Sensor sleeps between forced conversions, so config is writable
+    active = preset;
+}
+
+bool Bmp280::startConversion()
+{
+    uint32_t t0 = micros();
+    bool ok = writeReg(REG_CTRL, ctrlMeas); // Start one forced conversion
+    busUs = micros() - t0;
+    return ok;
+}
+
+bool Bmp280::fetch(int32_t &centiC, uint32_t &paQ8)
+{
+    uint8_t raw[6];
+    uint32_t t0 = micros();
+    bool ok = readRegs(REG_DATA, raw, sizeof(raw)); // Pressure and temperature in one burst
+    busUs += micros() - t0;
+    if (!ok)
+        return false;
+    int32_t adcP = (int32_t)raw[0] << 12 | (int32_t)raw[1] << 4 | raw[2] >> 4;
+    int32_t adcT = (int32_t)raw[3] << 12 | (int32_t)raw[4] << 4 | raw[5] >> 4;
+    if (adcT == 0x80000 || adcP == 0x80000)
+        return false; // Reset value - no conversion happened
+    int32_t tFine;
+    centiC = bmp280CompensateTemp(cal, adcT, tFine);
+    paQ8 = bmp280CompensatePress(cal, adcP, tFine);
+    return paQ8 != 0;
+}
+
+bool Bmp280::writeReg(uint8_t reg, uint8_t value)
+{
+    bus->beginTransmission(addr);
+    bus->write(reg);
+    bus->write(value);
+    return bus->endTransmission() == 0;
+}
+
+bool Bmp280::readRegs(uint8_t reg, uint8_t *out, size_t len)
+{
+    bus->beginTransmission(addr);
+    bus->write(reg);
+    if (bus->endTransmission(false) != 0) // Repeated start keeps the register pointer
+        return false;
+    if (bus->requestFrom((int)addr, (int)len) != (int)len)
+        return false;
+    for (size_t i = 0; i < len; i++)
+        out[i] = (uint8_t)bus->read();
+    return true;
+}
+
+#endif
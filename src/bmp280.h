@@ -0,0 +1,67 @@
+/*
+BMP280 driver for Embedded Brew.
+
+Forced-mode acquisition: each sample is one ctrl_meas write, a conversion wait sized to the active
+oversampling, and one burst read of the six data registers (0xF7-0xFC). Compensation is the Bosch
+datasheet integer path (32-bit temperature, 64-bit pressure), so no float math runs per sample on
+the FPU-less ESP32-C3. Two presets tune oversampling and the on-chip IIR filter: Brewing favours a
+fast temperature response, Idle a low-noise pressure reading with only light IIR smoothing (the
+filter also delays temperature, and the brew detector needs idle heat-ups promptly).
+
+The compensation functions are plain integer code and build on the host (tools/bmp280_compare.cpp);
+the I2C part is only compiled for Arduino.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#ifdef ARDUINO
+#include <Wire.h>
+#endif
+
+// Factory trim values read from 0x88-0x9F
+struct Bmp280Calib
+{
+    uint16_t t1;
+    int16_t t2, t3;
+    uint16_t p1;
+    int16_t p2, p3, p4, p5, p6, p7, p8, p9;
+};
+
+// Temperature in 0.01 C from raw adc_T, tFine receives the value shared with pressure compensation
+int32_t bmp280CompensateTemp(const Bmp280Calib &cal, int32_t adcT, int32_t &tFine);
+// Pressure in Pa as Q24.8 (Pa * 256) from raw adc_P, 0 if the calibration would divide by zero
+uint32_t bmp280CompensatePress(const Bmp280Calib &cal, int32_t adcP, int32_t tFine);
+// Unpack the 24-byte calibration block in register order
+void bmp280ParseCalib(const uint8_t *raw, Bmp280Calib &cal);
+
+enum class Bmp280Preset : uint8_t
+{
+    Brewing, // T x2, P x1, IIR off - follows the pot heating up (~9 ms conversion)
+    Idle,    // T x1, P x4, IIR 2 - low-noise pressure, temperature lags ~2 s at 1 Hz (~14 ms conversion)
+};
+
+#ifdef ARDUINO
+class Bmp280
+{
+public:
+    bool begin(TwoWire &wire, uint8_t addr);         // Reset, check chip id, load calibration, apply the Idle preset
+    void setPreset(Bmp280Preset preset);             // Change oversampling/IIR (takes effect on the next sample)
+    bool startConversion();                          // Trigger one forced conversion, fetch() it conversionMs() later
+    bool fetch(int32_t &centiC, uint32_t &paQ8);     // Burst read + compensation of the finished conversion
+    uint32_t conversionMs() const { return convMs; } // Max conversion time of the active preset
+    uint32_t lastBusUs() const { return busUs; }     // I2C time of the last conversion (trigger + burst, wait excluded)
+    Bmp280Preset preset() const { return active; }   // Active preset
+
+private:
+    bool writeReg(uint8_t reg, uint8_t value);
+    bool readRegs(uint8_t reg, uint8_t *out, size_t len);
+    TwoWire *bus = nullptr;
+    uint8_t addr = 0;
+    Bmp280Calib cal = {};
+    Bmp280Preset active = Bmp280Preset::Idle;
+    uint8_t ctrlMeas = 0; // osrs_t | osrs_p | forced mode
+    uint8_t convMs = 0;   // Max conversion time for ctrlMeas
+    uint32_t busUs = 0;   // I2C time of the last conversion
+};
+#endif
@@ -0,0 +1,136 @@
+#include "brew_detector.h"
+
+#include <math.h>
+
+const char *brewPhaseName(BrewPhase phase)
+{
+    switch (phase)
+    {
+    case BrewPhase::Idle: return "idle";
+    case BrewPhase::Heating: return "heating";
+    case BrewPhase::Brewing: return "brewing";
+    case BrewPhase::KeepWarm: return "keep_warm";
+    case BrewPhase::Cooled: return "cooled";
+    }
+    return "unknown";
+}
+
+// EWMA weight for a step of dt seconds - first-order approximation, no expf on the FPU-less C3
+static float weight(float dt, float tau) { return dt / (tau + dt); }
+
+void BrewDetector::update(uint32_t nowMs, float tempC)
+{
+    if (isnan(tempC))
+        return;
+    if (!primed)
+    {
+        fast = base = tempC;
+        slope = trend = 0;
+        lastMs = sinceMs = nowMs;
+        primed = true;
+        return;
+    }
+    float dt = (nowMs - lastMs) / 1000.0f;
+    if (dt <= 0)
+        return;
+    if (dt > 60.0f)
+        dt = 60.0f; // A long gap (sensor hiccup) must not look like a cliff
+    lastMs = nowMs;
+
+    float prev = fast;
+    fast += (tempC - fast) * weight(dt, BREW_FAST_TAU_S);
+    slope += ((fast - prev) / dt * 60.0f - slope) * weight(dt, BREW_SLOPE_TAU_S);
+    trend += (slope - trend) * weight(dt, BREW_TREND_TAU_S);
+    float rise = fast - base;
+    bool flat = fabsf(trend) < BREW_FLAT_SLOPE; // Trend, so thermostat cycling still counts as flat
+
+    switch (ph)
+    {
+    case BrewPhase::Idle:
+        base += (fast - base) * weight(dt, BREW_BASE_TAU_S); // Follow ambient drift
+        if (slope >= BREW_HEAT_SLOPE && rise >= BREW_HEAT_RISE_C)
+            enter(BrewPhase::Heating, nowMs);
+        break;
+    case BrewPhase::Heating:
+        if (rise >= BREW_BREW_RISE_C)
+            enter(BrewPhase::Brewing, nowMs);
+        else if (nowMs - sinceMs >= BREW_HEAT_TIMEOUT_MS && slope < BREW_HEAT_SLOPE)
+            enter(BrewPhase::Idle, nowMs); // Press that did not take, or a warm draught
+        break;
+    case BrewPhase::Brewing:
+        if (held(flat && rise >= BREW_WARM_RISE_C, flatMs, nowMs, BREW_KEEP_WARM_CONFIRM_MS))
+        { // Heater done, warming plate holding a level
+            warm = fast;
+            enter(BrewPhase::KeepWarm, nowMs);
+        }
+        else if (held(trend <= BREW_COOL_SLOPE, coolMs, nowMs, BREW_COOL_CONFIRM_MS))
+        { // Falling for longer than the drop into keep-warm takes - switched off straight after brewing
+            enter(BrewPhase::Cooled, nowMs);
+        }
+        break;
+    case BrewPhase::KeepWarm:
+        warm += (fast - warm) * weight(dt, BREW_WARM_TAU_S); // Plate level, averages out thermostat cycling
+        if (fast < warm - BREW_WARM_BAND_C && slope <= BREW_COOL_SLOPE)
+            enter(BrewPhase::Cooled, nowMs); // Left the regulated band downwards - plate is off
+        break;
+    case BrewPhase::Cooled:
+        if (slope >= BREW_HEAT_SLOPE)
+        { // Switched back on (or an off press that did not take)
+            enter(BrewPhase::Heating, nowMs);
+        }
+        else if (rise < BREW_IDLE_RISE_C && flat)
+        {
+            enter(BrewPhase::Idle, nowMs);
+        }
+        else if (held(flat, flatMs, nowMs, BREW_COOL_SETTLE_MS))
+        { // Settled above the old baseline - the room warmed up, rebase
+            base = fast;
+            enter(BrewPhase::Idle, nowMs);
+        }
+        break;
+    }
+}
+
+bool BrewDetector::brewOn() const
+{
+    return ph == BrewPhase::Heating || ph == BrewPhase::Brewing || ph == BrewPhase::KeepWarm;
+}
+
+// Safe to press off: keep-warm outlasted the time a switched-off plate takes to show as cooled, and
+// the reading sits on the plate level and is not falling - a plate that went off fails the slope test
+// within the filter lag (~10 s), long before the band test moves the phase to cooled
+bool BrewDetector::keepWarmSteady(uint32_t nowMs) const
+{
+    return ph == BrewPhase::KeepWarm && nowMs - sinceMs >= BREW_OFF_DETECT_MS &&
+           fast >= warm - BREW_WARM_BAND_C / 2 && slope >= 0;
+}
+
+void BrewDetector::notePress(uint32_t nowMs, bool on)
+{
+    if (on && !brewOn())
+        enter(BrewPhase::Heating, nowMs); // Optimistic - reverts to idle if nothing heats up
+    else if (!on && brewOn())
+        enter(BrewPhase::Cooled, nowMs); // Optimistic - goes back to heating if it keeps climbing
+}
+
+void BrewDetector::enter(BrewPhase next, uint32_t nowMs)
+{
+    if (next == BrewPhase::Heating)
+        cycleMs = nowMs;
+    ph = next;
+    sinceMs = nowMs;
+    flatMs = 0;
+    coolMs = 0;
+}
+
+bool BrewDetector::held(bool cond, uint32_t &startMs, uint32_t nowMs, uint32_t holdMs)
+{
+    if (!cond)
+    {
+        startMs = 0;
+        return false;
+    }
+    if (!startMs)
+        startMs = nowMs | 1; // 0 marks "not running"
+    return (int32_t)(nowMs - startMs) >= (int32_t)holdMs; // Signed: startMs may be nowMs + 1
+}
@@ -0,0 +1,85 @@
+/*
+Brew phase detector for Embedded Brew.
+
+Infers what the coffee maker is doing from the BMP280 temperature stream instead of trusting the
+button history: a fast EWMA smooths the reading, an EWMA of its derivative gives the slope in C/min,
+a slower EWMA of that slope gives the trend, and a slow EWMA tracks the ambient baseline while the machine is idle. Each sample is O(1) and no
+history is stored.
+
+    Idle -> Heating             slope and rise above baseline both climbing
+    Heating -> Brewing          rise above baseline reaches BREW_BREW_RISE_C
+    Brewing -> KeepWarm         slope flat for BREW_KEEP_WARM_CONFIRM_MS while still warm
+    Brewing -> Cooled           slope below BREW_COOL_SLOPE for BREW_COOL_CONFIRM_MS
+    KeepWarm -> Cooled          falling out of the keep-warm level by BREW_WARM_BAND_C
+    Cooled -> Idle              back near the baseline (or settled long enough to rebase)
+
+A relay press is applied optimistically (notePress) so the UI reacts at once; the temperature then
+confirms or reverts it. Thresholds assume the sensor sits near the heater/warming plate and are
+meant to be tuned with tools/brew_replay.cpp against recorded traces.
+*/
+#pragma once
+
+#include <stdint.h>
+
+enum class BrewPhase : uint8_t
+{
+    Idle,     // Machine off at ambient temperature
+    Heating,  // Heater on, temperature starting to climb
+    Brewing,  // Well above ambient and still climbing
+    KeepWarm, // Warm and flat - warming plate cycling (confirmed)
+    Cooled,   // Machine off and cooling back towards ambient
+};
+
+// Detector tuning
+const float BREW_FAST_TAU_S = 10.0f;               // Reading smoothing time constant
+const float BREW_SLOPE_TAU_S = 30.0f;              // Slope smoothing time constant
+const float BREW_TREND_TAU_S = 240.0f;             // Slope trend time constant (longer than a plate cycle)
+const float BREW_BASE_TAU_S = 1800.0f;             // Ambient baseline time constant (idle only)
+const float BREW_HEAT_SLOPE = 0.5f;                // C/min that counts as heating
+const float BREW_HEAT_RISE_C = 0.5f;               // Rise above baseline needed to start heating
+const float BREW_BREW_RISE_C = 6.0f;               // Rise above baseline that counts as brewing
+const float BREW_FLAT_SLOPE = 0.3f;                // |C/min| of the trend that counts as flat
+const float BREW_WARM_RISE_C = 3.0f;               // Minimum rise for keep-warm
+const float BREW_COOL_SLOPE = -0.4f;               // C/min that counts as cooling
+const float BREW_IDLE_RISE_C = 1.5f;               // Rise below which a cooled machine is idle again
+const uint32_t BREW_HEAT_TIMEOUT_MS = 300000;      // Heating that never gets anywhere reverts to idle - 5 mins
+const float BREW_WARM_TAU_S = 600.0f;              // Keep-warm level time constant
+const float BREW_WARM_BAND_C = 3.0f;               // Drop below the keep-warm level that means the plate is off
+const uint32_t BREW_KEEP_WARM_CONFIRM_MS = 120000; // Flat time before keep-warm is confirmed - 2 mins
+const uint32_t BREW_COOL_CONFIRM_MS = 480000;      // Falling time before brewing goes straight to cooled - 8 mins
+const uint32_t BREW_COOL_SETTLE_MS = 1200000;      // Flat time after which cooled rebases to idle - 20 mins
+const uint32_t BREW_OFF_DETECT_MS = 150000;        // Longest plate-off to keep-warm -> cooled delay (~95 s in brew_replay)
+
+const char *brewPhaseName(BrewPhase phase); // Lowercase name used in /metrics
+
+class BrewDetector
+{
+public:
+    void update(uint32_t nowMs, float tempC);         // Feed one sample (NAN samples are ignored)
+    void notePress(uint32_t nowMs, bool on);          // A relay press was sent to turn the machine on/off
+    BrewPhase phase() const { return ph; }            // Current phase
+    bool brewOn() const;                              // Machine on: heating, brewing or keep-warm
+    bool keepWarmSteady(uint32_t nowMs) const;        // Keep-warm for BREW_OFF_DETECT_MS and still level on the plate
+    uint32_t phaseSinceMs() const { return sinceMs; } // Time the current phase was entered
+    uint32_t cycleStartMs() const { return cycleMs; } // Time the current/last brew cycle started heating
+    float smoothedC() const { return fast; }          // Smoothed temperature
+    float baselineC() const { return base; }          // Ambient estimate
+    float slopePerMin() const { return slope; }       // Smoothed slope in C/min
+    float trendPerMin() const { return trend; }       // Long-term slope in C/min
+
+private:
+    void enter(BrewPhase next, uint32_t nowMs);
+    bool held(bool cond, uint32_t &sinceMs, uint32_t nowMs, uint32_t holdMs); // cond true for holdMs
+    BrewPhase ph = BrewPhase::Idle;
+    bool primed = false;
+    uint32_t lastMs = 0;
+    uint32_t sinceMs = 0;
+    uint32_t cycleMs = 0;
+    uint32_t flatMs = 0; // Start of the current flat stretch (0 = not flat)
+    uint32_t coolMs = 0; // Start of the current falling stretch (0 = not falling)
+    float fast = 0;
+    float base = 0;
+    float slope = 0;
+    float trend = 0;
+    float warm = 0; // Keep-warm level
+};
@@ -0,0 +1,123 @@
+/*
+Zero-allocation CBOR (RFC 8949) writer for Embedded Brew.
+
+Same call shape as JsonWriter so a metrics encoder can target either format. Maps and arrays use
+indefinite-length encoding (closed by a break byte), so nothing has to be counted up front and a
+document can be streamed across several chunks. Numbers are written in their shortest integer
+form, fixed-point values as float32, uptime as integer milliseconds and IPv4 addresses as tag 52
+byte strings (RFC 9164). Writing past the end sets overflow() instead of truncating silently.
+*/
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+class CborWriter
+{
+public:
+    CborWriter(uint8_t *buf, size_t cap) : buf(buf), cap(cap) {}
+
+    CborWriter &beginObject() { return put(0xBF); } // Indefinite-length map
+    CborWriter &endObject() { return put(0xFF); }   // Break
+    CborWriter &beginArray() { return put(0x9F); }  // Indefinite-length array
+    CborWriter &endArray() { return put(0xFF); }
+
+    CborWriter &key(const char *name) { return str(name); } // Map keys are text strings
+
+    CborWriter &str(const char *value)
+    {
+        size_t n = strlen(value);
+        head(3, n);
+        return bytesRaw((const uint8_t *)value, n);
+    }
+
+    CborWriter &boolean(bool value) { return put(value ? 0xF5 : 0xF4); }
+    CborWriter &null() { return put(0xF6); }
+    CborWriter &number(uint32_t value) { return head(0, value); }
+    CborWriter &number64(uint64_t value) { return head(0, value); }
+
+    CborWriter &integer(int32_t value)
+    {
+        if (value < 0)
+            return head(1, (uint64_t)(-1 - (int64_t)value)); // Major type 1 stores -1 - n
+        return head(0, (uint64_t)value);
+    }
+
+    // Fixed-point value from JsonWriter's interface - float32 here, NAN/inf become null
+    template <uint8_t Decimals>
+    CborWriter &fixed(float value)
+    {
+        if (isnan(value) || isinf(value))
+            return null();
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        put(0xFA);
+        return be(bits, 4);
+    }
+
+    CborWriter &uptime(uint32_t ms) { return number(ms); } // Raw milliseconds - the text form is a UI concern
+
+    CborWriter &ipv4(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+    {
+        const uint8_t addr[4] = {a, b, c, d};
+        head(6, 52); // Tag 52: IPv4 address
+        return bytes(addr, 4);
+    }
+
+    CborWriter &bytes(const uint8_t *data, size_t n)
+    {
+        head(2, n);
+        return bytesRaw(data, n);
+    }
+
+    size_t length() const { return len; }
+    bool overflow() const { return overflowed; }
+    const uint8_t *data() const { return buf; }
+
+private:
+    CborWriter &put(uint8_t b)
+    {
+        if (len < cap)
+            buf[len++] = b;
+        else
+            overflowed = true;
+        return *this;
+    }
+
+    CborWriter &bytesRaw(const uint8_t *data, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+            put(data[i]);
+        return *this;
+    }
+
+    // n-byte big-endian value
+    CborWriter &be(uint64_t v, uint8_t n)
+    {
+        while (n--)
+            put((uint8_t)(v >> (8 * n)));
+        return *this;
+    }
+
+    // Initial byte plus argument in the shortest form
+    CborWriter &head(uint8_t major, uint64_t v)
+    {
+        uint8_t m = (uint8_t)(major << 5);
+        if (v < 24)
+            return put((uint8_t)(m | v));
+        if (v <= 0xFF)
+            return put(m | 24).be(v, 1);
+        if (v <= 0xFFFF)
+            return put(m | 25).be(v, 2);
+        if (v <= 0xFFFFFFFFULL)
+            return put(m | 26).be(v, 4);
+        return put(m | 27).be(v, 8);
+    }
+
+    uint8_t *buf;
+    size_t cap;
+    size_t len = 0;
+    bool overflowed = false;
+};
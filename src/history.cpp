@@ -0,0 +1,134 @@
+#include "history.h"
+
+#include <math.h>
+
+// Keyframe: ts u32, temp i16, press u16, flags u8 (little endian)
+const uint8_t KEYFRAME_SIZE = 9;
+// Worst-case delta record: dt varint (5) + temp zigzag varint (3) + press zigzag varint (3)
+const uint8_t MAX_DELTA_SIZE = 11;
+
+static uint8_t putVarint(uint8_t *p, uint32_t v)
+{
+    uint8_t n = 0;
+    while (v >= 0x80)
+    {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static uint32_t getVarint(const uint8_t *p, uint16_t &off)
+{
+    uint32_t v = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7)
+    {
+        uint8_t b = p[off++];
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80))
+            break;
+    }
+    return v;
+}
+
+static uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static int32_t unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+void TelemetryHistory::append(uint32_t ts, float tempC, float pressHpa, bool brewOn)
+{
+    Sample s;
+    s.ts = ts;
+    s.tempCenti = isnan(tempC) ? HISTORY_NO_TEMP : (int16_t)lroundf(fminf(fmaxf(tempC, -327.0f), 327.0f) * 100.0f);
+    s.pressDeci = isnan(pressHpa) ? 0 : (uint16_t)lroundf(fminf(fmaxf(pressHpa, 0.0f), 6553.0f) * 10.0f);
+    s.brewOn = brewOn;
+    if (count && ts < last.ts)
+        s.ts = last.ts; // Never let time run backwards inside the ring
+
+    Block *b = count ? &blocks[(first + count - 1) % HISTORY_BLOCKS] : nullptr;
+    if (!b || b->used + MAX_DELTA_SIZE > HISTORY_BLOCK_SIZE)
+    { // Start a new block with a keyframe, dropping the oldest block when the ring is full
+        if (count == HISTORY_BLOCKS)
+        {
+            first = (first + 1) % HISTORY_BLOCKS;
+            count--;
+        }
+        b = &blocks[(first + count) % HISTORY_BLOCKS];
+        count++;
+        uint8_t *p = b->data;
+        p[0] = (uint8_t)s.ts;
+        p[1] = (uint8_t)(s.ts >> 8);
+        p[2] = (uint8_t)(s.ts >> 16);
+        p[3] = (uint8_t)(s.ts >> 24);
+        p[4] = (uint8_t)s.tempCenti;
+        p[5] = (uint8_t)((uint16_t)s.tempCenti >> 8);
+        p[6] = (uint8_t)s.pressDeci;
+        p[7] = (uint8_t)(s.pressDeci >> 8);
+        p[8] = s.brewOn ? 1 : 0;
+        b->used = KEYFRAME_SIZE;
+    }
+    else
+    { // Delta record: (dt << 1 | brew), zigzag dTemp, zigzag dPress
+        uint8_t *p = b->data + b->used;
+        uint8_t n = putVarint(p, ((s.ts - last.ts) << 1) | (s.brewOn ? 1 : 0));
+        n += putVarint(p + n, zigzag((int32_t)s.tempCenti - last.tempCenti));
+        n += putVarint(p + n, zigzag((int32_t)s.pressDeci - last.pressDeci));
+        b->used += n;
+    }
+    last = s;
+}
+
+// Decode one record; off == 0 reads the keyframe, otherwise a delta applied to s
+bool TelemetryHistory::decode(const Block &b, uint16_t &off, Sample &s) const
+{
+    if (off >= b.used)
+        return false;
+    const uint8_t *p = b.data;
+    if (off == 0)
+    {
+        s.ts = (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+        s.tempCenti = (int16_t)(p[4] | p[5] << 8);
+        s.pressDeci = (uint16_t)(p[6] | p[7] << 8);
+        s.brewOn = p[8] & 1;
+        off = KEYFRAME_SIZE;
+        return true;
+    }
+    uint32_t head = getVarint(p, off);
+    s.ts += head >> 1;
+    s.brewOn = head & 1;
+    s.tempCenti = (int16_t)(s.tempCenti + unzigzag(getVarint(p, off)));
+    s.pressDeci = (uint16_t)(s.pressDeci + unzigzag(getVarint(p, off)));
+    return true;
+}
+
+size_t TelemetryHistory::read(uint32_t from, uint32_t step, Sample *out, size_t max, uint32_t &next) const
+{
+    next = from;
+    if (!count || !max)
+        return 0;
+    // Skip whole blocks that end before from: block i ends before block i+1's keyframe
+    uint8_t start = 0;
+    for (uint8_t i = 1; i < count; i++)
+    {
+        const uint8_t *p = blocks[(first + i) % HISTORY_BLOCKS].data;
+        uint32_t keyTs = (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+        if (keyTs > from)
+            break;
+        start = i;
+    }
+    size_t n = 0;
+    for (uint8_t i = start; i < count && n < max; i++)
+    {
+        const Block &b = blocks[(first + i) % HISTORY_BLOCKS];
+        Sample s = {};
+        uint16_t off = 0;
+        while (n < max && decode(b, off, s))
+        {
+            if (s.ts < next)
+                continue;
+            out[n++] = s;
+            next = s.ts + (step ? step : 1); // Earliest timestamp for the next emitted sample
+        }
+    }
+    return n;
+}
@@ -0,0 +1,46 @@
+/*
+Telemetry history for Embedded Brew.
+
+Fixed-size ring of timestamped temperature/pressure/brew samples kept in a compact binary form.
+Storage is split into blocks; each block opens with an absolute keyframe and continues with
+delta records (zigzag varints), so a typical sample costs about 3 bytes and the oldest block can
+be dropped without breaking decoding of the rest. 16 x 256 byte blocks hold several hours at a
+10 s sample period.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+const uint16_t HISTORY_BLOCK_SIZE = 256; // Bytes per block (keyframe + deltas)
+const uint8_t HISTORY_BLOCKS = 16;       // Blocks in the ring - 4 KB of samples
+const int16_t HISTORY_NO_TEMP = INT16_MIN; // Stored temperature when the sensor had no reading
+
+class TelemetryHistory
+{
+public:
+    struct Sample
+    {
+        uint32_t ts;        // Seconds since boot
+        int16_t tempCenti;  // Temperature in 0.01 C (HISTORY_NO_TEMP if unavailable)
+        uint16_t pressDeci; // Pressure in 0.1 hPa (0 if unavailable)
+        bool brewOn;        // Brew state at sample time
+    };
+
+    void append(uint32_t ts, float tempC, float pressHpa, bool brewOn); // Add a sample (ts must not go backwards)
+    // Decode up to max samples with ts >= from, keeping at most one sample per step seconds.
+    // Returns the number decoded and sets next to the cursor for the following call.
+    size_t read(uint32_t from, uint32_t step, Sample *out, size_t max, uint32_t &next) const;
+
+private:
+    struct Block
+    {
+        uint8_t data[HISTORY_BLOCK_SIZE];
+        uint16_t used; // Encoded bytes in data
+    };
+    bool decode(const Block &b, uint16_t &off, Sample &s) const; // Decode the record at off into s
+    Block blocks[HISTORY_BLOCKS];
+    uint8_t first = 0; // Oldest block
+    uint8_t count = 0; // Blocks in use
+    Sample last = {};  // Last appended sample (delta base)
+};
@@ -0,0 +1,866 @@
+#include "http_server.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <lwip/sockets.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // lwIP never raises SIGPIPE
+#endif
+
+/*------- Helpers -------*/
+
+uint32_t httpNowMs()
+{
+#ifdef ARDUINO
+    return millis();
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000ULL);
+#endif
+}
+
+const char *httpStatusText(int code)
+{
+    switch (code)
+    {
+    case 200: return "OK";
+    case 201: return "Created";
+    case 204: return "No Content";
+    case 303: return "See Other";
+    case 304: return "Not Modified";
+    case 307: return "Temporary Redirect";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 408: return "Request Timeout";
+    case 409: return "Conflict";
+    case 411: return "Length Required";
+    case 413: return "Payload Too Large";
+    case 416: return "Range Not Satisfiable";
+    case 422: return "Unprocessable Entity";
+    case 429: return "Too Many Requests";
+    case 431: return "Request Header Fields Too Large";
+    case 500: return "Internal Server Error";
+    case 501: return "Not Implemented";
+    case 503: return "Service Unavailable";
+    default: return "Unknown";
+    }
+}
+
+// Put a socket into non-blocking mode
+static void setNonBlocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+// Find the blank line ending the request headers, returns the header length including it or 0
+static size_t findHeaderEnd(const char *buf, size_t len)
+{
+    for (size_t i = 3; i < len; i++)
+    {
+        if (buf[i] == '\n' && buf[i - 1] == '\r' && buf[i - 2] == '\n' && buf[i - 3] == '\r')
+            return i + 1;
+    }
+    return 0;
+}
+
+// Read Content-Length from raw (unparsed) headers without modifying them, -1 if malformed
+static long peekContentLength(const char *buf, size_t headerLen)
+{
+    static const char KEY[] = "\r\ncontent-length:";
+    const size_t keyLen = sizeof(KEY) - 1;
+    for (size_t i = 0; i + keyLen < headerLen; i++)
+    {
+        if (strncasecmp(buf + i, KEY, keyLen) != 0)
+            continue;
+        const char *p = buf + i + keyLen;
+        while (*p == ' ' || *p == '\t')
+            p++;
+        if (!isdigit((unsigned char)*p))
+            return -1;
+        return strtol(p, nullptr, 10);
+    }
+    return 0;
+}
+
+static int hexValue(char ch)
+{
+    if (ch >= '0' && ch <= '9')
+        return ch - '0';
+    if (ch >= 'a' && ch <= 'f')
+        return ch - 'a' + 10;
+    if (ch >= 'A' && ch <= 'F')
+        return ch - 'A' + 10;
+    return -1;
+}
+
+// Look up name in an application/x-www-form-urlencoded string and URL-decode its value into out
+static bool findArg(const char *src, size_t srcLen, const char *name, char *out, size_t outLen)
+{
+    size_t nameLen = strlen(name);
+    const char *p = src;
+    const char *end = src + srcLen;
+    while (p < end)
+    {
+        const char *amp = (const char *)memchr(p, '&', end - p);
+        if (!amp)
+            amp = end;
+        const char *eq = (const char *)memchr(p, '=', amp - p);
+        const char *keyEnd = eq ? eq : amp;
+        if ((size_t)(keyEnd - p) == nameLen && memcmp(p, name, nameLen) == 0)
+        {
+            if (out && outLen)
+            {
+                size_t o = 0;
+                for (const char *v = eq ? eq + 1 : amp; v < amp && o + 1 < outLen; v++)
+                {
+                    if (*v == '+')
+                        out[o++] = ' ';
+                    else if (*v == '%' && v + 2 < amp && hexValue(v[1]) >= 0 && hexValue(v[2]) >= 0)
+                    {
+                        out[o++] = (char)(hexValue(v[1]) * 16 + hexValue(v[2]));
+                        v += 2;
+                    }
+                    else
+                        out[o++] = *v;
+                }
+                out[o] = '\0';
+            }
+            return true;
+        }
+        p = amp + 1;
+    }
+    return false;
+}
+
+/*------- Request -------*/
+
+const char *HttpRequest::header(const char *name) const
+{
+    for (uint8_t i = 0; i < headerCount; i++)
+    {
+        if (strcasecmp(headers[i].name, name) == 0)
+            return headers[i].value;
+    }
+    return nullptr;
+}
+
+bool HttpRequest::arg(const char *name, char *out, size_t outLen) const
+{
+    if (findArg(query, strlen(query), name, out, outLen))
+        return true;
+    const char *type = header("Content-Type");
+    if (body && type && strncasecmp(type, "application/x-www-form-urlencoded", 33) == 0)
+        return findArg((const char *)body, bodyLen, name, out, outLen);
+    return false;
+}
+
+bool HttpRequest::hasArg(const char *name) const
+{
+    return arg(name, nullptr, 0);
+}
+
+long HttpRequest::argInt(const char *name, long fallback) const
+{
+    char buf[16];
+    if (!arg(name, buf, sizeof(buf)) || !buf[0])
+        return fallback;
+    char *end;
+    long v = strtol(buf, &end, 10);
+    return *end ? fallback : v;
+}
+
+/*------- Response -------*/
+
+void HttpResponse::header(const char *name, const char *value)
+{
+    int n = snprintf(extra + extraLen, sizeof(extra) - extraLen, "%s: %s\r\n", name, value);
+    if (n > 0 && extraLen + n < sizeof(extra))
+        extraLen += n; // Headers that do not fit are dropped rather than truncated
+}
+
+// Write status line and headers into the (empty) tx buffer, contentLength < 0 omits Content-Length
+bool HttpResponse::writeHead(int code, const char *type, long contentLength, bool chunked)
+{
+    char *out = c.tx;
+    size_t cap = HTTP_TX_BUF;
+    int n = snprintf(out, cap, "HTTP/1.1 %d %s\r\n", code, httpStatusText(code));
+    if (type && *type)
+        n += snprintf(out + n, cap > (size_t)n ? cap - n : 0, "Content-Type: %s\r\n", type);
+    if (chunked)
+        n += snprintf(out + n, cap > (size_t)n ? cap - n : 0, "Transfer-Encoding: chunked\r\n");
+    else if (contentLength >= 0)
+        n += snprintf(out + n, cap > (size_t)n ? cap - n : 0, "Content-Length: %ld\r\n", contentLength);
+    n += snprintf(out + n, cap > (size_t)n ? cap - n : 0, "Connection: %s\r\n", c.keepAlive ? "keep-alive" : "close");
+    if ((size_t)n + extraLen + 2 >= cap)
+        return false;
+    memcpy(out + n, extra, extraLen);
+    n += extraLen;
+    memcpy(out + n, "\r\n", 2);
+    c.txLen = n + 2;
+    c.txOff = 0;
+    return true;
+}
+
+void HttpResponse::send(int code, const char *type, const char *body)
+{
+    send(code, type, body, body ? strlen(body) : 0);
+}
+
+void HttpResponse::send(int code, const char *type, const void *body, size_t len)
+{
+    if (done)
+        return;
+    done = true;
+    bool noBody = code == 204 || code == 304;
+    if (!writeHead(code, type, noBody ? -1 : (long)len, false) || (!headOnly && !noBody && c.txLen + len > HTTP_TX_BUF))
+    { // Response does not fit the connection buffer - report it instead of truncating
+        extraLen = 0;
+        c.keepAlive = false;
+        writeHead(500, "text/plain", 18, false);
+        memcpy(c.tx + c.txLen, "Response too large", 18);
+        c.txLen += 18;
+        return;
+    }
+    if (!headOnly && !noBody && len)
+    {
+        memcpy(c.tx + c.txLen, body, len);
+        c.txLen += len;
+    }
+}
+
+void HttpResponse::sendStatic(int code, const char *type, const void *body, size_t len)
+{
+    if (done)
+        return;
+    done = true;
+    if (!writeHead(code, type, (long)len, false))
+    {
+        done = false;
+        send(500, "text/plain", "Header overflow");
+        return;
+    }
+    if (!headOnly)
+    {
+        c.staticBody = (const uint8_t *)body;
+        c.staticLen = len;
+    }
+}
+
+void HttpResponse::sendChunked(int code, const char *type, HttpStreamFn fn, const HttpStreamState &state)
+{
+    if (done)
+        return;
+    done = true;
+    if (!writeHead(code, type, -1, true))
+    {
+        done = false;
+        send(500, "text/plain", "Header overflow");
+        return;
+    }
+    if (!headOnly)
+    {
+        c.streamFn = fn;
+        c.stream = state;
+        c.streamDone = false;
+    }
+}
+
+bool HttpResponse::beginEventStream(const char *hello)
+{
+    if (done || srv.eventSubscribers() >= srv.maxEventStreams)
+        return false;
+    header("Cache-Control", "no-cache");
+    size_t helloLen = hello ? strlen(hello) : 0;
+    if (!writeHead(200, "text/event-stream", -1, false) || c.txLen + helloLen > HTTP_TX_BUF)
+        return false;
+    if (helloLen)
+        memcpy(c.tx + c.txLen, hello, helloLen); // First bytes of the stream go out with the headers
+    c.txLen += helloLen;
+    done = true;
+    c.eventStream = true;
+    c.eventDrops = 0;
+    return true;
+}
+
+/*------- Server -------*/
+
+bool HttpServer::begin()
+{
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0)
+        return false;
+    int one = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(listenFd, (sockaddr *)&addr, sizeof(addr)) < 0 || listen(listenFd, HTTP_LISTEN_BACKLOG) < 0)
+    {
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    setNonBlocking(listenFd);
+    return true;
+}
+
+bool HttpServer::on(const char *path, uint8_t methods, HttpHandler handler)
+{
+    if (routeCount >= HTTP_MAX_ROUTES)
+        return false; // Would answer 404 - callers must not ignore this
+    routes[routeCount++] = {path, methods, handler};
+    return true;
+}
+
+bool HttpServer::responsePending(const HttpConn &c) const
+{
+    return c.txOff < c.txLen || c.staticLen > 0 || c.streamFn != nullptr;
+}
+
+// Keep-alive connection between requests - served before, nothing buffered either way, not an event stream
+bool HttpServer::idleKeepAlive(const HttpConn &c) const
+{
+    return c.fd >= 0 && !c.eventStream && c.rxLen == 0 && c.served > 0 && !responsePending(c);
+}
+
+uint8_t HttpServer::eventSubscribers() const
+{
+    uint8_t n = 0;
+    for (const HttpConn &c : conns)
+        n += c.fd >= 0 && c.eventStream;
+    return n;
+}
+
+uint8_t HttpServer::activeConnections() const
+{
+    uint8_t n = 0;
+    for (const HttpConn &c : conns)
+        n += c.fd >= 0;
+    return n;
+}
+
+// Fill the select() sets for the current connection states, returns the highest fd (-1 if none)
+int HttpServer::watchSet(fd_set &rd, fd_set &wr, bool &canAccept) const
+{
+    // Only watch the listener while a slot is free or an idle keep-alive slot can be reclaimed,
+    // otherwise new clients wait in the kernel backlog instead of spinning the loop
+    canAccept = false;
+    for (const HttpConn &c : conns)
+        canAccept |= c.fd < 0 || idleKeepAlive(c);
+    FD_ZERO(&rd);
+    FD_ZERO(&wr);
+    int maxFd = -1;
+    if (canAccept)
+    {
+        FD_SET(listenFd, &rd);
+        maxFd = listenFd;
+    }
+    for (const HttpConn &c : conns)
+    {
+        if (c.fd < 0)
+            continue;
+        if (c.eventStream || (!responsePending(c) && c.rxLen < HTTP_RX_BUF))
+            FD_SET(c.fd, &rd); // Event streams are read only to notice the peer closing
+        if (responsePending(c))
+            FD_SET(c.fd, &wr);
+        if (c.fd > maxFd)
+            maxFd = c.fd;
+    }
+    return maxFd;
+}
+
+bool HttpServer::wait(uint32_t waitMs)
+{
+    if (listenFd < 0)
+        return false;
+    fd_set rd, wr;
+    bool canAccept;
+    int maxFd = watchSet(rd, wr, canAccept);
+    if (waiting)
+        waitMs = 0; // Requests already buffered - only check for more activity
+    timeval tv = {(long)(waitMs / 1000), (long)((waitMs % 1000) * 1000)};
+    return select(maxFd + 1, &rd, &wr, nullptr, &tv) > 0 || waiting;
+}
+
+void HttpServer::poll(uint32_t waitMs)
+{
+    if (listenFd < 0)
+        return;
+    fd_set rd, wr;
+    bool canAccept;
+    int maxFd = watchSet(rd, wr, canAccept);
+    timeval tv = {(long)(waitMs / 1000), (long)((waitMs % 1000) * 1000)};
+    int ready = select(maxFd + 1, &rd, &wr, nullptr, &tv);
+    uint32_t now = httpNowMs();
+    if (ready > 0 && canAccept && FD_ISSET(listenFd, &rd))
+        acceptClients(now);
+    budget = maxDispatchPerPoll;
+    uint8_t first = nextConn;
+    nextConn = (uint8_t)((nextConn + 1) % HTTP_MAX_CONNS); // Rotate who goes first when the budget runs out
+    for (uint8_t k = 0; k < HTTP_MAX_CONNS; k++)
+    {
+        HttpConn &c = conns[(first + k) % HTTP_MAX_CONNS];
+        if (c.fd < 0)
+            continue;
+        if (ready > 0 && FD_ISSET(c.fd, &rd))
+            readConn(c, now);
+        if (c.fd >= 0 && ready > 0 && FD_ISSET(c.fd, &wr))
+            flushConn(c, now);
+        if (c.fd >= 0)
+            processConn(c, now);
+        if (c.fd < 0)
+            continue;
+        // Timeouts: stalled writes, slow request senders and idle keep-alive connections
+        bool expired;
+        if (responsePending(c))
+            expired = now - c.lastMs > HTTP_WRITE_TIMEOUT_MS;
+        else if (c.eventStream)
+            expired = false;
+        else if (c.rxLen > 0)
+            expired = now - c.startMs > HTTP_READ_TIMEOUT_MS;
+        else
+            expired = now - c.lastMs > HTTP_IDLE_TIMEOUT_MS;
+        if (expired)
+        {
+            st.timeouts++;
+            closeConn(c);
+        }
+    }
+    shedQueue(now);
+}
+
+// A complete request header is buffered but has not been dispatched yet
+bool HttpServer::requestWaiting(const HttpConn &c) const
+{
+    return c.fd >= 0 && !c.eventStream && !c.closeAfter && !responsePending(c) && c.rxLen > 0 &&
+           findHeaderEnd(c.rx, c.rxLen) > 0;
+}
+
+// Requests the dispatch budget left behind wait for the next poll(); beyond maxQueued the newest
+// are answered 503 so a burst cannot pile up more work than the next pass will take
+void HttpServer::shedQueue(uint32_t now)
+{
+    uint8_t queued = 0;
+    for (const HttpConn &c : conns)
+        queued += requestWaiting(c);
+    if (queued > st.queuePeak)
+        st.queuePeak = queued;
+    while (queued > maxQueued)
+    {
+        HttpConn *newest = nullptr;
+        for (HttpConn &c : conns)
+        {
+            if (requestWaiting(c) && (!newest || newest->startMs - c.startMs > 0x80000000UL))
+                newest = &c; // Latest start (wrap-safe compare)
+        }
+        reject(*newest, 503, 1);
+        flushConn(*newest, now);
+        queued--;
+    }
+    waiting = queued;
+}
+
+void HttpServer::acceptClients(uint32_t now)
+{
+    for (;;)
+    {
+        HttpConn *slot = nullptr;
+        HttpConn *idlest = nullptr;
+        for (HttpConn &c : conns)
+        {
+            if (c.fd < 0)
+            {
+                slot = &c;
+                break;
+            }
+            if (idleKeepAlive(c) && (!idlest || c.lastMs - idlest->lastMs > 0x80000000UL))
+                idlest = &c; // Longest-idle keep-alive connection (wrap-safe compare)
+        }
+        if (!slot && !idlest)
+            return; // Pool full of busy connections - leave the rest in the backlog
+        sockaddr_in addr = {};
+        socklen_t addrLen = sizeof(addr);
+        int fd = accept(listenFd, (sockaddr *)&addr, &addrLen);
+        if (fd < 0)
+            return; // Backlog drained
+        uint8_t sameIp = 0;
+        HttpConn *ipIdlest = nullptr; // Longest-idle keep-alive connection of this address
+        for (HttpConn &c : conns)
+        {
+            if (c.fd < 0 || c.ip != addr.sin_addr.s_addr)
+                continue;
+            sameIp++;
+            if (idleKeepAlive(c) && (!ipIdlest || c.lastMs - ipIdlest->lastMs > 0x80000000UL))
+                ipIdlest = &c;
+        }
+        bool atCap = maxConnsPerIp < HTTP_MAX_CONNS && sameIp >= maxConnsPerIp;
+        if (atCap && !ipIdlest)
+        { // Address holds its share of the pool and every one is busy - refuse without taking a slot
+            static const char BUSY[] = "HTTP/1.1 503 Service Unavailable\r\nRetry-After: 1\r\n"
+                                       "Content-Length: 0\r\nConnection: close\r\n\r\n";
+            char scratch[64];
+            recv(fd, scratch, sizeof(scratch), MSG_DONTWAIT); // Unread request bytes would turn the close into a reset
+            send(fd, BUSY, sizeof(BUSY) - 1, MSG_DONTWAIT | MSG_NOSIGNAL);
+            close(fd);
+            st.shed++;
+            continue;
+        }
+        if (atCap || !slot)
+        { // Reclaim a keep-alive connection - the address's own (a browser's spare) at its cap, else the pool's longest-idle
+            slot = atCap ? ipIdlest : idlest;
+            st.evictedIdle++;
+            closeConn(*slot);
+        }
+        setNonBlocking(fd);
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)); // Responses are small, send them at once
+        slot->fd = fd;
+        slot->ip = addr.sin_addr.s_addr;
+        slot->lastMs = now;
+        slot->startMs = now;
+        st.accepted++;
+    }
+}
+
+void HttpServer::readConn(HttpConn &c, uint32_t now)
+{
+    if (c.eventStream)
+    { // Discard anything the subscriber sends, only watch for it closing
+        char scratch[64];
+        int n = recv(c.fd, scratch, sizeof(scratch), MSG_DONTWAIT);
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+            closeConn(c);
+        return;
+    }
+    int n = recv(c.fd, c.rx + c.rxLen, HTTP_RX_BUF - c.rxLen, MSG_DONTWAIT);
+    if (n > 0)
+    {
+        if (c.rxLen == 0)
+            c.startMs = now; // First byte of a new request
+        c.rxLen += n;
+        c.lastMs = now;
+    }
+    else if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+    {
+        closeConn(c); // Peer closed or socket error
+    }
+}
+
+// Dispatch every complete request in rx, one at a time, as long as the previous response has drained
+void HttpServer::processConn(HttpConn &c, uint32_t now)
+{
+    while (c.fd >= 0 && !c.eventStream && !c.closeAfter && !responsePending(c) && c.rxLen > 0 && budget > 0)
+    {
+        size_t headerLen = findHeaderEnd(c.rx, c.rxLen);
+        if (!headerLen)
+        {
+            if (c.rxLen >= HTTP_RX_BUF)
+                replyError(c, 431, "Request headers too large");
+            break; // Wait for the rest of the headers
+        }
+        long bodyLen = peekContentLength(c.rx, headerLen);
+        if (bodyLen < 0)
+        {
+            replyError(c, 400, "Bad Content-Length");
+            break;
+        }
+        if (headerLen + (size_t)bodyLen > HTTP_RX_BUF)
+        {
+            replyError(c, 413, "Request body too large");
+            break;
+        }
+        size_t total = headerLen + (size_t)bodyLen;
+        if (c.rxLen < total)
+            break; // Wait for the rest of the body
+        if (!handleRequest(c, headerLen, (size_t)bodyLen))
+            break;
+        // Drop the handled request, keep any pipelined bytes behind it (an event stream reads nothing more)
+        c.rxLen = c.eventStream ? 0 : c.rxLen - total;
+        memmove(c.rx, c.rx + total, c.rxLen);
+        c.startMs = now;
+        flushConn(c, now);
+    }
+    if (c.fd >= 0 && responsePending(c))
+        flushConn(c, now); // Error replies queued above
+}
+
+// Parse the request in place and run its handler, returns false if the connection was answered with an error
+bool HttpServer::handleRequest(HttpConn &c, size_t headerLen, size_t bodyLen)
+{
+    if (budget)
+        budget--;
+    HttpRequest req = {};
+    char *buf = c.rx;
+    buf[headerLen - 4] = '\0'; // Terminate the header block at the blank line
+    // Request line: METHOD SP target SP version
+    char *line = buf;
+    char *next = strstr(line, "\r\n");
+    if (next)
+    {
+        *next = '\0';
+        next += 2;
+    }
+    char *sp1 = strchr(line, ' ');
+    char *sp2 = sp1 ? strchr(sp1 + 1, ' ') : nullptr;
+    if (!sp1 || !sp2 || sp1[1] != '/')
+    {
+        replyError(c, 400, "Bad request line");
+        return false;
+    }
+    *sp1 = '\0';
+    *sp2 = '\0';
+    if (strcmp(line, "GET") == 0)
+        req.method = HttpMethod::Get;
+    else if (strcmp(line, "HEAD") == 0)
+        req.method = HttpMethod::Head;
+    else if (strcmp(line, "POST") == 0)
+        req.method = HttpMethod::Post;
+    else if (strcmp(line, "PUT") == 0)
+        req.method = HttpMethod::Put;
+    else if (strcmp(line, "DELETE") == 0)
+        req.method = HttpMethod::Delete;
+    else
+        req.method = HttpMethod::Other;
+    char *target = sp1 + 1;
+    char *q = strchr(target, '?');
+    if (q)
+        *q++ = '\0';
+    req.path = target;
+    req.query = q ? q : "";
+    c.keepAlive = strcmp(sp2 + 1, "HTTP/1.1") == 0; // HTTP/1.0 closes unless asked otherwise
+    // Header lines
+    for (line = next; line && *line; line = next)
+    {
+        next = strstr(line, "\r\n");
+        if (next)
+        {
+            *next = '\0';
+            next += 2;
+        }
+        char *colon = strchr(line, ':');
+        if (!colon || req.headerCount >= HTTP_MAX_HEADERS)
+            continue;
+        *colon = '\0';
+        char *value = colon + 1;
+        while (*value == ' ' || *value == '\t')
+            value++;
+        req.headers[req.headerCount++] = {line, value};
+    }
+    const char *conn = req.header("Connection");
+    if (conn && strcasecmp(conn, "close") == 0)
+        c.keepAlive = false;
+    else if (conn && strcasecmp(conn, "keep-alive") == 0)
+        c.keepAlive = true;
+    if (req.header("Transfer-Encoding"))
+    {
+        replyError(c, 501, "Chunked request bodies are not supported");
+        return false;
+    }
+    if (c.served + 1 >= HTTP_MAX_KEEPALIVE_REQS)
+        c.keepAlive = false;
+    req.body = bodyLen ? (const uint8_t *)buf + headerLen : nullptr;
+    req.bodyLen = bodyLen;
+    req.clientIp = c.ip;
+    uint32_t retryAfterS = 1;
+    int refused = admit ? admit(req, retryAfterS) : 0;
+    if (refused)
+    {
+        reject(c, refused, retryAfterS);
+        return false;
+    }
+    // Route lookup - exact path match, 405 if only the method differs
+    HttpHandler handler = nullptr;
+    bool pathMatched = false;
+    for (uint8_t i = 0; i < routeCount && !handler; i++)
+    {
+        if (strcmp(routes[i].path, req.path) != 0)
+            continue;
+        pathMatched = true;
+        uint8_t m = (uint8_t)req.method;
+        if (routes[i].methods & m || (req.method == HttpMethod::Head && routes[i].methods & (uint8_t)HttpMethod::Get))
+            handler = routes[i].handler;
+    }
+    st.requests++;
+    if (c.served > 0)
+        st.keepAliveReuse++;
+    c.served++;
+    HttpResponse res(*this, c, req.method == HttpMethod::Head);
+    if (handler)
+        handler(req, res);
+    else if (pathMatched)
+        res.send(405, "text/plain", "Method not allowed");
+    else if (notFound)
+        notFound(req, res);
+    if (!res.sent())
+        res.send(500, "text/plain", "No response");
+    if (!st.firstResponseMs)
+        st.firstResponseMs = httpNowMs() | 1; // Never 0 once set, even if the clock just started
+    if (!c.keepAlive && !c.eventStream)
+        c.closeAfter = true;
+    return true;
+}
+
+void HttpServer::flushConn(HttpConn &c, uint32_t now)
+{
+    while (c.fd >= 0)
+    {
+        const uint8_t *data;
+        size_t len;
+        if (c.txOff < c.txLen)
+        {
+            data = (const uint8_t *)c.tx + c.txOff;
+            len = c.txLen - c.txOff;
+        }
+        else if (c.staticLen > 0)
+        {
+            c.txOff = c.txLen = 0;
+            data = c.staticBody;
+            len = c.staticLen;
+        }
+        else if (c.streamFn && !c.streamDone)
+        { // Refill tx with the next chunk: room for a hex size line in front and CRLF behind
+            const size_t HEAD = 6;
+            size_t n = c.streamFn(c.stream, c.tx + HEAD, HTTP_TX_BUF - HEAD - 2);
+            if (n == HTTP_STREAM_ABORT)
+            { // The status line already said 200 - a missing last chunk is the only error left to report
+                closeConn(c);
+                return;
+            }
+            if (n == 0)
+            {
+                memcpy(c.tx, "0\r\n\r\n", 5);
+                c.txOff = 0;
+                c.txLen = 5;
+                c.streamDone = true;
+            }
+            else
+            {
+                char size[HEAD + 1];
+                int sl = snprintf(size, sizeof(size), "%x\r\n", (unsigned)n);
+                memcpy(c.tx + HEAD - sl, size, sl);
+                memcpy(c.tx + HEAD + n, "\r\n", 2);
+                c.txOff = HEAD - sl;
+                c.txLen = HEAD + n + 2;
+            }
+            continue;
+        }
+        else
+        { // Response complete
+            c.txOff = c.txLen = 0;
+            c.streamFn = nullptr;
+            if (c.closeAfter)
+                closeConn(c);
+            return;
+        }
+        int sent = send(c.fd, data, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent > 0)
+        {
+            if (c.txOff < c.txLen)
+                c.txOff += sent;
+            else
+            {
+                c.staticBody += sent;
+                c.staticLen -= sent;
+            }
+            c.lastMs = now;
+        }
+        else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return; // Socket buffer full - continue when select() reports it writable
+        }
+        else
+        {
+            closeConn(c);
+        }
+    }
+}
+
+void HttpServer::broadcastEvent(const char *frame, size_t len)
+{
+    if (len > HTTP_TX_BUF)
+        return;
+    uint32_t now = httpNowMs();
+    for (HttpConn &c : conns)
+    {
+        if (c.fd < 0 || !c.eventStream)
+            continue;
+        if (responsePending(c))
+        { // Subscriber still draining an earlier frame - skip this one, the next carries the full state
+            st.eventDrops++;
+            if (++c.eventDrops > maxEventDrops)
+                closeConn(c);
+            continue;
+        }
+        memcpy(c.tx, frame, len);
+        c.txOff = 0;
+        c.txLen = len;
+        c.eventDrops = 0;
+        flushConn(c, now);
+    }
+}
+
+void HttpServer::replyError(HttpConn &c, int code, const char *msg)
+{
+    st.badRequests++;
+    c.keepAlive = false;
+    c.rxLen = 0; // Rest of the stream cannot be trusted
+    HttpResponse res(*this, c, false);
+    res.send(code, "text/plain", msg);
+    c.closeAfter = true;
+}
+
+// Refuse the buffered request(s) with Retry-After and close, freeing the slot for other clients
+void HttpServer::reject(HttpConn &c, int code, uint32_t retryAfterS)
+{
+    if (code == 429)
+        st.rateLimited++;
+    else
+        st.shed++;
+    c.keepAlive = false;
+    c.rxLen = 0;
+    HttpResponse res(*this, c, false);
+    char wait[12];
+    snprintf(wait, sizeof(wait), "%lu", (unsigned long)retryAfterS);
+    res.header("Retry-After", wait);
+    res.send(code, "text/plain", httpStatusText(code));
+    c.closeAfter = true;
+}
+
+void HttpServer::closeConn(HttpConn &c)
+{
+    if (c.fd >= 0)
+        close(c.fd);
+    c.fd = -1;
+    c.ip = 0;
+    c.served = 0;
+    c.keepAlive = true;
+    c.closeAfter = false;
+    c.eventStream = false;
+    c.eventDrops = 0;
+    c.rxLen = c.txLen = c.txOff = 0;
+    c.staticBody = nullptr;
+    c.staticLen = 0;
+    c.streamFn = nullptr;
+    c.streamDone = false;
+}
@@ -0,0 +1,216 @@
+/*
+Non-blocking HTTP/1.1 server for Embedded Brew.
+
+A single select() loop services a fixed pool of connections, so one slow or half-open client
+can no longer hold up the brew button, /metrics or OTA for everyone else. Supports keep-alive,
+pipelined requests (answered in order), per-connection read/idle/write timeouts, static bodies
+served straight from flash, chunked streaming bodies and Server-Sent Event streams.
+Admission control keeps a flood of requests from starving loop(): an optional hook can refuse a
+request before its handler runs (429 + Retry-After), poll() dispatches at most maxDispatchPerPoll
+requests and sheds the newest buffered ones beyond maxQueued (503 + Retry-After), and one client
+address may hold at most maxConnsPerIp of the pool (its own idle keep-alive connections are
+recycled first, so a browser is only refused when all of its connections are busy).
+Plain BSD sockets only, so the same code runs on lwIP and on a Linux host.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#ifdef ARDUINO
+#include <lwip/sockets.h>
+#else
+#include <sys/select.h>
+#endif
+
+/*------- Server limits -------*/
+const uint8_t HTTP_MAX_CONNS = 6;             // Connection pool size (lwIP has ~10 sockets in total)
+const uint8_t HTTP_LISTEN_BACKLOG = 8;        // Pending connections queued while the pool is busy
+const uint8_t HTTP_MAX_ROUTES = 16;           // Route table size
+const uint8_t HTTP_MAX_HEADERS = 12;          // Request headers kept per request
+const size_t HTTP_RX_BUF = 2048;              // Per-connection request buffer (headers + body)
+const size_t HTTP_TX_BUF = 1024;              // Per-connection response buffer
+const size_t HTTP_EXTRA_HEADERS = 256;        // Handler-added response headers per response
+const uint32_t HTTP_READ_TIMEOUT_MS = 3000;   // Max time to receive a started request
+const uint32_t HTTP_IDLE_TIMEOUT_MS = 5000;   // Keep-alive idle time before closing
+const uint32_t HTTP_WRITE_TIMEOUT_MS = 5000;  // Max time without send progress
+const uint16_t HTTP_MAX_KEEPALIVE_REQS = 100; // Requests per connection before closing it
+
+enum class HttpMethod : uint8_t
+{
+    Get = 1,
+    Head = 2,
+    Post = 4,
+    Put = 8,
+    Delete = 16,
+    Other = 32,
+};
+const uint8_t HTTP_ANY = 0xFF; // Route method mask matching every method
+
+struct HttpHeader
+{
+    const char *name;  // Header name as sent by the client
+    const char *value; // Header value with surrounding spaces trimmed
+};
+
+// Parsed request - all pointers reference the connection buffer and are valid only inside the handler
+struct HttpRequest
+{
+    HttpMethod method;                    // Request method
+    const char *path;                     // Path without query string
+    const char *query;                    // Raw query string ("" if none)
+    const uint8_t *body;                  // Request body (nullptr if none)
+    size_t bodyLen;                       // Request body length
+    uint32_t clientIp;                    // Peer IPv4 address (network byte order)
+    HttpHeader headers[HTTP_MAX_HEADERS]; // Received headers
+    uint8_t headerCount;                  // Number of valid entries in headers
+
+    const char *header(const char *name) const;                 // Case-insensitive lookup, nullptr if absent
+    bool arg(const char *name, char *out, size_t outLen) const; // URL-decoded query/form argument
+    long argInt(const char *name, long fallback) const;         // Integer argument or fallback
+    bool hasArg(const char *name) const;                        // Argument present in query or form body
+};
+
+// Per-stream state handed to a chunked body producer
+struct HttpStreamState
+{
+    void *ctx;       // Producer context
+    uint32_t cursor; // Producer-owned position
+    uint32_t arg0;   // Producer-owned parameters
+    uint32_t arg1;
+};
+
+// Fill buf with the next part of a chunked body, return 0 when the body is complete or
+// HTTP_STREAM_ABORT to drop the connection without the final chunk (the client sees a failed transfer)
+typedef size_t (*HttpStreamFn)(HttpStreamState &state, char *buf, size_t cap);
+const size_t HTTP_STREAM_ABORT = (size_t)-1;
+
+class HttpServer;
+struct HttpConn;
+
+// Response writer bound to one connection for the duration of a handler call
+class HttpResponse
+{
+public:
+    void header(const char *name, const char *value);                                         // Add a response header
+    void send(int code, const char *type, const char *body);                                  // Send a NUL-terminated body
+    void send(int code, const char *type, const void *body, size_t len);                      // Send a copied body
+    void sendStatic(int code, const char *type, const void *body, size_t len);                // Send a body that outlives the response
+    void sendChunked(int code, const char *type, HttpStreamFn fn, const HttpStreamState &st); // Stream a chunked body
+    bool beginEventStream(const char *hello = nullptr);                                       // Turn the connection into an SSE stream
+    bool sent() const { return done; }                                                       // Handler already responded
+
+private:
+    friend class HttpServer;
+    HttpResponse(HttpServer &server, HttpConn &conn, bool head) : srv(server), c(conn), headOnly(head) {}
+    bool writeHead(int code, const char *type, long contentLength, bool chunked);
+    HttpServer &srv;
+    HttpConn &c;
+    bool headOnly;
+    bool done = false;
+    char extra[HTTP_EXTRA_HEADERS];
+    size_t extraLen = 0;
+};
+
+typedef void (*HttpHandler)(const HttpRequest &req, HttpResponse &res);
+
+// Admission hook - 0 lets the request through, otherwise the status to refuse it with (429/503)
+// and the Retry-After seconds to send
+typedef int (*HttpAdmitFn)(const HttpRequest &req, uint32_t &retryAfterS);
+
+struct HttpServerStats
+{
+    uint32_t accepted;        // Connections accepted
+    uint32_t requests;        // Requests dispatched to handlers
+    uint32_t keepAliveReuse;  // Requests served on an already-used connection
+    uint32_t timeouts;        // Connections closed by read/idle/write timeouts
+    uint32_t evictedIdle;     // Idle keep-alive connections closed to make room
+    uint32_t badRequests;     // Malformed or oversized requests
+    uint32_t eventDrops;      // Event frames skipped because a subscriber was backed up
+    uint32_t rateLimited;     // Requests refused 429 by the admission hook
+    uint32_t shed;            // Requests or connections refused 503 (queue full, per-address cap, hook)
+    uint8_t queuePeak;        // Most complete requests left waiting after a poll
+    uint32_t firstResponseMs; // httpNowMs() when the first response was queued (0 = none yet)
+};
+
+// Connection slot - rx holds the incoming request(s), tx the pending response bytes
+struct HttpConn
+{
+    int fd = -1;                         // Socket (-1 = free slot)
+    uint32_t ip = 0;                     // Peer IPv4 address (network byte order)
+    uint32_t lastMs = 0;                 // Last read/write progress
+    uint32_t startMs = 0;                // Start of the request being received
+    uint16_t served = 0;                 // Requests answered on this connection
+    bool keepAlive = true;               // Keep the connection after the current response
+    bool closeAfter = false;             // Close once tx is drained
+    bool eventStream = false;            // Long-lived SSE stream
+    uint8_t eventDrops = 0;              // Consecutive frames skipped for this subscriber
+    size_t rxLen = 0;                    // Bytes buffered in rx
+    size_t txLen = 0;                    // Bytes buffered in tx
+    size_t txOff = 0;                    // Bytes of tx already sent
+    const uint8_t *staticBody = nullptr; // Body sent after tx drains (flash/const data)
+    size_t staticLen = 0;                // Remaining static body bytes
+    HttpStreamFn streamFn = nullptr;     // Chunked body producer
+    HttpStreamState stream = {};         // Producer state
+    bool streamDone = false;             // Final chunk queued
+    char rx[HTTP_RX_BUF];
+    char tx[HTTP_TX_BUF];
+};
+
+class HttpServer
+{
+public:
+    explicit HttpServer(uint16_t port) : port(port) {}
+    bool begin();                                                    // Open the listening socket
+    bool on(const char *path, uint8_t methods, HttpHandler handler); // Register an exact-path route, false if the table is full
+    bool on(const char *path, HttpHandler handler) { return on(path, HTTP_ANY, handler); }
+    void onNotFound(HttpHandler handler) { notFound = handler; }
+    void onAdmit(HttpAdmitFn fn) { admit = fn; }        // Admission hook, nullptr admits everything
+    void poll(uint32_t waitMs = 0);                     // Service sockets, waiting up to waitMs for activity
+    bool wait(uint32_t waitMs);                         // Block until a socket needs service (true) or waitMs passes
+    uint8_t eventSubscribers() const;                   // Open SSE streams
+    void broadcastEvent(const char *frame, size_t len); // Queue one frame to every SSE stream
+    uint8_t activeConnections() const;                  // Open connections
+    const HttpServerStats &stats() const { return st; }
+
+    uint8_t maxEventStreams = 3;                 // SSE streams allowed in the pool
+    uint8_t maxEventDrops = 8;                   // Consecutive skipped frames before a subscriber is evicted
+    uint8_t maxDispatchPerPoll = HTTP_MAX_CONNS; // Requests handled per poll(), the rest wait for the next one
+    uint8_t maxQueued = HTTP_MAX_CONNS;          // Complete requests allowed to wait, newer ones get 503
+    uint8_t maxConnsPerIp = HTTP_MAX_CONNS;      // Pool slots one client address may hold
+
+private:
+    friend class HttpResponse;
+    struct Route
+    {
+        const char *path;
+        uint8_t methods;
+        HttpHandler handler;
+    };
+    int watchSet(fd_set &rd, fd_set &wr, bool &canAccept) const;
+    void acceptClients(uint32_t now);
+    void readConn(HttpConn &c, uint32_t now);
+    void processConn(HttpConn &c, uint32_t now);
+    bool handleRequest(HttpConn &c, size_t headerLen, size_t bodyLen);
+    void flushConn(HttpConn &c, uint32_t now);
+    void closeConn(HttpConn &c);
+    void replyError(HttpConn &c, int code, const char *msg);
+    void reject(HttpConn &c, int code, uint32_t retryAfterS);
+    bool requestWaiting(const HttpConn &c) const;
+    void shedQueue(uint32_t now);
+    bool responsePending(const HttpConn &c) const;
+    bool idleKeepAlive(const HttpConn &c) const;
+    uint16_t port;
+    int listenFd = -1;
+    Route routes[HTTP_MAX_ROUTES];
+    uint8_t routeCount = 0;
+    HttpHandler notFound = nullptr;
+    HttpAdmitFn admit = nullptr;
+    uint8_t budget = 0;   // Dispatches left in the current poll()
+    uint8_t nextConn = 0; // Pool slot served first by the next poll()
+    uint8_t waiting = 0;  // Complete requests left buffered by the last poll()
+    HttpConn conns[HTTP_MAX_CONNS];
+    HttpServerStats st = {};
+};
+
+const char *httpStatusText(int code); // Reason phrase for a status code
+uint32_t httpNowMs();                 // Millisecond clock used for timeouts
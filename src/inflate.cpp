@@ -0,0 +1,432 @@
+#include "inflate.h"
+
+#include <string.h>
+
+static const uint16_t LEN_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t LEN_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t DIST_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                       257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t DIST_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+static const uint8_t CLEN_ORDER[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+static const uint16_t WINDOW_SIZE = 1 << INFLATE_WINDOW_BITS;
+static const uint32_t ADLER_MOD = 65521;
+
+void Inflater::begin(InflateSink s, void *ctx)
+{
+    inLen = inPos = 0;
+    bitBuf = 0;
+    bitCount = 0;
+    winPos = flushPos = 0;
+    stage = ZHEADER;
+    lastBlock = false;
+    storedLeft = 0;
+    adlerA = 1;
+    adlerB = 0;
+    inTotal = outTotal = 0;
+    sink = s;
+    sinkCtx = ctx;
+    err = "";
+}
+
+InflateStatus Inflater::feed(const uint8_t *data, size_t len, bool final)
+{
+    if (stage == DONE)
+        return len ? fail("data after end of stream") : InflateStatus::Done;
+    if (stage == FAILED)
+        return InflateStatus::Error;
+    if (len > INFLATE_MAX_FEED)
+        return fail("piece too large");
+    memmove(in, in + inPos, inLen - inPos); // Carried tail of an unfinished unit first
+    inLen -= inPos;
+    inPos = 0;
+    memcpy(in + inLen, data, len);
+    inLen += len;
+    inTotal += len;
+
+    for (;;)
+    {
+        int r = 1;
+        Mark m = mark(); // Start of the unit - stages rewind here (or to a later unit) when input runs out
+        switch (stage)
+        {
+        case ZHEADER:
+            if (!need(16))
+            {
+                r = 0;
+                break;
+            }
+            {
+                uint8_t cmf = (uint8_t)take(8);
+                uint8_t flg = (uint8_t)take(8);
+                if ((cmf & 0x0F) != 8 || ((cmf << 8) | flg) % 31 != 0)
+                    return fail("not a zlib stream");
+                if ((cmf >> 4) + 8 > INFLATE_WINDOW_BITS)
+                    return fail("window too large (compress with wbits <= 12)");
+                if (flg & 0x20)
+                    return fail("preset dictionary not supported");
+            }
+            stage = BLOCK_HEADER;
+            break;
+        case BLOCK_HEADER:
+            r = blockHeader();
+            if (r == 0)
+                rewind(m); // Header bits are only consumed once the whole header is there
+            break;
+        case STORED:
+            while (storedLeft && need(8) && stage != FAILED)
+            { // Every byte is its own unit
+                put((uint8_t)take(8));
+                storedLeft--;
+            }
+            if (stage == FAILED)
+                r = -1;
+            else if (storedLeft)
+                r = 0;
+            else
+                stage = lastBlock ? TRAILER : BLOCK_HEADER;
+            break;
+        case HUFFMAN:
+            r = huffmanBlock();
+            if (r == 1)
+                stage = lastBlock ? TRAILER : BLOCK_HEADER;
+            break;
+        case TRAILER:
+            take(bitCount & 7); // Trailer starts on a byte boundary
+            if (!need(32))
+            {
+                r = 0;
+                break;
+            }
+            {
+                uint32_t hi = take(16);
+                uint32_t lo = take(16);
+                // Bytes arrive LSB first - swap each 16-bit half back into big-endian order
+                uint32_t expect = ((hi & 0xFF) << 24) | ((hi >> 8) << 16) | ((lo & 0xFF) << 8) | (lo >> 8);
+                if (!flush())
+                    return fail("sink rejected data");
+                if (((adlerB << 16) | adlerA) != expect)
+                    return fail("Adler-32 mismatch");
+            }
+            stage = DONE;
+            return inPos < inLen || bitCount >= 8 ? fail("data after end of stream") : InflateStatus::Done;
+        default:
+            return InflateStatus::Error;
+        }
+        if (r < 0)
+            return InflateStatus::Error;
+        if (r == 0)
+            break; // Out of input - the unread tail is carried to the next piece
+    }
+    if (!flush())
+        return fail("sink rejected data");
+    if (inLen - inPos > INFLATE_CARRY)
+        return fail("stream unit larger than the carry buffer");
+    if (final)
+        return fail("truncated stream");
+    return InflateStatus::More;
+}
+
+bool Inflater::need(uint8_t n)
+{
+    while (bitCount < n)
+    {
+        if (inPos >= inLen)
+            return false;
+        bitBuf |= (uint32_t)in[inPos++] << bitCount;
+        bitCount += 8;
+    }
+    return true;
+}
+
+uint32_t Inflater::take(uint8_t n)
+{
+    uint32_t v = bitBuf & ((1UL << n) - 1);
+    bitBuf >>= n;
+    bitCount -= n;
+    return v;
+}
+
+void Inflater::rewind(const Mark &m)
+{
+    inPos = m.pos;
+    bitBuf = m.bitBuf;
+    bitCount = m.bitCount;
+}
+
+int Inflater::decode(const Huffman &h)
+{
+    int code = 0, first = 0, index = 0; // Canonical decoding one bit at a time (RFC 1951 3.2.2)
+    for (uint8_t len = 1; len < 16; len++)
+    {
+        if (!need(1))
+            return -1;
+        code |= (int)take(1);
+        int count = h.counts[len];
+        if (code - count < first)
+            return h.symbols[index + (code - first)];
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+    return -2; // Incomplete code and no match
+}
+
+bool Inflater::build(Huffman &h, const uint8_t *lengths, uint16_t n)
+{
+    uint16_t offs[16];
+    memset(h.counts, 0, sizeof(h.counts));
+    for (uint16_t s = 0; s < n; s++)
+        h.counts[lengths[s]]++;
+    h.counts[0] = 0;
+    int left = 1;
+    for (uint8_t len = 1; len < 16; len++)
+    {
+        left = (left << 1) - h.counts[len];
+        if (left < 0)
+            return false; // More codes than bit patterns
+    }
+    offs[1] = 0;
+    for (uint8_t len = 1; len < 15; len++)
+        offs[len + 1] = offs[len] + h.counts[len];
+    for (uint16_t s = 0; s < n; s++)
+        if (lengths[s])
+            h.symbols[offs[lengths[s]]++] = s;
+    return true;
+}
+
+int Inflater::blockHeader()
+{
+    if (!need(3))
+        return 0;
+    lastBlock = take(1) != 0;
+    uint32_t type = take(2);
+    if (type == 0)
+    { // Stored: LEN and NLEN on the next byte boundary
+        take(bitCount & 7);
+        if (!need(16))
+            return 0;
+        uint16_t len = (uint16_t)take(16);
+        if (!need(16))
+            return 0;
+        if ((uint16_t)~take(16) != len)
+        {
+            fail("stored block length check failed");
+            return -1;
+        }
+        storedLeft = len;
+        stage = STORED;
+        return 1;
+    }
+    if (type == 1)
+    { // Fixed codes
+        uint8_t lengths[288];
+        memset(lengths, 8, 144);
+        memset(lengths + 144, 9, 112);
+        memset(lengths + 256, 7, 24);
+        memset(lengths + 280, 8, 8);
+        build(lit, lengths, 288);
+        memset(lengths, 5, 30);
+        build(dist, lengths, 30);
+        stage = HUFFMAN;
+        return 1;
+    }
+    if (type == 2)
+    {
+        int r = dynamicTables();
+        if (r == 1)
+            stage = HUFFMAN;
+        return r;
+    }
+    fail("invalid block type");
+    return -1;
+}
+
+int Inflater::dynamicTables()
+{
+    if (!need(14))
+        return 0;
+    uint16_t nlen = (uint16_t)(take(5) + 257);
+    uint16_t ndist = (uint16_t)(take(5) + 1);
+    uint8_t ncode = (uint8_t)(take(4) + 4);
+    if (nlen > 286 || ndist > 30)
+    {
+        fail("invalid table sizes");
+        return -1;
+    }
+    uint8_t lengths[286 + 30];
+    memset(lengths, 0, 19);
+    for (uint8_t i = 0; i < ncode; i++)
+    {
+        if (!need(3))
+            return 0;
+        lengths[CLEN_ORDER[i]] = (uint8_t)take(3);
+    }
+    Huffman clen;
+    if (!build(clen, lengths, 19))
+    {
+        fail("invalid code length code");
+        return -1;
+    }
+    uint16_t n = 0;
+    while (n < nlen + ndist)
+    {
+        int sym = decode(clen);
+        if (sym == -1)
+            return 0;
+        if (sym < 0)
+        {
+            fail("invalid code length symbol");
+            return -1;
+        }
+        if (sym < 16)
+        {
+            lengths[n++] = (uint8_t)sym;
+            continue;
+        }
+        uint8_t repeat, value = 0;
+        if (sym == 16)
+        {
+            if (n == 0)
+            {
+                fail("repeat with no previous length");
+                return -1;
+            }
+            if (!need(2))
+                return 0;
+            value = lengths[n - 1];
+            repeat = (uint8_t)(3 + take(2));
+        }
+        else if (sym == 17)
+        {
+            if (!need(3))
+                return 0;
+            repeat = (uint8_t)(3 + take(3));
+        }
+        else
+        {
+            if (!need(7))
+                return 0;
+            repeat = (uint8_t)(11 + take(7));
+        }
+        if (n + repeat > nlen + ndist)
+        {
+            fail("code lengths overflow");
+            return -1;
+        }
+        while (repeat--)
+            lengths[n++] = value;
+    }
+    if (lengths[256] == 0)
+    {
+        fail("no end-of-block code");
+        return -1;
+    }
+    if (!build(lit, lengths, nlen) || !build(dist, lengths + nlen, ndist))
+    {
+        fail("over-subscribed code");
+        return -1;
+    }
+    return 1;
+}
+
+int Inflater::huffmanBlock()
+{
+    for (;;)
+    {
+        if (stage == FAILED)
+            return -1; // Sink rejected a flush
+        Mark m = mark(); // One symbol with its extra bits is the unit
+        int sym = decode(lit);
+        if (sym == -1)
+        {
+            rewind(m);
+            return 0;
+        }
+        if (sym < 0)
+        {
+            fail("invalid literal/length code");
+            return -1;
+        }
+        if (sym < 256)
+        {
+            put((uint8_t)sym);
+            continue;
+        }
+        if (sym == 256)
+            return 1; // End of block
+        sym -= 257;
+        if (sym >= 29)
+        {
+            fail("invalid length symbol");
+            return -1;
+        }
+        if (!need(LEN_EXTRA[sym]))
+        {
+            rewind(m);
+            return 0;
+        }
+        uint16_t len = (uint16_t)(LEN_BASE[sym] + take(LEN_EXTRA[sym]));
+        int dsym = decode(dist);
+        if (dsym == -1)
+        {
+            rewind(m);
+            return 0;
+        }
+        if (dsym < 0 || dsym >= 30)
+        {
+            fail("invalid distance code");
+            return -1;
+        }
+        if (!need(DIST_EXTRA[dsym]))
+        {
+            rewind(m);
+            return 0;
+        }
+        uint32_t d = DIST_BASE[dsym] + take(DIST_EXTRA[dsym]);
+        if (d > WINDOW_SIZE || d > outTotal + (winPos - flushPos))
+        {
+            fail("distance beyond the window");
+            return -1;
+        }
+        while (len--)
+            put(window[(winPos - d) & (WINDOW_SIZE - 1)]);
+    }
+}
+
+void Inflater::put(uint8_t b)
+{
+    window[winPos++] = b;
+    if (winPos == WINDOW_SIZE)
+    { // Window full - hand it over before new bytes wrap onto it
+        if (!flush())
+            fail("sink rejected data");
+        winPos = flushPos = 0;
+    }
+}
+
+bool Inflater::flush()
+{
+    if (stage == FAILED)
+        return false;
+    size_t n = winPos - flushPos; // flushPos <= winPos, put() flushes before the window wraps
+    if (!n)
+        return true;
+    const uint8_t *p = window + flushPos;
+    for (size_t i = 0; i < n; i++)
+    { // Adler-32, reduced every byte - the output rate is bounded by the network anyway
+        adlerA = (adlerA + p[i]) % ADLER_MOD;
+        adlerB = (adlerB + adlerA) % ADLER_MOD;
+    }
+    outTotal += n;
+    flushPos = winPos;
+    return sink(sinkCtx, p, n);
+}
+
+InflateStatus Inflater::fail(const char *why)
+{
+    if (stage != FAILED)
+        err = why; // Keep the first reason
+    stage = FAILED;
+    return InflateStatus::Error;
+}
@@ -0,0 +1,100 @@
+/*
+Streaming zlib inflater for Embedded Brew OTA updates.
+
+Decodes a zlib (RFC 1950/1951) stream pushed in arbitrary pieces - each HTTP chunk is fed as it
+arrives and the decoded bytes go straight to a sink (the OTA partition writer). Memory is fixed:
+a 4 KB history window, one feed buffer and the two Huffman tables, no heap. The window is the
+reason streams must be compressed with a reduced window (zlib wbits <= INFLATE_WINDOW_BITS, which
+tools/ota_upload.py does); a stream declaring a larger window is rejected up front.
+
+Decoding is done in small atomic units (a symbol with its extra bits, a block header). When a unit
+runs out of input the reader rewinds to the unit start and keeps the unread tail for the next
+feed, so pieces can be split anywhere. The Adler-32 trailer is checked at the end.
+
+Portable C++ - tools/inflate_check.cpp verifies it on the host against zlib.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+const uint8_t INFLATE_WINDOW_BITS = 12; // Largest accepted zlib window (4 KB)
+const size_t INFLATE_MAX_FEED = 2048;   // Largest piece accepted by one feed()
+const size_t INFLATE_CARRY = 640;       // Unread tail kept between feeds (worst-case dynamic block header)
+
+// Receives decoded bytes in order, returns false to abort decoding
+typedef bool (*InflateSink)(void *ctx, const uint8_t *data, size_t len);
+
+enum class InflateStatus : uint8_t
+{
+    More,  // Piece consumed, stream not finished
+    Done,  // Stream finished and the Adler-32 trailer matched
+    Error, // Corrupt stream, sink failure or misuse - see error()
+};
+
+class Inflater
+{
+public:
+    void begin(InflateSink sink, void *ctx); // Reset for a new stream
+    // Decode the next piece; final marks the last bytes of the stream (a stream that is not done by then fails)
+    InflateStatus feed(const uint8_t *data, size_t len, bool final);
+    uint32_t totalIn() const { return inTotal; }   // Compressed bytes fed
+    uint32_t totalOut() const { return outTotal; } // Decoded bytes handed to the sink
+    const char *error() const { return err; }     // Reason for the last Error ("" if none)
+
+private:
+    enum Stage : uint8_t
+    {
+        ZHEADER,      // Two-byte zlib header
+        BLOCK_HEADER, // Deflate block header (and dynamic tables)
+        STORED,       // Copying an uncompressed block
+        HUFFMAN,      // Decoding literals and matches
+        TRAILER,      // Adler-32 of the decoded data
+        DONE,
+        FAILED
+    };
+    struct Huffman
+    {
+        uint16_t counts[16];   // Codes per bit length
+        uint16_t symbols[288]; // Symbols ordered by code
+    };
+    struct Mark
+    {                    // Reader position to rewind to when a unit runs out of input
+        size_t pos;
+        uint32_t bitBuf;
+        uint8_t bitCount;
+    };
+    bool need(uint8_t n);                                      // Make n bits available, false if the input ran out
+    uint32_t take(uint8_t n);                                  // Consume n bits (need() first)
+    int decode(const Huffman &h);                              // Next symbol, -1 if out of input, -2 if invalid
+    static bool build(Huffman &h, const uint8_t *lengths, uint16_t n); // Canonical code from lengths, false if over-subscribed
+    int blockHeader();                                         // 1 parsed, 0 out of input, -1 failed
+    int dynamicTables();                                       // 1 parsed, 0 out of input, -1 failed
+    int huffmanBlock();                                        // 1 end of block, 0 out of input, -1 failed
+    void put(uint8_t b);                                       // Append one decoded byte to the window
+    bool flush();                                              // Hand the unflushed window span to the sink
+    InflateStatus fail(const char *why);
+    Mark mark() const { return {inPos, bitBuf, bitCount}; }
+    void rewind(const Mark &m);
+
+    uint8_t in[INFLATE_MAX_FEED + INFLATE_CARRY]; // Carried tail + current piece
+    size_t inLen = 0;                             // Valid bytes in in
+    size_t inPos = 0;                             // Next byte to move into bitBuf
+    uint32_t bitBuf = 0;                          // Bits read but not consumed, LSB first
+    uint8_t bitCount = 0;                         // Valid bits in bitBuf
+    uint8_t window[1 << INFLATE_WINDOW_BITS];     // Decoded history for back-references
+    uint16_t winPos = 0;                          // Next write position in window
+    uint16_t flushPos = 0;                        // Start of the span not yet handed to the sink
+    Huffman lit = {};                             // Literal/length code of the current block
+    Huffman dist = {};                            // Distance code of the current block
+    Stage stage = ZHEADER;
+    bool lastBlock = false;   // Current block is the final one
+    uint16_t storedLeft = 0;  // Bytes left in a stored block
+    uint32_t adlerA = 1;      // Adler-32 state of the flushed output
+    uint32_t adlerB = 0;
+    uint32_t inTotal = 0;
+    uint32_t outTotal = 0;
+    InflateSink sink = nullptr;
+    void *sinkCtx = nullptr;
+    const char *err = "";
+};
@@ -0,0 +1,256 @@
+/*
+Zero-allocation JSON writer for Embedded Brew.
+
+Formats directly into a caller-provided buffer: no String temporaries, no heap, no printf for numbers.
+Fixed-point floats take their decimal count as a template parameter so the scale factor is a
+compile-time constant. Writing past the end sets overflow() instead of silently truncating, and the
+buffer always stays NUL-terminated.
+*/
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+class JsonWriter
+{
+public:
+    JsonWriter(char *buf, size_t cap) : buf(buf), cap(cap)
+    {
+        if (cap)
+            buf[0] = '\0';
+    }
+
+    JsonWriter &beginObject() { return open('{'); }
+    JsonWriter &endObject() { return close('}'); }
+    JsonWriter &beginArray() { return open('['); }
+    JsonWriter &endArray() { return close(']'); }
+
+    // Object member name, the next value call writes its value
+    JsonWriter &key(const char *name)
+    {
+        separator();
+        quoted(name);
+        put(':');
+        afterKey = true;
+        return *this;
+    }
+
+    JsonWriter &str(const char *value)
+    {
+        separator();
+        quoted(value);
+        return *this;
+    }
+
+    JsonWriter &boolean(bool value)
+    {
+        separator();
+        raw(value ? "true" : "false");
+        return *this;
+    }
+
+    JsonWriter &null()
+    {
+        separator();
+        raw("null");
+        return *this;
+    }
+
+    JsonWriter &number(uint32_t value)
+    {
+        separator();
+        digits(value);
+        return *this;
+    }
+
+    // 64-bit counter (sums that outgrow uint32_t)
+    JsonWriter &number64(uint64_t value)
+    {
+        separator();
+        digits(value);
+        return *this;
+    }
+
+    JsonWriter &integer(int32_t value)
+    {
+        separator();
+        if (value < 0)
+        {
+            put('-');
+            digits((uint32_t)(-(int64_t)value));
+        }
+        else
+            digits((uint32_t)value);
+        return *this;
+    }
+
+    // Fixed-point number with Decimals digits after the point, NAN/inf (and values past uint32) become
+    // null. Single precision only - the C3 has no FPU and double would be soft-float on every /metrics,
+    // SSE and batch row. The whole part is split off first (exact), so only the fraction is scaled
+    // and rounded (half away from zero) - as precise as rounding the exact product in double
+    template <uint8_t Decimals>
+    JsonWriter &fixed(float value)
+    {
+        float mag = fabsf(value);
+        if (!(mag < 4294967040.0f)) // Largest float below 2^32, also catches NAN/inf
+            return null();
+        separator();
+        constexpr uint32_t scale = pow10(Decimals);
+        uint32_t whole = (uint32_t)mag;
+        uint32_t frac = (uint32_t)lroundf((mag - (float)whole) * scale); // mag - whole is exact
+        if (frac >= scale)
+        { // Fraction rounded up to the next whole number
+            whole++;
+            frac -= scale;
+        }
+        if (value < 0 && (whole || frac))
+            put('-');
+        digits(whole);
+        if (Decimals)
+        {
+            put('.');
+            for (uint32_t div = scale / 10; div; div /= 10)
+            {
+                put((char)('0' + frac / div)); // Leading zeros of the fraction included
+                frac %= div;
+            }
+        }
+        return *this;
+    }
+
+    // Uptime as "<h>h <m>m <s>s", the format the UI has always shown
+    JsonWriter &uptime(uint32_t ms)
+    {
+        separator();
+        uint32_t s = ms / 1000UL;
+        put('"');
+        digits(s / 3600UL);
+        raw("h ");
+        digits((s / 60UL) % 60UL);
+        raw("m ");
+        digits(s % 60UL);
+        raw("s\"");
+        return *this;
+    }
+
+    // Dotted IPv4 string from its four octets
+    JsonWriter &ipv4(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+    {
+        separator();
+        put('"');
+        digits(a);
+        put('.');
+        digits(b);
+        put('.');
+        digits(c);
+        put('.');
+        digits(d);
+        put('"');
+        return *this;
+    }
+
+    size_t length() const { return len; }
+    bool overflow() const { return overflowed; }
+    const char *c_str() const { return buf; }
+
+private:
+    static constexpr uint32_t pow10(uint8_t n) { return n ? 10 * pow10(n - 1) : 1; }
+
+    void put(char ch)
+    {
+        if (len + 1 < cap)
+        {
+            buf[len++] = ch;
+            buf[len] = '\0';
+        }
+        else
+            overflowed = true;
+    }
+
+    void raw(const char *s)
+    {
+        while (*s)
+            put(*s++);
+    }
+
+    template <typename T>
+    void digits(T v)
+    {
+        char tmp[20];
+        uint8_t n = 0;
+        do
+        {
+            tmp[n++] = (char)('0' + v % 10);
+            v /= 10;
+        } while (v);
+        while (n)
+            put(tmp[--n]);
+    }
+
+    void quoted(const char *s)
+    {
+        static const char HEX[] = "0123456789abcdef";
+        put('"');
+        for (; *s; s++)
+        {
+            unsigned char ch = (unsigned char)*s;
+            if (ch == '"' || ch == '\\')
+            {
+                put('\\');
+                put((char)ch);
+            }
+            else if (ch < 0x20)
+            { // Control characters as \u00XX
+                raw("\\u00");
+                put(HEX[ch >> 4]);
+                put(HEX[ch & 0xF]);
+            }
+            else
+                put((char)ch);
+        }
+        put('"');
+    }
+
+    // Emit the comma between siblings (not after a key or an opening bracket)
+    void separator()
+    {
+        if (afterKey)
+            afterKey = false;
+        else if (depth && (needComma >> (depth - 1)) & 1)
+            put(',');
+        if (depth)
+            needComma |= 1UL << (depth - 1);
+    }
+
+    JsonWriter &open(char ch)
+    {
+        separator();
+        put(ch);
+        if (depth < 32)
+        {
+            depth++;
+            needComma &= ~(1UL << (depth - 1));
+        }
+        else
+            overflowed = true;
+        return *this;
+    }
+
+    JsonWriter &close(char ch)
+    {
+        if (depth)
+            depth--;
+        put(ch);
+        return *this;
+    }
+
+    char *buf;
+    size_t cap;
+    size_t len = 0;
+    bool overflowed = false;
+    bool afterKey = false;
+    uint8_t depth = 0;      // Current nesting depth
+    uint32_t needComma = 0; // Bit per depth: a value was already written at that level
+};
@@ -6,14 +6,29 @@ Firmware: Feb 17 2025 22:14
 Board: ESP32-C3 Dev Module
 */
 
-#include <Adafruit_BMP280.h>
-#include <Adafruit_Sensor.h>
 #include <ElegantOTA.h>
 #include <ESPmDNS.h>
+#include <Preferences.h>
 #include <U8g2lib.h>
 #include <WebServer.h>
 #include <WiFi.h>
 #include <Wire.h>
+#include <esp_timer.h>
+#include <time.h>
+
+#include "admission.h"        // Per-client and per-route token buckets in front of the handlers
+#include "bmp280.h"           // Forced-mode BMP280 driver with integer compensation
+#include "brew_detector.h"    // Brew phase inferred from the temperature stream
+#include "history.h"          // Delta-encoded telemetry ring buffer
+#include "http_server.h"      // Non-blocking HTTP/1.1 server
+#include "json_writer.h"      // Zero-allocation JSON formatting
+#include "metrics_store.h"    // /metrics values, change sequence and recent readings
+#include "ota_receiver.h"     // Compressed, resumable OTA uploads
+#include "perf.h"             // Latency histograms for /debug/perf (-DBREW_PERF=0 strips them)
+#include "power.h"            // CPU clock scaling, light sleep and power-state accounting
+#include "scheduler.h"        // Min-heap deadline scheduler for every timed job
+#include "telemetry_beacon.h" // UDP multicast telemetry datagrams
+#include "ui_index.h"         // Gzip-compressed static UI (generated by tools/embed_ui.py)
 
 /*------- Global Variable Config -------*/
 // Networking config
@@ -23,24 +38,193 @@ const char *AP_SSID = "smart_coffee";               // SAP SSID (SAP mode)
 const char *AP_PASS = "11111111";                   // SAP password
 const char *HOSTNAME = "brew";                      // mDNS hostname -> http://brew.local/
 const wifi_power_t WIFI_TX_POWER = WIFI_POWER_5dBm; // Set radio TX power 5 dBm
-bool clientMode = false;                            // Wi-Fi operating mode variable
-WebServer server(80);                               // HTTP server on port 80
+bool clientMode = false;                            // STA link up (set by updateWifi)
+#ifndef BREW_HTTP_PORT
+#define BREW_HTTP_PORT 80 // Main server port - the host build (host/) sets its own
+#endif
+HttpServer server(BREW_HTTP_PORT);                  // Non-blocking HTTP server on port 80
+const uint16_t OTA_PORT = 8080;                     // ElegantOTA keeps its own blocking WebServer
+WebServer otaServer(OTA_PORT);                      // OTA-only server, /update on port 80 redirects here
+OtaReceiver ota;                                    // Compressed, chunked OTA on port 80 (tools/ota_upload.py)
+const uint32_t OTA_REBOOT_DELAY_MS = 1000;          // Lets the commit response reach the client before restarting
+// Connectivity config (STA comes up in the background while HTTP is already serving)
+const uint32_t WIFI_FAST_TIMEOUT_MS = 4000;     // Cached BSSID/channel/IP attempt before a full scan + DHCP
+const uint32_t WIFI_JOIN_TIMEOUT_MS = 10000;    // Full scan + DHCP attempt before starting over
+const uint32_t WIFI_AP_FALLBACK_MS = 15000;     // Bring up the AP alongside STA after this long without a link
+const uint32_t WIFI_STA_WINDOW_MS = 60000;      // Give up on STA (AP only) after this long
+const uint32_t WIFI_RETRY_INTERVAL_MS = 300000; // Re-attempt STA from AP-only mode every 5 mins
+const uint32_t WIFI_RETRY_WINDOW_MS = 20000;    // Length of each re-attempt (AP stays up)
+const uint32_t WIFI_STEP_MS = 250;              // State machine step while joining
+const uint32_t WIFI_IDLE_STEP_MS = 1000;        // State machine step while connected or AP only
+enum NetState : uint8_t
+{                     // Connectivity state machine stepped by the scheduler
+    NET_FAST_CONNECT, // Joining the cached BSSID/channel with the cached IP
+    NET_CONNECTING,   // Full scan + DHCP
+    NET_CONNECTED,    // STA link up
+    NET_AP_ONLY       // STA given up until the next retry
+};
+struct NetCache
+{                     // Last good STA connection, persisted in NVS
+    uint8_t bssid[6]; // Access point MAC
+    uint8_t channel;  // Primary channel (0 = no cache)
+    uint32_t ip;      // Addresses from the last DHCP lease (network byte order)
+    uint32_t gateway;
+    uint32_t mask;
+    uint32_t dns;
+};
+NetState netState = NET_FAST_CONNECT; // Current connectivity state
+NetCache netCache;                    // Loaded from NVS in beginWifi()
+Preferences netPrefs;                 // NVS namespace holding netCache
+bool apActive = false;                // Fallback access point running
+uint32_t netStateMs = 0;              // Time the current state was entered
+uint32_t netAttemptMs = 0;            // Start of the current STA attempt window
+uint32_t netWindowMs = 0;             // Length of the current STA attempt window
+uint32_t netReconnects = 0;           // STA link losses since boot
+bool bootTimingLogged = false;        // Time-to-first-HTTP-response already logged
+// Admission config (keeps a runaway client from starving loop(), see src/admission.h)
+const AdmitLimit ADMIT_CLIENT = {40, 1200}; // Per address: bursts of 40, then 20 requests/s
+const AdmitLimit ADMIT_PRESS = {5, 20};     // /press per address: 5 back-to-back, then one per 3s
+const uint8_t HTTP_DISPATCH_PER_POLL = 4;   // Handlers run per loop() pass before the scheduler gets its turn
+const uint8_t HTTP_QUEUE_MAX = 2;           // Buffered requests beyond the dispatch budget before shedding 503
+const uint8_t HTTP_CONNS_PER_IP = 4;        // Pool slots one address may hold (of HTTP_MAX_CONNS)
+Admission admission;                        // Token buckets consulted by admitRequest()
+// Event stream config (Server-Sent Events at /events)
+const uint8_t SSE_MAX_CLIENTS = 3;       // Max concurrent /events subscribers (share the HTTP pool)
+const uint8_t SSE_MAX_DROPS = 8;         // Consecutive dropped frames before a slow client is evicted
+const uint32_t SSE_KEEPALIVE_MS = 15000; // Comment ping interval for idle streams - 15s
+uint32_t sseSampleSeq = 0;               // Snapshot sample count of the last pushed frame
+bool sseBrewOn = false;                  // Brew state of the last pushed frame
+uint32_t sseLastSendMs = 0;              // Time of the last frame or keepalive
 // Relay config (coffee pot on/off)
-const int RELAY_PIN = 2; // GPIO pin 2
+const int RELAY_PIN = 2;                              // GPIO pin 2
+const uint32_t PRESS_MS = 250;                        // Relay close duration per press - 250ms
+const uint32_t PRESS_GAP_MS = 250;                    // Relay release time between presses of a pattern
+const uint8_t PRESS_MAX_COUNT = 3;                    // Longest accepted multi-press pattern
+esp_timer_handle_t pressTimer = nullptr;              // One-shot timer driving relay edges
+portMUX_TYPE pressMux = portMUX_INITIALIZER_UNLOCKED; // Guards press state between loop and timer task
+volatile uint8_t pressEdgesLeft = 0;                  // Relay edges left in the active pattern (0 = idle)
+volatile bool relayClosed = false;                    // Current relay state (true = button held)
+const uint32_t PRESS_DEBOUNCE_MS = 2000;              // Quiet time after a client's accepted press before its next one
+const uint8_t PRESS_CLIENTS = 4;                      // Client addresses debounced separately
+const uint8_t PRESS_KEYS = 4;                         // Idempotency keys remembered for /press
+const uint32_t PRESS_KEY_TTL_MS = 600000;             // How long a key answers as already done - 10 mins
+struct PressKey
+{                  // Recently accepted /press idempotency key
+    uint32_t hash; // FNV-1a of the key (0 = empty slot)
+    uint32_t ms;   // Time the press was accepted
+};
+PressKey pressKeys[PRESS_KEYS] = {};                  // Ring of accepted keys
+uint8_t pressKeyNext = 0;                             // Next ring slot to overwrite
+struct PressClient
+{                  // Last accepted press of one client address
+    uint32_t ip;   // Client IPv4 address (0 = empty slot)
+    uint32_t ms;   // Time the press was accepted
+};
+PressClient pressClients[PRESS_CLIENTS] = {};         // Recycles the longest-idle address
+uint32_t pressRefused = 0;                            // Presses refused as bounces or answered from a repeated key
 // Sensor config
-Adafruit_BMP280 bmp;       // Reference BMP280 as bmp
+Bmp280 bmp;                // Reference BMP280 as bmp
 bool bmpOk = false;        // Sensor operation variable
 const int I2C_SDA_PIN = 5; // GPIO pin 5 - Sensor data pin
 const int I2C_SCL_PIN = 6; // GPIO pin 6 - Sensor clock pin
-// UI config
-const float TEMP_MIN = 20.0f;                                // Temp gauge range min
-const float TEMP_MAX = 80.0f;                                // Temp gauge range max
-const float PRESS_MIN = 980.0f;                              // Pressure gauge min
-const float PRESS_MAX = 1030.0f;                             // Pressure gauge max
-bool brewOn = false;                                         // Brew state variable
-unsigned long brewOnSince = 0;                               // Brew time variable
+// Sampler config (scheduled forced-mode conversions, HTTP handlers only read the snapshot)
+const uint32_t SAMPLE_INTERVAL_MS = 1000; // Sensor sample period - 1s
+struct SensorSnapshot
+{                        // Latest sensor sample published by publishSample()
+    float tempC;         // Temperature in C (NAN if unavailable)
+    float pressHpa;      // Pressure in hPa (NAN if unavailable)
+    uint32_t sampleMs;   // millis() timestamp of the sample
+    uint32_t samples;    // Total samples taken since boot
+    uint32_t readErrors; // Total failed sensor reads since boot
+};
+SensorSnapshot snap = {NAN, NAN, 0, 0, 0}; // Snapshot storage - loop() context only, no locking needed
+// Metrics config (/metrics and /metrics/batch as JSON or CBOR, ?since=<seq> returns only changed fields)
+enum MetricId : uint8_t
+{                        // Fields of the /metrics object, in output order
+    MET_UPTIME,          // Formatted uptime (ms in CBOR)
+    MET_TEMP_C,          // Temperature in C
+    MET_PRESSURE_HPA,    // Pressure in hPa
+    MET_SENSOR_OK,       // BMP280 found at boot
+    MET_BREW_ON,         // Brew state
+    MET_PHASE,           // Detected brew phase
+    MET_BREW_AT,         // Scheduled start "HH:MM"
+    MET_BREW_DAILY,      // Schedule repeats daily
+    MET_SAMPLE_AGE_MS,   // Age of the latest reading
+    MET_SAMPLES,         // Readings since boot
+    MET_READ_ERRORS,     // Failed readings since boot
+    MET_WIFI_MODE,       // STA, AP or both
+    MET_NETWORK,         // SSID in use
+    MET_IP,              // Address of the active interface
+    MET_WIFI_RECONNECTS, // STA link losses since boot
+    MET_BOOT_TO_HTTP_MS, // Boot to first HTTP response
+    MET_HTTP_LIMITED,    // Requests refused 429 by admission control
+    MET_HTTP_SHED,       // Requests or connections refused 503
+    MET_PRESS_REFUSED,   // /press bounces and repeated idempotency keys
+    MET_COUNT
+};
+const MetricField METRIC_FIELDS[MET_COUNT] = {
+    {"uptime", true},           // Volatile: sent with every delta, a new value alone is not a change
+    {"temp_c", false},
+    {"pressure_hpa", false},
+    {"sensor_ok", false},
+    {"brew_on", false},
+    {"phase", false},
+    {"brew_at", false},
+    {"brew_daily", false},
+    {"sample_age_ms", true},
+    {"samples", true},
+    {"read_errors", false},
+    {"wifi_mode", false},
+    {"network", false},
+    {"ip", false},
+    {"wifi_reconnects", false},
+    {"boot_to_http_ms", false},
+    {"http_limited", false},
+    {"http_shed", false},
+    {"press_refused", false},
+};
+MetricsTable metrics(METRIC_FIELDS, MET_COUNT); // Refreshed by refreshMetrics() before every encode
+RecentSamples recent;                           // Last readings at full rate for /metrics/batch
+// History config (compact on-device telemetry log served at /history)
+const uint32_t HISTORY_INTERVAL_MS = 10000; // History sample period - 10s (~3.5 h in 4 KB)
+const uint8_t HISTORY_ROWS_PER_CHUNK = 16;  // Samples decoded per streamed chunk
+TelemetryHistory history;                   // Ring buffer of past samples
+// Beacon config (UDP multicast telemetry for fleet listeners such as tools/brew_aggregator.cpp)
+const uint32_t BEACON_DEFAULT_MS = 5000;       // Default beacon period - 5s
+const uint32_t BEACON_MIN_MS = 100;            // Fastest accepted period
+const uint32_t BEACON_MAX_MS = 65535;          // Slowest accepted period (the datagram carries it in 16 bits)
+TelemetryBeacon beacon;                        // Multicast sender, opened once a link is up
+uint32_t beaconIntervalMs = BEACON_DEFAULT_MS; // Loaded from NVS in loadBeacon() (0 = off)
+uint32_t beaconSeq = 0;                        // Sequence number of the next datagram
+SchedId beaconTask = 0;                        // Periodic sendBeacon() task
+uint8_t deviceId[6] = {0};                     // Wi-Fi MAC, identifies this controller in every datagram
+// Power config (loop() sleeps until a socket or the next deadline needs it)
+const uint32_t POWER_MAX_WAIT_MS = 250; // Longest block in loop() - bounds OTA server (not in our select set) latency
+PowerManager power;                     // Clock scaling + time per power state
+Scheduler scheduler;                    // Sampling, history, pushes, Wi-Fi steps, auto-off, scheduled brew
+// UI config (page markup and gauge ranges live in ui/index.html)
+bool brewOn = false;                                         // Brew state variable (mirrors brewDetector)
 unsigned long bootMillis = 0;                                // Uptime variable
-const unsigned long BREW_AUTO_OFF_MS = 40UL * 60UL * 1000UL; // Brew auto-off variable - 40 mins
+const unsigned long BREW_AUTO_OFF_MS = 40UL * 60UL * 1000UL; // Brew auto-off variable - 40 mins after heating started
+const uint32_t BREW_AUTO_OFF_RECHECK_MS = 10000;             // Re-check interval while the pot has not reached keep-warm
+const uint32_t BREW_CYCLE_END_MS = 300000;                   // Cooled for this long ends the cycle's auto-off - 5 mins
+BrewDetector brewDetector;                                   // Phase from the temperature stream
+SchedId autoOffTask = 0;                                     // Pending auto-off check for the current cycle
+bool autoOffArmed = false;                                   // Current cycle has its deadline (kept through cooled wobbles)
+// Scheduled brew config (wall-clock start time, the clock comes from SNTP over the STA link)
+const char *NTP_SERVER = "pool.ntp.org";    // SNTP server
+const char *TIMEZONE = "UTC0";              // POSIX TZ string, e.g. "CET-1CEST,M3.5.0,M10.5.0/3"
+const time_t TIME_VALID_AFTER = 1700000000; // Epoch seconds below this mean the clock was never set
+struct BrewSchedule
+{                   // Scheduled start, persisted in NVS
+    int16_t minute; // Minutes after local midnight (-1 = none)
+    bool daily;     // Repeat every day instead of once
+};
+BrewSchedule brewSchedule = {-1, false}; // Loaded from NVS in loadBrewSchedule()
+Preferences brewPrefs;                   // NVS namespace holding brewSchedule and the beacon period
+SchedId brewScheduleTask = 0;            // Pending scheduled start (0 until the clock is set)
+bool sntpStarted = false;                // SNTP client running
+bool timeSynced = false;                 // Clock set by SNTP at least once
 // OLED display config
 #define OLED_SDA 5
 #define OLED_SCL 6
@@ -52,24 +236,25 @@ DISP u8g2(U8G2_R0, U8X8_PIN_NONE, OLED_SCL, OLED_SDA);
 void setup()
 {
     // On boot
-    Serial.begin(115200); // Begin serial - 115200 baud rate
-    delay(1200);          // Wait 1200ms
-    Serial.println();     // Print boot message
-    Serial.println("\n[BOOT] Client mode first, AP mode if needed, then OTA & mDNS");
+    Serial.begin(115200); // Begin serial - 115200 baud rate (no boot wait, HTTP comes first)
+    Serial.println("\n[BOOT] HTTP first, STA in the background, AP alongside if needed");
+    power.begin();                        // Frequency scaling / light sleep before anything starts waiting
     bootMillis = millis();                // Get current ms to set bootMillis
+    metrics.begin(esp_random() & 0x3FFFFFFF); // Per-boot seq base - a ?since= from before a reboot gets the full state
     pinMode(RELAY_PIN, OUTPUT);           // Set GPIO pin 2 (relay) to output mode
     digitalWrite(RELAY_PIN, HIGH);        // Set GPIO pin 2 idle state (no press)
+    initPressTimer();                     // Create relay press timer
     Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN); // Initialize inter-integrated circuit (I2C) for BMP 280
     u8g2.begin();                         // Initialize OLED display
     u8g2.setPowerSave(1);                 // Put the OLED to sleep
 
     // Initialize BMP280 temperature and pressure sensor
-    if (bmp.begin(0x76))
+    if (bmp.begin(Wire, 0x76))
     {                 // Try sensor at address 0x76
         bmpOk = true; // Set sensor status bool true
         Serial.println("[BMP280] Sensor detected at 0x76");
     }
-    else if (bmp.begin(0x77))
+    else if (bmp.begin(Wire, 0x77))
     {                 // Try sensor at address 0x77
         bmpOk = true; // Set sensor status bool true
         Serial.println("[BMP280] Sensor detected at 0x77");
@@ -79,17 +264,16 @@ void setup()
         bmpOk = false; // Set sensor status bool false
         Serial.println("[BMP280] NOT FOUND");
     }
+    startSampling(); // Schedule forced-mode conversions
 
-    // Initialize networking
-    if (connectAsClientWithTimeout(60000))
-    {                      // Try connecting to local network for 60 seconds
-        clientMode = true; // Set client mode status bool true
-    }
-    else
-    {                       // Switch to access point mode if local connection fails
-        clientMode = false; // Set client mode status bool false
-        startAccessPoint(); // Start access point mode
-    }
+    // Initialize networking - returns immediately, updateWifi() steps finish the job from the scheduler
+    beginWifi();
+
+    // Periodic jobs - loop() sleeps until the earliest deadline
+    scheduler.every(millis(), HISTORY_INTERVAL_MS, recordHistory); // Telemetry history ring
+    scheduler.every(millis(), SSE_KEEPALIVE_MS, pushEvents);       // Keepalive for idle /events streams
+    loadBrewSchedule();                                            // Armed once SNTP has set the clock
+    loadBeacon();                                                  // Multicast telemetry (sent while a link is up)
 
     // Initialize multicast DNS
     if (MDNS.begin(HOSTNAME))
@@ -102,75 +286,209 @@ void setup()
         Serial.println("[mDNS] Error starting mDNS");
     }
 
-    // Initialize server and setup page routes
-    server.on("/", handleRoot);                  // Page route for root - brew.local/
-    server.on("/press", HTTP_POST, handlePress); // Page route to handle button press/relay operation
-    server.on("/metrics", handleMetrics);        // Page route for ESP32 and sensor metrics
-    server.onNotFound(handleNotFound);           // Page route for 404
-    ElegantOTA.begin(&server);                   // Start OTA service and serve at brew.local/update
-    server.begin();                              // Start server and print message
-    Serial.printf("[HTTP] Server started on port 80\n[OTA] ElegantOTA ready at /update\n");
+    // Initialize server and setup page routes - routed turns false if one does not fit the route table
+    bool routed = true;
+    routed &= server.on("/", (uint8_t)HttpMethod::Get, handleRoot);           // Page route for root - brew.local/
+    routed &= server.on("/press", (uint8_t)HttpMethod::Post, handlePress);    // Page route to handle button press/relay operation
+    routed &= server.on("/metrics", (uint8_t)HttpMethod::Get, handleMetrics); // Page route for ESP32 and sensor metrics
+    routed &= server.on("/metrics/batch", (uint8_t)HttpMethod::Get, handleMetricsBatch); // Page route for metrics plus buffered readings
+    routed &= server.on("/events", (uint8_t)HttpMethod::Get, handleEvents);   // Page route for pushed metrics (Server-Sent Events)
+    routed &= server.on("/history", (uint8_t)HttpMethod::Get, handleHistory); // Page route for streamed telemetry history
+    routed &= server.on("/schedule", (uint8_t)HttpMethod::Get | (uint8_t)HttpMethod::Post, handleSchedule); // Page route for scheduled brewing
+    routed &= server.on("/update", handleUpdateRedirect);                     // Page route forwarding to the OTA server
+    routed &= server.on("/ota/begin", (uint8_t)HttpMethod::Post, handleOtaBegin);   // Page route to start/resume a compressed OTA upload
+    routed &= server.on("/ota/chunk", (uint8_t)HttpMethod::Post, handleOtaChunk);   // Page route for one CRC-checked upload chunk
+    routed &= server.on("/ota/status", (uint8_t)HttpMethod::Get, handleOtaStatus);  // Page route for the upload offset to resume from
+    routed &= server.on("/ota/commit", (uint8_t)HttpMethod::Post, handleOtaCommit); // Page route to verify the image and reboot into it
+    routed &= server.on("/beacon", (uint8_t)HttpMethod::Get | (uint8_t)HttpMethod::Post, handleBeacon); // Page route for the telemetry beacon
+#if BREW_PERF
+    routed &= server.on("/debug/perf", (uint8_t)HttpMethod::Get, handleDebugPerf); // Page route for latency/heap/Wi-Fi instrumentation
+#endif
+    server.onNotFound(handleNotFound);                              // Page route for 404
+    if (!routed)
+        Serial.printf("[HTTP] Route table full (HTTP_MAX_ROUTES %u), later routes answer 404\n", (unsigned)HTTP_MAX_ROUTES);
+    server.maxEventStreams = SSE_MAX_CLIENTS;                       // Leave pool slots for normal requests
+    server.maxEventDrops = SSE_MAX_DROPS;                           // Evict subscribers that stop reading
+    admission.limitClients(ADMIT_CLIENT);                           // Token bucket per client address
+    admission.limitRoute("/press", ADMIT_PRESS);                    // Press bucket per address, on top of the client one
+    admission.exempt("/ota/chunk");                                 // Upload chunks arrive back-to-back by design
+    server.onAdmit(admitRequest);                                   // Buckets are checked before any handler runs
+    server.maxDispatchPerPoll = HTTP_DISPATCH_PER_POLL;             // Bound handler time per loop() pass
+    server.maxQueued = HTTP_QUEUE_MAX;                              // Shed what the next pass cannot take
+    server.maxConnsPerIp = HTTP_CONNS_PER_IP;                       // Keep pool slots for other clients
+    ElegantOTA.begin(&otaServer);                                   // Start OTA service and serve at brew.local:8080/update
+    otaServer.begin();                                              // Start OTA server
+    if (server.begin())
+    { // Start server and print message
+        Serial.printf("[HTTP] Server started on port %u\n[OTA] ElegantOTA ready at :%u/update\n", (unsigned)BREW_HTTP_PORT, OTA_PORT);
+    }
+    else
+    {
+        Serial.printf("[HTTP] Failed to open port %u\n", (unsigned)BREW_HTTP_PORT);
+    }
 }
 
 /*------- Loop Function -------*/
 void loop()
 {
-    server.handleClient(); // Handle web requests and send page responses
-    if (brewOn && brewOnSince > 0)
-    { // Brew timer - Auto off toggle to reset UI state
-        unsigned long now = millis();
-        if (now - brewOnSince > BREW_AUTO_OFF_MS)
-        {                    // Reset UI state 40 minutes after brew start
-            brewOn = false;  // Reset bool
-            brewOnSince = 0; // Reset timer
-            Serial.println("[BREW] Auto UI off after 40-minute timeout");
-        }
-    }
+    power.waitBegin();                                          // CPU idles (or light-sleeps) from here
+    server.wait(scheduler.waitMs(millis(), POWER_MAX_WAIT_MS)); // Block until a socket needs service or a task is due
+    power.waitEnd(server.activeConnections() > 0);              // Full clock only while clients are connected
+    PERF_SCOPE(PERF_LOOP);                                      // Iteration time and stalls (the wait is excluded)
+    server.poll();            // Service HTTP connections without blocking on any of them
+    otaServer.handleClient(); // Handle OTA uploads
+    scheduler.run(millis());  // Sampling, history, event pushes, Wi-Fi steps, auto-off, scheduled brew
+    logBootTiming();          // Report time-to-first-HTTP-response once
 }
 
 /*------- Helper Functions -------*/
 
-// Try to connect in STA mode for 60 seconds, return true on success, false on fail
-bool connectAsClientWithTimeout(uint32_t timeoutMs)
-{
-    Serial.println("[WiFi] Trying STA mode..."); // Print msg to serial
-    WiFi.mode(WIFI_STA);                         // Set Wi-Fi mode: station (client)
-    WiFi.setTxPower(WIFI_TX_POWER);              // Set radio transmit power
-    WiFi.begin(STA_SSID, STA_PASS);              // Start connection with home network SSID and password
-    WiFi.setSleep(true);                         // Allow modem-sleep between packets
-    uint32_t start = millis();                   // Local variable used for 60s counter
-    // While status is not connected, print "." to serial every 0.5s
-    while (WiFi.status() != WL_CONNECTED && (millis() - start) < timeoutMs)
-    {
-        delay(500);
-        Serial.print(".");
-    }
-    // Print new line to serial after timer completes or Wi-Fi connection succeeds
-    Serial.println();
-    // Return true or false based on Wi-Fi connection status
-    if (WiFi.status() == WL_CONNECTED)
-    { // Return true and print serial msg on connection success
-        Serial.printf("[WiFi] Connected to %s. IP: %s\n", STA_SSID, WiFi.localIP().toString().c_str());
-        return true;
+// Load the cached connection and start the first STA attempt - returns immediately
+void beginWifi()
+{
+    memset(&netCache, 0, sizeof(netCache));
+    netPrefs.begin("wifi", false); // NVS namespace for the connection cache
+    if (netPrefs.getBytes("cache", &netCache, sizeof(netCache)) != sizeof(netCache))
+    {                         // No cache yet (or an old layout) - go straight to scan + DHCP
+        netCache.channel = 0; // Channel 0 marks the cache invalid
+    }
+    netAttemptMs = millis();          // Boot attempt window starts now
+    netWindowMs = WIFI_STA_WINDOW_MS; // Same 60 s budget the blocking connect had
+    startSta(netCache.channel != 0);
+    scheduler.after(millis(), WIFI_STEP_MS, updateWifi); // First state machine step
+}
+
+// Start an STA join, either from the cache (known BSSID/channel, cached IP, no scan and no DHCP) or full scan + DHCP
+void startSta(bool useCache)
+{
+    WiFi.mode(apActive ? WIFI_AP_STA : WIFI_STA); // Keep the fallback AP up while retrying
+    WiFi.setTxPower(WIFI_TX_POWER);               // Set radio transmit power
+    WiFi.setSleep(true);                          // Allow modem-sleep between packets
+    WiFi.setAutoReconnect(false);                 // updateWifi() owns retries
+    WiFi.disconnect(false, false);                // Abandon any attempt in progress
+    if (useCache)
+    {
+        Serial.printf("[WiFi] Fast reconnect to %s on channel %u\n", STA_SSID, netCache.channel);
+        WiFi.config(IPAddress(netCache.ip), IPAddress(netCache.gateway), IPAddress(netCache.mask), IPAddress(netCache.dns));
+        WiFi.begin(STA_SSID, STA_PASS, netCache.channel, netCache.bssid);
+        netState = NET_FAST_CONNECT;
     }
     else
     {
-        // Return false on connection fail, print serial msg, disconnect Wi-Fi and erase AP
-        Serial.println("[WiFi] Client mode connection timed out, starting smart_coffee access point.");
-        WiFi.disconnect(true, true);
-        return false;
+        Serial.printf("[WiFi] Connecting to %s (scan + DHCP)\n", STA_SSID);
+        WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE); // Back to DHCP
+        WiFi.begin(STA_SSID, STA_PASS);
+        netState = NET_CONNECTING;
+    }
+    netStateMs = millis();
+}
+
+// Connectivity state machine - one scheduler step, re-arms itself, never blocks
+void updateWifi(void *)
+{
+    uint32_t now = millis();
+    bool linked = WiFi.status() == WL_CONNECTED;
+    switch (netState)
+    {
+    case NET_FAST_CONNECT:
+    case NET_CONNECTING:
+        if (linked)
+        {
+            onStaConnected(now);
+            break;
+        }
+        if (now - netAttemptMs >= netWindowMs)
+        { // Attempt window over - AP only until the next retry
+            Serial.println("[WiFi] STA not reachable, AP only until the next retry");
+            if (!apActive)
+            {
+                startAccessPoint();
+            }
+            WiFi.disconnect(false, false);
+            WiFi.mode(WIFI_AP);
+            netState = NET_AP_ONLY;
+            netStateMs = now;
+            break;
+        }
+        if (!apActive && now - netAttemptMs >= WIFI_AP_FALLBACK_MS)
+        { // AP+STA - the UI is reachable on smart_coffee while STA keeps trying
+            startAccessPoint();
+        }
+        if (now - netStateMs >= (netState == NET_FAST_CONNECT ? WIFI_FAST_TIMEOUT_MS : WIFI_JOIN_TIMEOUT_MS))
+        { // Cache missed (AP moved, channel changed) or the router is still booting - scan + DHCP again
+            startSta(false);
+        }
+        break;
+    case NET_CONNECTED:
+        if (!linked)
+        { // Link lost - the cache was just refreshed, so try it first
+            netReconnects++;
+            clientMode = false;
+            Serial.println("[WiFi] STA link lost, reconnecting");
+            netAttemptMs = now;
+            netWindowMs = WIFI_STA_WINDOW_MS;
+            startSta(netCache.channel != 0);
+        }
+        break;
+    case NET_AP_ONLY:
+        if (now - netStateMs >= WIFI_RETRY_INTERVAL_MS)
+        { // Periodic STA retry, AP clients may see a short hiccup while the radio scans
+            netAttemptMs = now;
+            netWindowMs = WIFI_RETRY_WINDOW_MS;
+            startSta(netCache.channel != 0);
+        }
+        break;
+    }
+    if (clientMode)
+        checkClock(); // Arm the scheduled brew once SNTP has set the clock
+    bool settled = netState == NET_CONNECTED || netState == NET_AP_ONLY;
+    scheduler.after(now, settled ? WIFI_IDLE_STEP_MS : WIFI_STEP_MS, updateWifi);
+}
+
+// STA link is up - drop the fallback AP and refresh the NVS cache
+void onStaConnected(uint32_t now)
+{
+    clientMode = true;
+    netState = NET_CONNECTED;
+    netStateMs = now;
+    Serial.printf("[WiFi] Connected to %s in %lu ms. IP: %s\n", STA_SSID, (unsigned long)(now - netAttemptMs), WiFi.localIP().toString().c_str());
+    if (!sntpStarted)
+    { // Wall clock for scheduled brewing - the SNTP client keeps it synced from here on
+        configTzTime(TIMEZONE, NTP_SERVER);
+        sntpStarted = true;
+    }
+    if (apActive)
+    {
+        WiFi.softAPdisconnect(true); // Stop the AP, radio back to STA only
+        apActive = false;
+        Serial.println("[WiFi] Access point stopped");
+    }
+    NetCache c;
+    memset(&c, 0, sizeof(c));
+    memcpy(c.bssid, WiFi.BSSID(), sizeof(c.bssid));
+    c.channel = (uint8_t)WiFi.channel();
+    c.ip = (uint32_t)WiFi.localIP();
+    c.gateway = (uint32_t)WiFi.gatewayIP();
+    c.mask = (uint32_t)WiFi.subnetMask();
+    c.dns = (uint32_t)WiFi.dnsIP();
+    if (memcmp(&c, &netCache, sizeof(c)) != 0)
+    { // Only write NVS when something changed - spares the flash on every reconnect
+        netCache = c;
+        netPrefs.putBytes("cache", &netCache, sizeof(netCache));
+        Serial.printf("[WiFi] Cached channel %u for fast reconnect\n", netCache.channel);
     }
 }
 
-// Bring up smart_coffee access point on home network connection fail
+// Bring up the smart_coffee access point alongside STA when the home network is slow or absent
 void startAccessPoint()
 {
     Serial.println("[WiFi] Starting smart_coffee access point...");
-    WiFi.mode(WIFI_AP);                      // Set Wi-Fi mode: soft access point
+    WiFi.mode(WIFI_AP_STA);                  // Set Wi-Fi mode: soft access point + station
     bool ok = WiFi.softAP(AP_SSID, AP_PASS); // Bring up access point and return true on success
     WiFi.setTxPower(WIFI_TX_POWER);          // Set radio transmit power
     if (ok)
     {
+        apActive = true;
         Serial.printf("[WiFi] Access point started successfully. IP address: %s\n", WiFi.softAPIP().toString().c_str());
     }
     else
@@ -179,287 +497,975 @@ void startAccessPoint()
     }
 }
 
-// Root page definition
-void handleRoot()
-{
-    // Wi-Fi / status snapshot
-    const char *modeText = clientMode ? "Station (client)" : "Access Point"; // Set Wi-Fi mode text
-    const char *network = clientMode ? STA_SSID : AP_SSID;                   // Get SSID based on Wi-Fi mode
-    IPAddress ip = clientMode ? WiFi.localIP() : WiFi.softAPIP();            // Get IP based on Wi-Fi mode
-    // Sensor snapshot
-    float temp, press;    // Variables for temp and pressure
-    readBmp(temp, press); // Get BMP280 sensor values
-    // Build HTML
-    String html;        // HTML for root page at brew.local/
-    html.reserve(5000); // Prevent fragmentation - speed up page render
-    html = F(
-        "<!doctype html><html lang='en'><head>"
-        "<meta charset='utf-8'>"
-        "<meta name='viewport' content='width=device-width,initial-scale=1'>"
-        "<title>Embedded Brew Control Panel</title>"
-        "<style>"
-        "body{margin:0;font-family:system-ui,-apple-system,Segoe UI,Roboto,sans-serif;"
-        "background:#05060a;color:#e5e7eb;display:flex;justify-content:center;align-items:center;"
-        "min-height:100vh;padding:16px;}"
-        ".card{background:#111827;border-radius:18px;padding:24px 22px 28px;max-width:420px;width:100%;"
-        "box-shadow:0 18px 45px rgba(0,0,0,.45),0 2px 8px rgba(0,0,0,.6);}"
-        "h1{margin:0 0 10px;font-size:1.4rem;color:#f9fafb;text-align:center;}"
-        ".stats{margin-top:4px;margin-bottom:10px;font-size:.9rem;color:#e5e7eb;}"
-        ".stats p{margin:2px 0;}"
-        ".mug-wrap{display:flex;justify-content:center;margin:14px 0 6px;}"
-        ".mug{position:relative;width:80px;height:65px;}"
-        ".mug-body{position:absolute;bottom:0;left:4px;width:70px;height:54px;background:#f9faf5;"
-        "border-radius:16px 16px 18px 18px;}"
-        ".mug-handle{position:absolute;right:-14px;top:14px;width:22px;height:28px;border:4px solid #f9faf5;"
-        "border-left:none;border-radius:0 18px 18px 0;}"
-        ".steam{position:absolute;width:8px;height:22px;border-radius:999px;"
-        "border:2px solid #60a5fa;border-bottom:none;opacity:0;transition:opacity .35s ease-out,transform 1.4s ease-out;}"
-        ".steam.s1{left:18px;top:-20px;transform:translateY(6px);}"
-        ".steam.s2{left:38px;top:-22px;transform:translateY(8px);}"
-        ".mug.on .steam{opacity:1;}"
-        ".mug.on .steam.s1{transform:translateY(0);}"
-        ".mug.on .steam.s2{transform:translateY(0);}"
-        ".gauges{display:flex;justify-content:space-between;margin-top:14px;gap:10px;}"
-        ".gauge{flex:1;text-align:center;font-size:.8rem;}"
-        ".gauge-svg{width:100%;display:block;}"
-        ".g-arc{fill:none;stroke:#374151;stroke-width:6;stroke-linecap:round;}"
-        ".g-tick{stroke:#4b5563;stroke-width:2;stroke-linecap:round;}"
-        ".g-needle{stroke:#e5e7eb;stroke-width:2.2;stroke-linecap:round;"
-        "transform-origin:100px 100px;transform:rotate(-90deg);transition:transform .25s ease-out;}"
-        ".g-center{fill:#111827;stroke:#4b5563;stroke-width:2;}"
-        ".gauge-value{margin-top:6px;font-size:.95rem;color:#f9fafb;}"
-        ".gauge-label{margin-top:0;font-size:.8rem;color:#9ca3af;letter-spacing:.04em;text-transform:uppercase;}"
-        ".sensor-status{margin-top:6px;font-size:.8rem;color:#f97373;text-align:center;}"
-        ".btn-main{display:block;width:100%;margin-top:18px;padding:11px 18px;border-radius:999px;"
-        "border:none;font-weight:600;font-size:.95rem;cursor:pointer;background:#2563eb;color:white;}"
-        ".btn-main:active{transform:translateY(1px);}"
-        ".ota-row{margin-top:8px;font-size:.75rem;color:#9ca3af;text-align:center;}"
-        ".ota-row code{background:#020617;border-radius:6px;padding:1px 4px;font-size:.75rem;}"
-        ".ota-link{display:inline-block;margin-top:4px;font-size:.78rem;color:#60a5fa;text-decoration:none;}"
-        ".ota-link:hover{text-decoration:underline;}"
-        ".link-row{text-align:center;margin-top:6px;font-size:.75rem;}"
-        ".link-row a{color:#60a5fa;text-decoration:none;}"
-        ".link-row a:hover{text-decoration:underline;}"
-        "</style></head><body><main class='card'>"
-        "<h1>Embedded Brew Control Panel</h1>");
-    // Stats block
-    html += "<div class='stats'>"
-            "<p id='uptime'>Uptime: " + uptimeString() + "</p>"
-            "<p>Wi-Fi mode: " + String(modeText) + "</p>"
-            "<p>Network: " + String(network) + "</p>"
-            "<p>IP address: " + ip.toString() + "</p>"
-            "<p>UI page: http://brew.local/</p>"
-            "</div>";
-    // Mug
-    html += "<div class='mug-wrap'><div id='mug' class='mug";
-    if (brewOn)
-        html += " on";
-    html += "'>"
-            "<div class='steam s1'></div>"
-            "<div class='steam s2'></div>"
-            "<div class='mug-body'></div>"
-            "<div class='mug-handle'></div>"
-            "</div></div>";
-    // Gauges wrapper
-    html += "<div class='gauges'>";
-    // Temperature gauge SVG + value
-    html +=
-        "<div class='gauge gauge-temp'>"
-        "<svg class='gauge-svg' viewBox='0 0 200 120'>"
-        "<path class='g-arc' d='M20 100 A80 80 0 0 1 180 100' />"
-        "<g class='g-ticks'>"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' />"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' transform='rotate(-60 100 100)' />"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' transform='rotate(-30 100 100)' />"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' transform='rotate(30 100 100)' />"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' transform='rotate(60 100 100)' />"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' transform='rotate(90 100 100)' />"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' transform='rotate(-90 100 100)' />"
-        "</g>"
-        "<line id='tempNeedle' class='g-needle' x1='100' y1='100' x2='100' y2='28' />"
-        "<circle class='g-center' cx='100' cy='100' r='6' />"
-        "</svg>";
-    if (bmpOk && !isnan(temp))
-    {
-        html += "<div id='tempValue' class='gauge-value'>" + String(temp, 1) + " &deg;C</div>";
+// Human-readable Wi-Fi mode for /metrics
+const char *wifiModeText()
+{
+    if (clientMode)
+    {
+        return "Station (client)";
+    }
+    if (netState == NET_AP_ONLY)
+    {
+        return "Access Point";
+    }
+    return apActive ? "Access Point (connecting)" : "Connecting";
+}
+
+// Log time-to-first-HTTP-response once it is known
+void logBootTiming()
+{
+    if (bootTimingLogged || !server.stats().firstResponseMs)
+    {
+        return;
+    }
+    bootTimingLogged = true;
+    Serial.printf("[BOOT] First HTTP response %lu ms after boot\n", (unsigned long)server.stats().firstResponseMs);
+}
+
+// Root page definition - static gzip shell from flash, dynamic fields are hydrated from /metrics
+void handleRoot(const HttpRequest &req, HttpResponse &res)
+{
+    PERF_SCOPE(PERF_ROOT);
+    res.header("ETag", UI_INDEX_ETAG);       // Strong validator for the embedded page
+    res.header("Cache-Control", "no-cache"); // Always revalidate so an OTA update shows up
+    const char *etag = req.header("If-None-Match");
+    if (etag && strcmp(etag, UI_INDEX_ETAG) == 0)
+    {                                   // Browser copy is current
+        res.send(304, "text/html", ""); // Not modified - headers only
+        return;
+    }
+    res.header("Content-Encoding", "gzip");                                        // Body is pre-compressed
+    res.sendStatic(200, "text/html; charset=utf-8", UI_INDEX_GZ, UI_INDEX_GZ_LEN); // Stream straight from flash
+}
+
+// Schedule a sensor sample every SAMPLE_INTERVAL_MS (snapshot stays NAN if the sensor is missing)
+void startSampling()
+{
+    if (!bmpOk)
+    {
+        Serial.println("[SAMPLER] Sensor not available, sampling not scheduled");
+        return; // Nothing to sample
+    }
+    if (scheduler.every(millis(), SAMPLE_INTERVAL_MS, sampleStart, nullptr, 0))
+    {
+        Serial.printf("[SAMPLER] Sampling BMP280 every %lu ms\n", (unsigned long)SAMPLE_INTERVAL_MS);
     }
     else
     {
-        html += "<div id='tempValue' class='gauge-value'>-- &deg;C</div>";
-    }
-    html += "<div class='gauge-label'>TEMPERATURE</div></div>";
-    // Pressure gauge SVG + value
-    html +=
-        "<div class='gauge gauge-press'>"
-        "<svg class='gauge-svg' viewBox='0 0 200 120'>"
-        "<path class='g-arc' d='M20 100 A80 80 0 0 1 180 100' />"
-        "<g class='g-ticks'>"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' />"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' transform='rotate(-60 100 100)' />"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' transform='rotate(-30 100 100)' />"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' transform='rotate(30 100 100)' />"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' transform='rotate(60 100 100)' />"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' transform='rotate(90 100 100)' />"
-        "<line class='g-tick' x1='100' y1='28' x2='100' y2='36' transform='rotate(-90 100 100)' />"
-        "</g>"
-        "<line id='pressNeedle' class='g-needle' x1='100' y1='100' x2='100' y2='28' />"
-        "<circle class='g-center' cx='100' cy='100' r='6' />"
-        "</svg>";
-    if (bmpOk && !isnan(press))
-    {
-        html += "<div id='pressValue' class='gauge-value'>" + String(press, 1) + " hPa</div>";
+        Serial.println("[SAMPLER] Failed to schedule sampling");
+    }
+}
+
+// Trigger one forced conversion - sampleFetch() collects it once the sensor is done, loop() keeps serving meanwhile
+void sampleStart(void *)
+{
+    Bmp280Preset preset = brewOn ? Bmp280Preset::Brewing : Bmp280Preset::Idle;
+    if (bmp.preset() != preset)
+        bmp.setPreset(preset); // Fast response while brewing, pressure oversampling and light IIR otherwise
+    if (bmp.startConversion())
+    {
+        scheduler.after(millis(), bmp.conversionMs(), sampleFetch);
     }
     else
     {
-        html += "<div id='pressValue' class='gauge-value'>-- hPa</div>";
+        publishSample(NAN, NAN);
     }
-    html += "<div class='gauge-label'>PRESSURE</div></div></div>";
-    // Sensor status line
-    if (!bmpOk)
+}
+
+// Burst-read the finished conversion (integer compensation) and publish it
+void sampleFetch(void *)
+{
+    int32_t centiC; // Temperature in 0.01 C
+    uint32_t paQ8;  // Pressure in Pa * 256
+    if (bmp.fetch(centiC, paQ8))
+    {
+        publishSample(centiC / 100.0f, paQ8 / 25600.0f); // Pa * 256 -> hPa
+    }
+    else
+    {
+        publishSample(NAN, NAN);
+    }
+}
+
+// Store a sample in the snapshot, run it through the phase detector and push it to /events
+void publishSample(float tempC, float pressHpa)
+{
+    PERF_RECORD(PERF_I2C, bmp.lastBusUs()); // Bus time only, the conversion wait is excluded
+    snap.tempC = tempC;
+    snap.pressHpa = pressHpa;
+    snap.sampleMs = millis();
+    snap.samples++;
+    if (isnan(tempC) || isnan(pressHpa))
+        snap.readErrors++;
+    recent.push(snap.sampleMs, tempC, pressHpa); // Kept at full rate for /metrics/batch
+    BrewPhase before = brewDetector.phase();
+    brewDetector.update(snap.sampleMs, tempC);
+    applyBrewPhase(before);
+    pushEvents(nullptr);
+}
+
+// Create the esp_timer that releases/asserts the relay without blocking the server
+void initPressTimer()
+{
+    esp_timer_create_args_t args = {};
+    args.callback = pressTimerCallback; // Runs in the esp_timer task
+    args.name = "press";
+    if (esp_timer_create(&args, &pressTimer) != ESP_OK)
+    {
+        Serial.println("[RELAY] Failed to create press timer");
+    }
+}
+
+// Start a press pattern of count presses, returns false if a pattern is already running
+bool startPress(uint8_t count)
+{
+    if (!pressTimer || count == 0)
+        return false;
+    bool started = false;
+    portENTER_CRITICAL(&pressMux);
+    if (pressEdgesLeft == 0)
+    {                                   // Relay idle - accept the pattern
+        pressEdgesLeft = count * 2 - 1; // Edges still to run after the first press
+        relayClosed = true;             // First press starts now
+        digitalWrite(RELAY_PIN, LOW);   // Set GPIO2 low - simulate physical button press
+        started = true;
+    }
+    portEXIT_CRITICAL(&pressMux);
+    if (started)
+        esp_timer_start_once(pressTimer, (uint64_t)PRESS_MS * 1000ULL); // Schedule the release
+    return started;
+}
+
+// Timer callback - flip the relay and schedule the next edge until the pattern is done
+void pressTimerCallback(void *)
+{
+    uint32_t nextMs = 0; // Delay until the next edge (0 = pattern finished)
+    portENTER_CRITICAL(&pressMux);
+    if (pressEdgesLeft > 0)
+    {
+        relayClosed = !relayClosed;
+        digitalWrite(RELAY_PIN, relayClosed ? LOW : HIGH); // Press or release the button
+        pressEdgesLeft--;
+        if (pressEdgesLeft > 0)
+            nextMs = relayClosed ? PRESS_MS : PRESS_GAP_MS;
+    }
+    portEXIT_CRITICAL(&pressMux);
+    if (nextMs)
+        esp_timer_start_once(pressTimer, (uint64_t)nextMs * 1000ULL);
+}
+
+// FNV-1a hash of an idempotency key, never 0 (0 marks an empty slot)
+uint32_t pressKeyHash(const char *key)
+{
+    uint32_t h = 2166136261UL;
+    for (; *key; key++)
+        h = (h ^ (uint8_t)*key) * 16777619UL;
+    return h ? h : 1;
+}
+
+// Debounce slot of ip, or the slot to recycle for it (an empty one, else the longest since its press) -
+// a recycled slot's press still counts, so more addresses than slots taking turns are debounced too
+PressClient &pressClient(uint32_t ip, uint32_t now)
+{
+    PressClient *oldest = &pressClients[0];
+    for (PressClient &c : pressClients)
+    {
+        if (c.ip == ip)
+            return c;
+        if (oldest->ip && (!c.ip || now - c.ms > now - oldest->ms))
+            oldest = &c;
+    }
+    return *oldest;
+}
+
+// True if the key belongs to a press accepted within PRESS_KEY_TTL_MS
+bool pressKeySeen(uint32_t hash, uint32_t now)
+{
+    for (const PressKey &k : pressKeys)
+    {
+        if (k.hash == hash && now - k.ms < PRESS_KEY_TTL_MS)
+            return true;
+    }
+    return false;
+}
+
+// Toggle relay and UI state - responds immediately, relay timing runs on the press timer
+// Optional ?count=N (1..PRESS_MAX_COUNT) sends a multi-press pattern, e.g. count=2 for a double-press
+// A key (the form's hidden field or an Idempotency-Key header) already used for an accepted press is
+// answered as done without pressing again, so a resubmitted form cannot double-toggle the machine.
+// Presses within PRESS_DEBOUNCE_MS of the same client's last one get 429, overlapping patterns 409
+void handlePress(const HttpRequest &req, HttpResponse &res)
+{
+    PERF_SCOPE(PERF_PRESS);
+    uint32_t now = millis();
+    char key[40] = ""; // Idempotency key, empty if the client sent none
+    const char *keyHeader = req.header("Idempotency-Key");
+    if (keyHeader)
+        strlcpy(key, keyHeader, sizeof(key));
+    else
+        req.arg("key", key, sizeof(key));
+    uint32_t keyHash = key[0] ? pressKeyHash(key) : 0;
+    if (keyHash && pressKeySeen(keyHash, now))
+    { // Same submission again - report the first one's outcome
+        pressRefused++;
+        res.header("Location", "/");
+        res.send(303, "text/plain", "");
+        return;
+    }
+    long count = req.argInt("count", 1); // Presses in this pattern
+    if (count < 1 || count > PRESS_MAX_COUNT)
+    {
+        res.send(400, "text/plain", "Invalid press count");
+        return;
+    }
+    PressClient &client = pressClient(req.clientIp, now);
+    if (client.ip && now - client.ms < PRESS_DEBOUNCE_MS)
+    { // Bounce - a double click, a script repeating itself, or every slot pressed within the window
+        char wait[12];
+        snprintf(wait, sizeof(wait), "%lu", (unsigned long)((PRESS_DEBOUNCE_MS - (now - client.ms) + 999) / 1000));
+        pressRefused++;
+        res.header("Retry-After", wait);
+        res.send(429, "text/plain", "Press too soon after the last one");
+        return;
+    }
+    if (!startPress((uint8_t)count))
+    { // Relay busy with an earlier pattern
+        res.header("Retry-After", "1");
+        res.send(409, "text/plain", "Press already in progress");
+        return;
+    }
+    client = {req.clientIp, now};
+    if (keyHash)
+    {
+        pressKeys[pressKeyNext] = {keyHash, now};
+        pressKeyNext = (pressKeyNext + 1) % PRESS_KEYS;
+    }
+    Serial.printf("[RELAY] Simulating %ld button press(es) of %lu ms\n", count, (unsigned long)PRESS_MS);
+    // UI handling - every press toggles the machine, so only odd patterns change state
+    if (count & 1)
+    { // Optimistic, the detector confirms or reverts it from the temperature
+        BrewPhase before = brewDetector.phase();
+        if (!brewOn)
+            endAutoOffCycle(); // Switching on starts a new cycle with its own deadline
+        brewDetector.notePress(millis(), !brewOn);
+        applyBrewPhase(before);
+    }
+    res.header("Location", "/");       // Refresh page to present updated UI state
+    res.send(303, "text/plain", ""); // Send page refresh request
+}
+
+// Scheduled brewing - GET returns the schedule as JSON, POST at=HH:MM[&daily=1] sets it, an empty at (or cancel=1) clears it
+// Times are local (TIMEZONE); a schedule saved before the first SNTP sync is armed once the clock is set
+void handleSchedule(const HttpRequest &req, HttpResponse &res)
+{
+    if (req.method == HttpMethod::Post)
+    {
+        char at[8] = ""; // "HH:MM" from the form's time input
+        req.arg("at", at, sizeof(at));
+        int hour, minute;
+        char extra;
+        if (req.argInt("cancel", 0) || !at[0])
+        {
+            brewSchedule.minute = -1;
+            Serial.println("[SCHEDULE] Cleared");
+        }
+        else if (sscanf(at, "%d:%d%c", &hour, &minute, &extra) == 2 && hour >= 0 && hour < 24 && minute >= 0 && minute < 60)
+        {
+            brewSchedule.minute = (int16_t)(hour * 60 + minute);
+            brewSchedule.daily = req.argInt("daily", 0) != 0;
+        }
+        else
+        {
+            res.send(400, "text/plain", "Invalid time, expected at=HH:MM");
+            return;
+        }
+        brewPrefs.putBytes("schedule", &brewSchedule, sizeof(brewSchedule)); // Survives a reboot
+        armBrewSchedule();
+        res.header("Location", "/"); // Refresh page to present the schedule
+        res.send(303, "text/plain", "");
+        return;
+    }
+    long wait = brewSchedule.minute >= 0 ? secondsUntil(brewSchedule.minute, 1) : -1;
+    char buf[160];
+    JsonWriter w(buf, sizeof(buf));
+    w.beginObject();
+    writeBrewAt(w.key("at"));
+    w.key("daily").boolean(brewSchedule.minute >= 0 && brewSchedule.daily);
+    w.key("clock_set").boolean(timeSynced);
+    w.key("starts_in_s");
+    if (wait >= 0)
+        w.number((uint32_t)wait);
+    else
+        w.null(); // Nothing scheduled or no wall clock yet
+    w.key("timezone").str(TIMEZONE);
+    w.endObject();
+    res.header("Cache-Control", "no-store");
+    res.send(200, "application/json", buf, w.length());
+}
+
+// Scheduled start as "HH:MM", or null when nothing is scheduled
+void writeBrewAt(JsonWriter &w)
+{
+    char at[6];
+    if (brewAtText(at, sizeof(at)))
+        w.str(at);
+    else
+        w.null();
+}
+
+// Format the scheduled start as "HH:MM" into buf, nullptr when nothing is scheduled
+const char *brewAtText(char *buf, size_t len)
+{
+    if (brewSchedule.minute < 0)
+        return nullptr;
+    unsigned minute = (unsigned)brewSchedule.minute; // 0..1439 once loaded
+    snprintf(buf, len, "%02u:%02u", minute / 60 % 24, minute % 60);
+    return buf;
+}
+
+// Load the current values into the metrics table, returns its change sequence
+uint32_t refreshMetrics()
+{
+    const SensorSnapshot &s = snap;                               // Latest sample - never waits on I2C
+    IPAddress ip = clientMode ? WiFi.localIP() : WiFi.softAPIP(); // Get IP based on Wi-Fi mode
+    uint32_t now = millis();                                      // One timestamp for uptime and sample age
+    char at[6];
+    metrics.uptime(MET_UPTIME, now);
+    metrics.fixed2(MET_TEMP_C, bmpOk ? s.tempC : NAN); // NAN is written as null
+    metrics.fixed2(MET_PRESSURE_HPA, bmpOk ? s.pressHpa : NAN);
+    metrics.boolean(MET_SENSOR_OK, bmpOk);
+    metrics.boolean(MET_BREW_ON, brewOn);
+    metrics.text(MET_PHASE, brewPhaseName(brewDetector.phase()));
+    metrics.text(MET_BREW_AT, brewAtText(at, sizeof(at)));
+    metrics.boolean(MET_BREW_DAILY, brewSchedule.minute >= 0 && brewSchedule.daily);
+    metrics.number(MET_SAMPLE_AGE_MS, s.samples ? now - s.sampleMs : 0);
+    metrics.number(MET_SAMPLES, s.samples);
+    metrics.number(MET_READ_ERRORS, s.readErrors);
+    metrics.text(MET_WIFI_MODE, wifiModeText());
+    metrics.text(MET_NETWORK, clientMode || !apActive ? STA_SSID : AP_SSID);
+    metrics.ipv4(MET_IP, ip[0], ip[1], ip[2], ip[3]);
+    metrics.number(MET_WIFI_RECONNECTS, netReconnects);
+    metrics.number(MET_BOOT_TO_HTTP_MS, server.stats().firstResponseMs); // 0 until the first response
+    metrics.number(MET_HTTP_LIMITED, server.stats().rateLimited);
+    metrics.number(MET_HTTP_SHED, server.stats().shed);
+    metrics.number(MET_PRESS_REFUSED, pressRefused);
+    return metrics.commit();
+}
+
+// Build the full metrics JSON object into buf, returns its length or 0 if it did not fit
+size_t buildMetricsJson(char *buf, size_t len)
+{
+    refreshMetrics();
+    JsonWriter w(buf, len); // Formats straight into buf - no heap
+    metrics.writeJson(w, 0);
+    return w.overflow() ? 0 : w.length();
+}
+
+// CBOR for ?format=cbor or an Accept header asking for it, JSON otherwise
+bool wantsCbor(const HttpRequest &req)
+{
+    char format[8] = "";
+    if (req.arg("format", format, sizeof(format)))
+        return strcmp(format, "cbor") == 0;
+    const char *accept = req.header("Accept");
+    return accept && strstr(accept, "application/cbor");
+}
+
+// Unsigned 32-bit query argument (seq values do not fit argInt on a 32-bit long), 0 if absent or invalid
+uint32_t argUnsigned(const HttpRequest &req, const char *name)
+{
+    char buf[12] = "";
+    if (!req.arg(name, buf, sizeof(buf)) || !buf[0])
+        return 0;
+    char *end;
+    unsigned long v = strtoul(buf, &end, 10);
+    return *end ? 0 : (uint32_t)v;
+}
+
+// Metrics endpoint for JS polling and collectors - JSON, or CBOR via Accept: application/cbor / ?format=cbor
+// ?since=<seq> (the "seq" of an earlier response) returns only fields changed after it plus uptime/sample
+// age/samples, or 304 when nothing else changed
+void handleMetrics(const HttpRequest &req, HttpResponse &res)
+{
+    PERF_SCOPE(PERF_METRICS);
+    bool cbor = wantsCbor(req);
+    uint32_t since = argUnsigned(req, "since");
+    refreshMetrics();
+    res.header("Vary", "Accept");
+    if (since && !metrics.modifiedSince(since))
+    {
+        res.send(304, cbor ? "application/cbor" : "application/json", "");
+        return;
+    }
+    if (cbor)
+    {
+        uint8_t buf[384];
+        CborWriter w(buf, sizeof(buf));
+        metrics.writeCbor(w, since);
+        if (w.overflow())
+        {
+            res.send(500, "text/plain", "Metrics overflow");
+            return;
+        }
+        res.send(200, "application/cbor", buf, w.length());
+        return;
+    }
+    char buf[480];                  // Full object is ~320 bytes, more with a long SSID
+    JsonWriter w(buf, sizeof(buf)); // Formats straight into buf - no heap
+    metrics.writeJson(w, since);
+    if (w.overflow())
+    { // Buffer too small - fail loudly instead of sending truncated JSON
+        res.send(500, "text/plain", "Metrics overflow");
+        return;
+    }
+    res.send(200, "application/json", buf, w.length()); // Send JSON
+}
+
+// Stream the metrics object plus buffered readings (cursor: next reading, arg0: metrics since, arg1: flags)
+// Layout: {"metrics":{...},"from":<n>,"interval_ms":<ms>,"rows":[[age_ms, temp_c, pressure_hpa],...],"next":<n>}
+size_t metricsBatchChunk(HttpStreamState &st, char *buf, size_t cap)
+{
+    size_t n = writeBatchPart(metrics, recent, st.arg0, SAMPLE_INTERVAL_MS, millis(), st.cursor, st.arg1, buf, cap);
+    if (n == BATCH_OVERFLOW)
+    { // Too late for a 500 - fail the transfer instead of ending it with truncated JSON/CBOR
+        Serial.println("[HTTP] /metrics/batch part overflow, dropping the response");
+        return HTTP_STREAM_ABORT;
+    }
+    return n;
+}
+
+// Current metrics plus the readings buffered since ?from=<n> (the "next" of the previous batch) in one response
+// Format and ?since=<seq> work as on /metrics; 304 when neither the metrics nor the readings are new
+void handleMetricsBatch(const HttpRequest &req, HttpResponse &res)
+{
+    PERF_SCOPE(PERF_METRICS_BATCH);
+    bool cbor = wantsCbor(req);
+    uint32_t since = argUnsigned(req, "since");
+    uint32_t from = argUnsigned(req, "from");
+    refreshMetrics();
+    res.header("Vary", "Accept");
+    if (since && !metrics.modifiedSince(since) && from == recent.next())
+    {
+        res.send(304, cbor ? "application/cbor" : "application/json", "");
+        return;
+    }
+    HttpStreamState st = {nullptr, from, since, cbor ? BATCH_CBOR : 0};
+    res.header("Cache-Control", "no-store");
+    res.sendChunked(200, cbor ? "application/cbor" : "application/json", metricsBatchChunk, st);
+}
+
+// Subscribe to pushed metrics - the connection stays open and is fed by pushEvents()
+void handleEvents(const HttpRequest &, HttpResponse &res)
+{
+    if (!res.beginEventStream("retry: 3000\n\n")) // Browser reconnect delay
+    { // All stream slots busy - EventSource gives up and the page keeps polling
+        res.header("Retry-After", "5");
+        res.send(503, "text/plain", "Too many event subscribers");
+        return;
+    }
+    sseSampleSeq = UINT32_MAX;                // Force a full frame so the new subscriber hydrates at once
+    scheduler.after(millis(), 0, pushEvents); // Sent on the next pass, after the stream headers
+    Serial.printf("[SSE] Subscriber connected (%u open)\n", server.eventSubscribers());
+}
+
+// Serialize one frame per new sample or brew state change and fan it out to all subscribers
+// Runs after every sample, on brew state changes and every SSE_KEEPALIVE_MS (ping when nothing is new)
+void pushEvents(void *)
+{
+    if (!server.eventSubscribers())
+        return; // Nobody listening - skip serialization
+    uint32_t seq = snap.samples;
+    uint32_t now = millis();
+    char frame[496]; // "data: " + metrics JSON + "\n\n"
+    size_t len;
+    if (seq != sseSampleSeq || brewOn != sseBrewOn)
+    {
+        size_t json = buildMetricsJson(frame + 6, sizeof(frame) - 8);
+        if (!json)
+            return; // Frame would be truncated - skip it
+        memcpy(frame, "data: ", 6);
+        len = 6 + json;
+        frame[len++] = '\n';
+        frame[len++] = '\n';
+        sseSampleSeq = seq;
+        sseBrewOn = brewOn;
+    }
+    else if (now - sseLastSendMs >= SSE_KEEPALIVE_MS)
     {
-        html += "<p id='sensorStatus' class='sensor-status'>Sensor error (BMP280 not detected)</p>";
+        len = strlcpy(frame, ": ping\n\n", sizeof(frame)); // Comment line keeps proxies/NAT open
     }
     else
     {
-        html += "<p id='sensorStatus' class='sensor-status' style='display:none;'>Sensor error</p>";
-    }
-    // Main button (form POST to /press)
-    html += "<form method='POST' action='/press'><button id='brewButton' class='btn-main' type='submit'>" + String(brewOn ? "Turn Off" : "Start Brewing") + "</button></form>";
-    html += "<div class='ota-row'>OTA update at <code>/update</code><br>"
-            "<a class='ota-link' href='/update'>Open OTA Update</a></div>";
-    // JS for polling /metrics and updating UI (angle range -90..+90, 2.5s poll, smoothed needles)
-    html += F("<script>"
-              "const TEMP_MIN=");
-    html += String(TEMP_MIN, 1);
-    html += F(",TEMP_MAX=");
-    html += String(TEMP_MAX, 1);
-    html += F(",PRESS_MIN=");
-    html += String(PRESS_MIN, 1);
-    html += F(",PRESS_MAX=");
-    html += String(PRESS_MAX, 1);
-    html += F(",GAUGE_MIN_ANGLE=-90,GAUGE_MAX_ANGLE=90;"
-              "function clamp(v,min,max){return v<min?min:(v>max?max:v);} "
-              "let lastTempAngle=null,lastPressAngle=null;"
-              "function smoothAngle(target,last,alpha){"
-              "if(last===null||isNaN(last))return target;"
-              "return last+(target-last)*alpha;"
-              "}"
-              "function updateFromMetrics(data){"
-              "if(data.uptime){var u=document.getElementById('uptime');if(u)u.textContent='Uptime: '+data.uptime;}"
-              "var sensorOk=!!data.sensor_ok;"
-              "var sensorMsg=document.getElementById('sensorStatus');"
-              "if(sensorMsg){sensorMsg.style.display=sensorOk?'none':'block';}"
-              "if(sensorOk){"
-              "var t=data.temp_c;var p=data.pressure_hpa;"
-              "var tv=document.getElementById('tempValue');"
-              "var pv=document.getElementById('pressValue');"
-              "if(tv){tv.innerHTML=(t!=null? t.toFixed(1)+' &deg;C':'-- &deg;C');}"
-              "if(pv){pv.textContent=(p!=null? p.toFixed(1)+' hPa':'-- hPa');}"
-              "var tn=document.getElementById('tempNeedle');"
-              "if(tn && t!=null){"
-              "var tnVal=clamp(t,TEMP_MIN,TEMP_MAX);"
-              "var tnNorm=(tnVal-TEMP_MIN)/(TEMP_MAX-TEMP_MIN);"
-              "var tnAng=GAUGE_MIN_ANGLE+(GAUGE_MAX_ANGLE-GAUGE_MIN_ANGLE)*tnNorm;"
-              "tnAng=smoothAngle(tnAng,lastTempAngle,0.35);"
-              "lastTempAngle=tnAng;"
-              "tn.style.transform='rotate('+tnAng+'deg)';}"
-              "var pn=document.getElementById('pressNeedle');"
-              "if(pn && p!=null){"
-              "var pnVal=clamp(p,PRESS_MIN,PRESS_MAX);"
-              "var pnNorm=(pnVal-PRESS_MIN)/(PRESS_MAX-PRESS_MIN);"
-              "var pnAng=GAUGE_MIN_ANGLE+(GAUGE_MAX_ANGLE-GAUGE_MIN_ANGLE)*pnNorm;"
-              "pnAng=smoothAngle(pnAng,lastPressAngle,0.35);"
-              "lastPressAngle=pnAng;"
-              "pn.style.transform='rotate('+pnAng+'deg)';}"
-              "}"
-              "var mug=document.getElementById('mug');"
-              "var btn=document.getElementById('brewButton');"
-              "if(data.brew_on){"
-              "if(mug)mug.classList.add('on');"
-              "if(btn)btn.textContent='Turn Off';"
-              "}else{"
-              "if(mug)mug.classList.remove('on');"
-              "if(btn)btn.textContent='Start Brewing';"
-              "}"
-              "}"
-              "function pollMetrics(){"
-              "fetch('/metrics').then(function(r){return r.json();}).then(updateFromMetrics)"
-              ".catch(function(e){console && console.warn && console.warn('metrics error',e);});"
-              "}"
-              "document.addEventListener('DOMContentLoaded',function(){"
-              "pollMetrics();"
-              "setInterval(pollMetrics,2500);"
-              "});"
-              "</script>");
-    html += "</main></body></html>";
-    server.send(200, "text/html", html); // Send root HTML
-}
-
-// Get BMP280 sensor values
-void readBmp(float &tempOut, float &pressOut)
+        return; // Nothing new to send
+    }
+    sseLastSendMs = now;
+    server.broadcastEvent(frame, len); // Non-blocking fan-out, backed-up subscribers skip the frame
+}
+
+// Drop the auto-off deadline - the cycle ended, or a press is starting a new one
+void endAutoOffCycle()
 {
+    scheduler.cancel(autoOffTask);
+    autoOffTask = 0;
+    autoOffArmed = false;
+}
+
+// Mirror the detected phase into brewOn, arm the auto-off check when a new cycle starts and drop it once the cycle ended
+void applyBrewPhase(BrewPhase before)
+{
+    BrewPhase phase = brewDetector.phase();
+    bool wasOn = brewOn;
+    brewOn = brewDetector.brewOn();
+    if (phase != before)
+    {
+        Serial.printf("[BREW] %s -> %s (%.2f C, %+.2f C/min)\n", brewPhaseName(before), brewPhaseName(phase),
+                      brewDetector.smoothedC(), brewDetector.slopePerMin());
+    }
+    if (phase == BrewPhase::Heating && !autoOffArmed)
+    { // New cycle - auto-off is due 40 minutes after heating started; cooled -> heating noise keeps this deadline
+        autoOffArmed = true;
+        autoOffTask = scheduler.at(brewDetector.cycleStartMs() + BREW_AUTO_OFF_MS, autoOff);
+    }
+    else if (autoOffArmed && (phase == BrewPhase::Idle ||
+                              (phase == BrewPhase::Cooled && millis() - brewDetector.phaseSinceMs() >= BREW_CYCLE_END_MS)))
+    {
+        endAutoOffCycle(); // Really switched off before the timeout
+    }
+    if (brewOn != wasOn)
+        scheduler.after(millis(), 0, pushEvents); // Push the new state without waiting for the next sample
+}
+
+// Auto-off deadline - press once from a steady keep-warm, look again while the pot is brewing or the reading moves
+void autoOff(void *)
+{
+    uint32_t now = millis();
+    if (!brewOn)
+    { // Cooled, but maybe only a wobble - keep watching until applyBrewPhase() ends the cycle
+        autoOffTask = scheduler.after(now, BREW_AUTO_OFF_RECHECK_MS, autoOff);
+        return;
+    }
+    BrewPhase before = brewDetector.phase();
     if (!bmpOk)
-    { // Set NANs if sensor bool is not true
-        tempOut = NAN;
-        pressOut = NAN;
-        return; // Exit if sensor is not up
-    }
-    tempOut = bmp.readTemperature();        // Get temperature
-    pressOut = bmp.readPressure() / 100.0f; // Get pressure
-}
-
-// Build uptime char buffer
-String uptimeString()
-{
-    unsigned long ms = millis();   // Get time in ms since boot
-    unsigned long s = ms / 1000UL; // Get seconds
-    unsigned long m = s / 60UL;    // Get minutes
-    unsigned long h = m / 60UL;    // Get hours
-    char buf[40];                  // Initialize 40 byte char buffer
-    snprintf(buf, sizeof(buf), "%luh %lum %lus", (unsigned)h, (unsigned)(m % 60), (unsigned)(s % 60));
-    return String(buf);
-}
-
-// Toggle relay and UI state
-void handlePress()
-{
-    const uint16_t PRESS_MS = 250; // Relay close duration - 250ms
-    Serial.printf("[RELAY] Simulating button press for %u ms\n", PRESS_MS);
-    // UI handling
-    brewOn = !brewOn;                    // Toggle logical brew state for UI presentation
-    brewOnSince = brewOn ? millis() : 0; // Start/reset 40 minute UI timer
-    // Relay handling
-    digitalWrite(RELAY_PIN, LOW);             // Set GPIO2 low - simulate physical button press
-    delay(PRESS_MS);                          // Hold for 250ms
-    digitalWrite(RELAY_PIN, HIGH);            // Set GPIO2 high - simulate physical button release
-    server.sendHeader("Location", "/", true); // Refresh page to present updated UI state
-    server.send(303, "text/plain", "");       // Send page refresh request
-}
-
-// JSON metrics endpoint for JS polling
-void handleMetrics()
-{
-    float temp, press;         // Declare variables for temp and pressure
-    readBmp(temp, press);      // Get BMP280 sensor values
-    char buf[256];             // Initialize 256 byte char buffer
-    snprintf(buf, sizeof(buf), // Build JSON
-             "{"
-             "\"uptime\":\"%s\","
-             "\"temp_c\":%s,"
-             "\"pressure_hpa\":%s,"
-             "\"sensor_ok\":%s,"
-             "\"brew_on\":%s"
-             "}",
-             uptimeString().c_str(),
-             (bmpOk && !isnan(temp)) ? String(temp, 2).c_str() : "null",
-             (bmpOk && !isnan(press)) ? String(press, 2).c_str() : "null",
-             bmpOk ? "true" : "false",
-             brewOn ? "true" : "false");
-    server.send(200, "application/json", buf); // Send JSON
+    { // No sensor - keep the old blind behaviour: UI resets 40 minutes after the press, relay untouched
+        brewDetector.notePress(now, false);
+        applyBrewPhase(before);
+        endAutoOffCycle(); // No samples will ever end the cycle
+        Serial.println("[BREW] Auto UI off after 40-minute timeout (no sensor)");
+        return;
+    }
+    // A machine switched off by hand (or by itself) keeps reading KeepWarm until the detector sees it cool, and a
+    // press then would turn the hotplate back on - only press once keep-warm has outlasted that detection window
+    // and the reading is still level on the plate
+    if (!brewDetector.keepWarmSteady(now) || !startPress(1))
+    { // Still heating/brewing, maybe cooling, or the relay is busy
+        autoOffTask = scheduler.after(now, BREW_AUTO_OFF_RECHECK_MS, autoOff);
+        return;
+    }
+    Serial.println("[BREW] Auto-off: keep-warm past 40 minutes, pressing the button");
+    brewDetector.notePress(now, false);
+    applyBrewPhase(before);
+    autoOffTask = scheduler.after(now, BREW_AUTO_OFF_RECHECK_MS, autoOff); // Until cooled holds - heating again means the press did not take
+}
+
+// Load the saved brew schedule - it is armed once SNTP has set the clock
+void loadBrewSchedule()
+{
+    brewPrefs.begin("brew", false); // NVS namespace for the schedule
+    if (brewPrefs.getBytes("schedule", &brewSchedule, sizeof(brewSchedule)) != sizeof(brewSchedule))
+    {                            // Nothing saved yet (or an old layout)
+        brewSchedule.minute = -1;
+    }
+}
+
+// Note the first SNTP sync and arm the saved schedule against the now valid clock
+void checkClock()
+{
+    if (timeSynced || time(nullptr) < TIME_VALID_AFTER)
+        return;
+    timeSynced = true;
+    Serial.printf("[TIME] Clock set by SNTP (TZ %s)\n", TIMEZONE);
+    armBrewSchedule();
+}
+
+// Seconds until the next local minute-of-day that is at least minLeadS away, -1 if the clock is not set
+long secondsUntil(int16_t minute, long minLeadS)
+{
+    time_t now = time(nullptr);
+    if (now < TIME_VALID_AFTER)
+        return -1;
+    struct tm local;
+    localtime_r(&now, &local);
+    long wait = minute * 60L - (local.tm_hour * 3600L + local.tm_min * 60L + local.tm_sec);
+    while (wait < minLeadS)
+        wait += 24L * 3600L; // Today's slot has passed - same time tomorrow
+    return wait;
+}
+
+// (Re)arm the scheduled start from brewSchedule - a no-op until the clock is set
+void armBrewSchedule()
+{
+    scheduler.cancel(brewScheduleTask);
+    brewScheduleTask = 0;
+    long wait = brewSchedule.minute >= 0 ? secondsUntil(brewSchedule.minute, 1) : -1;
+    if (wait < 0)
+        return; // Nothing scheduled, or no wall clock yet (checkClock() arms it later)
+    brewScheduleTask = scheduler.after(millis(), (uint32_t)wait * 1000UL, scheduledBrew);
+    Serial.printf("[SCHEDULE] Brew at %02d:%02d%s, in %ld s\n", brewSchedule.minute / 60, brewSchedule.minute % 60,
+                  brewSchedule.daily ? " daily" : "", wait);
+}
+
+// Scheduled start time reached - switch the machine on unless it already is
+void scheduledBrew(void *)
+{
+    long wait = secondsUntil(brewSchedule.minute, 0);
+    if (wait > 0 && wait < 12L * 3600L)
+    { // SNTP moved the clock back since arming - not time yet
+        armBrewSchedule();
+        return;
+    }
+    if (brewOn)
+    {
+        Serial.println("[SCHEDULE] Already brewing, nothing to press");
+    }
+    else if (startPress(1))
+    {
+        Serial.println("[SCHEDULE] Scheduled brew, pressing the button");
+        BrewPhase before = brewDetector.phase();
+        endAutoOffCycle(); // New cycle with its own deadline
+        brewDetector.notePress(millis(), true);
+        applyBrewPhase(before);
+    }
+    else
+    { // Relay busy with a manual press - try again in a moment
+        brewScheduleTask = scheduler.after(millis(), PRESS_MS * 2, scheduledBrew);
+        return;
+    }
+    if (!brewSchedule.daily)
+    { // One-off - clear it
+        brewSchedule.minute = -1;
+        brewPrefs.putBytes("schedule", &brewSchedule, sizeof(brewSchedule));
+    }
+    armBrewSchedule();
+}
+
+// Load the beacon period and start the periodic send - must follow loadBrewSchedule() (opens brewPrefs)
+void loadBeacon()
+{
+    beaconIntervalMs = brewPrefs.getUInt("beacon_ms", BEACON_DEFAULT_MS);
+    WiFi.macAddress(deviceId);
+    armBeacon();
+}
+
+// (Re)arm the periodic beacon from beaconIntervalMs - 0 stops it
+void armBeacon()
+{
+    scheduler.cancel(beaconTask);
+    beaconTask = 0;
+    if (beaconIntervalMs)
+        beaconTask = scheduler.every(millis(), beaconIntervalMs, sendBeacon);
+}
+
+// Multicast one telemetry datagram (runs every beaconIntervalMs)
+void sendBeacon(void *)
+{
+    if (!clientMode && !apActive)
+        return; // No interface to send on - the sequence only counts datagrams that could go out
+    if (!beacon.active() && !beacon.begin())
+        return;
+    BeaconPacket p;
+    memset(&p, 0, sizeof(p));
+    memcpy(p.id, deviceId, sizeof(p.id));
+    p.seq = beaconSeq;
+    p.uptimeMs = millis() - bootMillis;
+    p.tempCenti = isnan(snap.tempC) ? BEACON_NO_TEMP : (int16_t)lroundf(snap.tempC * 100.0f);
+    p.pressDeci = isnan(snap.pressHpa) ? 0 : (uint16_t)lroundf(snap.pressHpa * 10.0f);
+    p.flags = (brewOn ? BEACON_BREW_ON : 0) | (bmpOk ? BEACON_SENSOR_OK : 0) | (clientMode ? BEACON_STA : 0);
+    p.phase = (uint8_t)brewDetector.phase();
+    p.rssi = clientMode ? (int8_t)WiFi.RSSI() : 0;
+    p.intervalMs = (uint16_t)beaconIntervalMs;
+    if (beacon.send(p))
+        beaconSeq++; // Only datagrams that left count, so receivers read gaps as network loss
+}
+
+// Telemetry beacon - GET returns settings and counters as JSON, POST interval_ms=N sets the period (0 = off)
+void handleBeacon(const HttpRequest &req, HttpResponse &res)
+{
+    if (req.method == HttpMethod::Post)
+    {
+        long ms = req.argInt("interval_ms", -1);
+        if (ms != 0 && (ms < (long)BEACON_MIN_MS || ms > (long)BEACON_MAX_MS))
+        {
+            res.send(400, "text/plain", "Invalid interval, expected interval_ms=0 (off) or 100-65535");
+            return;
+        }
+        if ((uint32_t)ms != beaconIntervalMs)
+        {
+            beaconIntervalMs = (uint32_t)ms;
+            brewPrefs.putUInt("beacon_ms", beaconIntervalMs); // Survives a reboot
+            armBeacon();
+            Serial.printf("[BEACON] Interval %lu ms\n", (unsigned long)beaconIntervalMs);
+        }
+    }
+    char id[18];
+    snprintf(id, sizeof(id), "%02x:%02x:%02x:%02x:%02x:%02x", deviceId[0], deviceId[1], deviceId[2], deviceId[3],
+             deviceId[4], deviceId[5]);
+    char buf[224];
+    JsonWriter w(buf, sizeof(buf));
+    w.beginObject();
+    w.key("enabled").boolean(beaconIntervalMs != 0);
+    w.key("interval_ms").number(beaconIntervalMs);
+    w.key("group").str(BEACON_GROUP);
+    w.key("port").number(BEACON_PORT);
+    w.key("version").number(BEACON_VERSION);
+    w.key("id").str(id);
+    w.key("seq").number(beaconSeq);
+    w.key("sent").number(beacon.sent());
+    w.key("errors").number(beacon.errors());
+    w.endObject();
+    res.header("Cache-Control", "no-store");
+    res.send(200, "application/json", buf, w.length());
+}
+
+// Append the latest snapshot to the history ring (runs every HISTORY_INTERVAL_MS)
+void recordHistory(void *)
+{
+    const SensorSnapshot &s = snap; // Latest sample
+    if (!s.samples && bmpOk)
+        return; // Sampler has not produced a reading yet
+    history.append((uint32_t)(esp_timer_get_time() / 1000000LL), s.tempC, s.pressHpa, brewOn); // millis() / 1000 would wrap after 49.7 days
+}
+
+// Chunk producer for /history - cursor is the next timestamp, arg0 the step, arg1 the stream flags
+size_t historyChunk(HttpStreamState &st, char *buf, size_t cap)
+{
+    const uint32_t OPENED = 1, HAS_ROW = 2, DONE = 4; // Stream flags kept in arg1
+    if (st.arg1 & DONE)
+        return 0;
+    size_t len = 0;
+    if (!(st.arg1 & OPENED))
+    {
+        buf[len++] = '[';
+        st.arg1 |= OPENED;
+    }
+    TelemetryHistory::Sample rows[HISTORY_ROWS_PER_CHUNK];
+    size_t n = history.read(st.cursor, st.arg0, rows, HISTORY_ROWS_PER_CHUNK, st.cursor);
+    for (size_t i = 0; i < n; i++)
+    { // Row: [ts, temp_c, pressure_hpa, brew_on]
+        if (st.arg1 & HAS_ROW)
+            buf[len++] = ',';
+        st.arg1 |= HAS_ROW;
+        JsonWriter w(buf + len, cap - len - 1); // Keep one byte for the closing bracket
+        w.beginArray();
+        w.number(rows[i].ts);
+        w.fixed<2>(rows[i].tempCenti == HISTORY_NO_TEMP ? NAN : rows[i].tempCenti / 100.0f);
+        w.fixed<1>(rows[i].pressDeci ? rows[i].pressDeci / 10.0f : NAN);
+        w.number(rows[i].brewOn ? 1 : 0);
+        w.endArray();
+        len += w.length(); // Rows are at most ~35 bytes, a chunk of 16 always fits
+    }
+    if (n < HISTORY_ROWS_PER_CHUNK)
+    { // History exhausted - close the array
+        buf[len++] = ']';
+        st.arg1 |= DONE;
+    }
+    return len;
+}
+
+// Stream history as a chunked JSON array of [ts, temp_c, pressure_hpa, brew_on] rows
+// ?since=<ts> skips older samples (ts = seconds since boot), ?step=<n> keeps one sample per n seconds
+void handleHistory(const HttpRequest &req, HttpResponse &res)
+{
+    long since = req.argInt("since", 0);
+    long step = req.argInt("step", 0);
+    if (since < 0 || step < 0)
+    {
+        res.send(400, "text/plain", "Invalid since/step");
+        return;
+    }
+    HttpStreamState st = {nullptr, (uint32_t)since, (uint32_t)step, 0};
+    res.header("Cache-Control", "no-cache");
+    res.sendChunked(200, "application/json", historyChunk, st); // Rows are decoded chunk by chunk, never buffered whole
+}
+
+// Forward /update to the ElegantOTA server on OTA_PORT
+void handleUpdateRedirect(const HttpRequest &req, HttpResponse &res)
+{
+    char host[64] = "brew.local"; // Fallback when the client sent no Host header
+    const char *h = req.header("Host");
+    if (h)
+    {
+        strlcpy(host, h, sizeof(host));
+        char *colon = strchr(host, ':');
+        if (colon)
+            *colon = '\0'; // Drop the port the page was loaded from
+    }
+    char location[96];
+    snprintf(location, sizeof(location), "http://%s:%u/update", host, OTA_PORT);
+    res.header("Location", location);
+    res.send(307, "text/plain", "");
+}
+
+// Compressed OTA session as JSON - clients resume from "offset"
+void sendOtaStatus(HttpResponse &res, int code)
+{
+    char buf[256];
+    JsonWriter w(buf, sizeof(buf));
+    w.beginObject();
+    w.key("state").str(ota.stateName());
+    w.key("offset").number(ota.offset());
+    w.key("zsize").number(ota.zsize());
+    w.key("size").number(ota.size());
+    w.key("written").number(ota.written());
+    w.key("rx_bytes").number(ota.rxBytes());
+    w.key("chunks").number(ota.chunks());
+    w.key("rejects").number(ota.rejects());
+    w.key("elapsed_ms").number(ota.elapsedMs());
+    w.key("resumed").boolean(ota.resumed());
+    w.key("error").str(ota.error());
+    w.endObject();
+    res.header("Cache-Control", "no-store");
+    res.send(code, "application/json", buf, w.length());
+}
+
+// Start a compressed upload, or resume the running one for the same size/zsize/md5 (?restart=1 forces a new one)
+void handleOtaBegin(const HttpRequest &req, HttpResponse &res)
+{
+    char md5[40] = "";
+    req.arg("md5", md5, sizeof(md5));
+    long size = req.argInt("size", 0);
+    long zsize = req.argInt("zsize", 0);
+    if (size <= 0 || zsize <= 0 || !ota.begin((uint32_t)size, (uint32_t)zsize, md5, req.argInt("restart", 0) != 0))
+    { // Bad arguments (400) or the image does not fit the partition (500)
+        Serial.printf("[OTA] Begin failed: %s\n", ota.error());
+        sendOtaStatus(res, ota.state() == OtaState::Failed ? 500 : 400);
+        return;
+    }
+    Serial.printf("[OTA] %s %ld -> %ld bytes at offset %lu\n", ota.resumed() ? "Resuming" : "Receiving", zsize, size,
+                  (unsigned long)ota.offset());
+    sendOtaStatus(res, 200);
+}
+
+// One chunk of the compressed stream: ?offset=<stream offset>&crc=<crc32 hex>, body = the bytes
+// 409 carries the offset to continue from (duplicate, gap or no session), 400 a damaged chunk to resend
+void handleOtaChunk(const HttpRequest &req, HttpResponse &res)
+{
+    char crcHex[12] = "";
+    req.arg("crc", crcHex, sizeof(crcHex));
+    char *end;
+    uint32_t crc = strtoul(crcHex, &end, 16);
+    long offset = req.argInt("offset", -1);
+    if (!crcHex[0] || *end || offset < 0)
+    {
+        res.send(400, "text/plain", "Expected offset and crc");
+        return;
+    }
+    switch (ota.chunk((uint32_t)offset, crc, req.body, req.bodyLen))
+    {
+    case OtaChunk::Accepted:
+        sendOtaStatus(res, 200);
+        break;
+    case OtaChunk::Complete:
+        Serial.printf("[OTA] Received %lu bytes (%lu inflated) in %lu ms\n", (unsigned long)ota.zsize(),
+                      (unsigned long)ota.written(), (unsigned long)ota.elapsedMs());
+        sendOtaStatus(res, 200);
+        break;
+    case OtaChunk::BadCrc:
+        res.send(400, "text/plain", "CRC mismatch");
+        break;
+    case OtaChunk::BadLength:
+        res.send(400, "text/plain", "Bad chunk length");
+        break;
+    case OtaChunk::Failed:
+        Serial.printf("[OTA] Aborted: %s\n", ota.error());
+        sendOtaStatus(res, 500);
+        break;
+    default: // WrongOffset, NoSession
+        sendOtaStatus(res, 409);
+    }
+}
+
+// Upload progress, and the offset to resume from after a dropped connection
+void handleOtaStatus(const HttpRequest &, HttpResponse &res)
+{
+    sendOtaStatus(res, 200);
+}
+
+// Verify the received image (MD5 + image check) and reboot into it - the running firmware stays on any failure
+void handleOtaCommit(const HttpRequest &, HttpResponse &res)
+{
+    bool received = ota.state() == OtaState::Received;
+    if (!ota.commit())
+    {
+        Serial.printf("[OTA] Commit failed: %s\n", ota.error());
+        sendOtaStatus(res, received ? 500 : 409);
+        return;
+    }
+    Serial.println("[OTA] Image verified, rebooting");
+    sendOtaStatus(res, 200);
+    scheduler.after(millis(), OTA_REBOOT_DELAY_MS, otaReboot);
+}
+
+// Restart into the committed image
+void otaReboot(void *)
+{
+    ESP.restart();
+}
+
+#if BREW_PERF
+// Stream the perf report one part per chunk (arg0: 1 = Prometheus text, 0 = JSON)
+size_t perfChunk(HttpStreamState &st, char *buf, size_t cap)
+{
+    PerfGauges g = {};
+    if (st.cursor == 0)
+    { // Gauges are only rendered in the first part
+        g.uptimeMs = millis();
+        g.freeHeap = ESP.getFreeHeap();
+        g.largestBlock = ESP.getMaxAllocHeap();
+        g.minFreeHeap = ESP.getMinFreeHeap();
+        g.wifiLinked = clientMode;
+        g.rssi = clientMode ? WiFi.RSSI() : 0;
+        g.reconnects = netReconnects;
+        g.powerMode = power.modeName();
+        g.cpuMhz = power.cpuMhz();
+        g.activeMs = power.timeInMs(PowerState::Active);
+        g.idleMs = power.timeInMs(PowerState::Idle);
+        g.waitingMs = power.timeInMs(PowerState::Waiting);
+    }
+    if (st.cursor <= 1)
+    { // Scheduler gauges go in part 0 (JSON) or part 1 (Prometheus)
+        const SchedStats &ss = scheduler.stats();
+        g.schedTasks = scheduler.size();
+        g.schedRuns = ss.runs;
+        g.schedLateMax = ss.lateMaxMs;
+        g.schedLateSum = ss.lateSumMs;
+        g.schedSkipped = ss.skipped;
+    }
+    return perfRender((uint8_t)st.cursor++, st.arg0 != 0, g, buf, cap);
+}
+
+// Instrumentation report - JSON by default, Prometheus text for ?format=prometheus or a scraper's Accept header
+void handleDebugPerf(const HttpRequest &req, HttpResponse &res)
+{
+    char format[16] = "";
+    req.arg("format", format, sizeof(format));
+    const char *accept = req.header("Accept");
+    bool prometheus = strcmp(format, "prometheus") == 0 ||
+                      (!format[0] && accept && (strstr(accept, "openmetrics") || strncmp(accept, "text/plain", 10) == 0));
+    HttpStreamState st = {nullptr, 0, prometheus ? 1u : 0u, 0};
+    res.header("Cache-Control", "no-store");
+    res.sendChunked(200, prometheus ? "text/plain; version=0.0.4" : "application/json", perfChunk, st);
+}
+#endif
+
+// Admission hook - token buckets per client address and per route, see src/admission.h
+int admitRequest(const HttpRequest &req, uint32_t &retryAfterS)
+{
+    return admission.check(req.clientIp, req.path, millis(), retryAfterS);
 }
 
 // Handle invalid page routes
-void handleNotFound()
+void handleNotFound(const HttpRequest &, HttpResponse &res)
 {
-    server.send(404, "text/plain", "Not found"); // Send 404
+    PERF_SCOPE(PERF_NOT_FOUND);
+    res.send(404, "text/plain", "Not found"); // Send 404
 }
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "metrics_store.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+MetricsTable::MetricsTable(const MetricField *fields, uint8_t count)
+    : fields(fields), count(count < METRICS_MAX_FIELDS ? count : METRICS_MAX_FIELDS)
+{
+    begin(0);
+}
+
+void MetricsTable::begin(uint32_t seqBase)
+{
+    memset(values, 0, sizeof(values));
+    memset(stamp, 0, sizeof(stamp));
+    cur = seqBase;
+    dirty = (1UL << count) - 1; // The first commit() stamps every field with seqBase + 1
+}
+
+void MetricsTable::number(uint8_t id, uint32_t v)
+{
+    set(id, NUMBER, v);
+}
+
+void MetricsTable::fixed2(uint8_t id, float v)
+{
+    if (isnan(v) || isinf(v))
+        set(id, NONE, 0);
+    else
+        set(id, FIXED2, (uint32_t)(int32_t)lroundf(v * 100.0f));
+}
+
+void MetricsTable::boolean(uint8_t id, bool v)
+{
+    set(id, BOOL, v ? 1 : 0);
+}
+
+void MetricsTable::text(uint8_t id, const char *v)
+{
+    if (v)
+        set(id, TEXT, 0, v);
+    else
+        set(id, NONE, 0);
+}
+
+void MetricsTable::ipv4(uint8_t id, uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+{
+    set(id, IPV4, (uint32_t)a << 24 | (uint32_t)b << 16 | (uint32_t)c << 8 | d);
+}
+
+void MetricsTable::uptime(uint8_t id, uint32_t ms)
+{
+    set(id, UPTIME, ms);
+}
+
+void MetricsTable::null(uint8_t id)
+{
+    set(id, NONE, 0);
+}
+
+void MetricsTable::set(uint8_t id, Kind kind, uint32_t v, const char *s)
+{
+    if (id >= count)
+        return;
+    Value &val = values[id];
+    bool same = val.kind == kind && val.v == v && (kind != TEXT || strncmp(val.text, s, METRICS_TEXT_MAX - 1) == 0);
+    if (same)
+        return;
+    val.kind = kind;
+    val.v = v;
+    if (kind == TEXT)
+    {
+        strncpy(val.text, s, METRICS_TEXT_MAX - 1);
+        val.text[METRICS_TEXT_MAX - 1] = '\0';
+    }
+    if (!fields[id].volatileValue)
+        dirty |= 1UL << id;
+}
+
+uint32_t MetricsTable::commit()
+{
+    if (!dirty)
+        return cur;
+    cur++;
+    for (uint8_t i = 0; i < count; i++)
+        if (dirty & (1UL << i))
+            stamp[i] = cur;
+    dirty = 0;
+    return cur;
+}
+
+bool MetricsTable::modifiedSince(uint32_t since) const
+{
+    return since != cur;
+}
+
+bool MetricsTable::included(uint8_t id, uint32_t since) const
+{
+    if (since == 0 || since > cur)
+        return true; // Full state: first scrape, or a seq from another boot
+    return fields[id].volatileValue || stamp[id] > since;
+}
+
+template <typename W>
+void MetricsTable::writeValue(W &w, const Value &val) const
+{
+    switch (val.kind)
+    {
+    case NUMBER:
+        w.number(val.v);
+        break;
+    case FIXED2:
+        w.template fixed<2>((int32_t)val.v / 100.0f);
+        break;
+    case BOOL:
+        w.boolean(val.v != 0);
+        break;
+    case TEXT:
+        w.str(val.text);
+        break;
+    case IPV4:
+        w.ipv4((uint8_t)(val.v >> 24), (uint8_t)(val.v >> 16), (uint8_t)(val.v >> 8), (uint8_t)val.v);
+        break;
+    case UPTIME:
+        w.uptime(val.v);
+        break;
+    default:
+        w.null();
+    }
+}
+
+template <typename W>
+void MetricsTable::write(W &w, uint32_t since) const
+{
+    w.beginObject();
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (!included(i, since))
+            continue;
+        w.key(fields[i].name);
+        writeValue(w, values[i]);
+    }
+    w.key("seq").number(cur);
+    w.endObject();
+}
+
+void MetricsTable::writeJson(JsonWriter &w, uint32_t since) const
+{
+    write(w, since);
+}
+
+void MetricsTable::writeCbor(CborWriter &w, uint32_t since) const
+{
+    write(w, since);
+}
+
+void RecentSamples::push(uint32_t ms, float tempC, float pressHpa)
+{
+    Sample &s = ring[total % RECENT_SAMPLES];
+    s.ms = ms;
+    s.tempCenti = isnan(tempC) ? NO_TEMP : (int16_t)lroundf(tempC * 100.0f);
+    s.pressDeci = isnan(pressHpa) ? 0 : (uint16_t)lroundf(pressHpa * 10.0f);
+    total++;
+}
+
+uint32_t RecentSamples::oldest() const
+{
+    return total > RECENT_SAMPLES ? total - RECENT_SAMPLES : 0;
+}
+
+bool RecentSamples::get(uint32_t n, Sample &out) const
+{
+    if (n >= total || n < oldest())
+        return false;
+    out = ring[n % RECENT_SAMPLES];
+    return true;
+}
+
+size_t writeBatchPart(const MetricsTable &metrics, const RecentSamples &recent, uint32_t since, uint32_t intervalMs,
+                      uint32_t nowMs, uint32_t &cursor, uint32_t &flags, char *buf, size_t cap)
+{
+    const uint32_t OPENED = 2, HAS_ROW = 4, DONE = 8; // State kept in flags next to BATCH_CBOR
+    if (flags & DONE)
+        return 0;
+    bool cbor = flags & BATCH_CBOR;
+    if (!(flags & OPENED))
+    { // First part: the metrics object and the start of the rows
+        flags |= OPENED;
+        if (cursor < recent.oldest() || cursor > recent.next())
+            cursor = recent.oldest(); // Too old, or from before a reboot - everything held
+        if (cbor)
+        {
+            CborWriter w((uint8_t *)buf, cap);
+            w.beginObject().key("metrics");
+            metrics.writeCbor(w, since);
+            w.key("from").number(cursor);
+            w.key("interval_ms").number(intervalMs);
+            w.key("rows").beginArray();
+            return w.overflow() ? BATCH_OVERFLOW : w.length();
+        }
+        JsonWriter w(buf, cap); // Left open, later parts append rows and the closing brackets
+        w.beginObject().key("metrics");
+        metrics.writeJson(w, since);
+        w.key("from").number(cursor);
+        w.key("interval_ms").number(intervalMs);
+        w.key("rows").beginArray();
+        return w.overflow() ? BATCH_OVERFLOW : w.length();
+    }
+    const size_t TAIL = 24; // Room for the closing "],"next":<n>}"
+    if (cap <= TAIL)
+        return BATCH_OVERFLOW;
+    uint32_t end = recent.next();
+    size_t len = 0;
+    RecentSamples::Sample s;
+    for (uint8_t rows = 0; rows < BATCH_ROWS_PER_PART && cursor < end; rows++, cursor++)
+    { // Row: [age_ms, temp_c, pressure_hpa]
+        if (!recent.get(cursor, s))
+            continue; // Overwritten while streaming
+        float t = s.tempCenti == RecentSamples::NO_TEMP ? NAN : s.tempCenti / 100.0f;
+        float p = s.pressDeci ? s.pressDeci / 10.0f : NAN;
+        if (cbor)
+        {
+            CborWriter w((uint8_t *)buf + len, cap - len - TAIL);
+            w.beginArray().number(nowMs - s.ms).fixed<2>(t).fixed<1>(p).endArray();
+            if (w.overflow())
+                return BATCH_OVERFLOW;
+            len += w.length(); // Rows are at most 16 bytes
+            continue;
+        }
+        if (flags & HAS_ROW)
+            buf[len++] = ',';
+        flags |= HAS_ROW;
+        JsonWriter w(buf + len, cap - len - TAIL);
+        w.beginArray().number(nowMs - s.ms).fixed<2>(t).fixed<1>(p).endArray();
+        if (w.overflow())
+            return BATCH_OVERFLOW;
+        len += w.length(); // Rows are at most ~30 bytes
+    }
+    if (cursor >= end)
+    { // Buffer exhausted - close the rows and the object
+        if (cbor)
+        {
+            CborWriter w((uint8_t *)buf + len, cap - len);
+            w.endArray().key("next").number(end).endObject();
+            len += w.length();
+        }
+        else
+            len += snprintf(buf + len, cap - len, "],\"next\":%lu}", (unsigned long)end);
+        flags |= DONE;
+    }
+    return len;
+}
@@ -0,0 +1,119 @@
+/*
+Metrics state for Embedded Brew's /metrics and /metrics/batch.
+
+MetricsTable holds the current value of every /metrics field and encodes it as JSON or CBOR from
+the same data. Each refresh ends with commit(): if any stable field changed, the table's sequence
+number advances and the changed fields are stamped with it. A scraper that sends back the last
+seq it saw gets only the fields stamped after it (plus the volatile ones such as uptime, which
+change on every read and never count as a change), or 304 when nothing changed at all.
+Temperatures and pressures are compared at the two decimals they are reported with, so sensor
+noise below that does not defeat the delta.
+
+The sequence starts from a per-boot random base: a seq from before a reboot is either below every
+stamp or above the current seq, and both cases return the full state.
+
+RecentSamples keeps the last RECENT_SAMPLES sensor readings at full rate so a collector polling
+every minute can fetch them in one batched response instead of one scrape per sample.
+writeBatchPart() encodes that response one chunk at a time: the metrics object, then the rows.
+
+Portable C++ - tools/metrics_bench.cpp measures bytes and encode time per format on the host.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cbor_writer.h"
+#include "json_writer.h"
+
+const uint8_t METRICS_MAX_FIELDS = 24;    // Fields per table
+const uint8_t METRICS_TEXT_MAX = 33;      // Longest text value + NUL (an SSID)
+const uint8_t RECENT_SAMPLES = 64;        // Readings kept for /metrics/batch (~1 min at 1 Hz)
+const uint8_t BATCH_ROWS_PER_PART = 16;   // Readings encoded per writeBatchPart() call
+const uint32_t BATCH_CBOR = 1;            // writeBatchPart() flag set by the caller: CBOR instead of JSON
+const size_t BATCH_OVERFLOW = (size_t)-1; // writeBatchPart() result when a part did not fit its buffer
+
+struct MetricField
+{
+    const char *name;   // Key in the encoded object
+    bool volatileValue; // Changes on every read - sent with every delta, never bumps seq
+};
+
+class MetricsTable
+{
+public:
+    MetricsTable(const MetricField *fields, uint8_t count);
+    void begin(uint32_t seqBase);                        // Clear all values, stamps start after seqBase
+    void number(uint8_t id, uint32_t v);
+    void fixed2(uint8_t id, float v);                    // Compared and sent at 0.01 resolution, NAN is null
+    void boolean(uint8_t id, bool v);
+    void text(uint8_t id, const char *v);                // Truncated to METRICS_TEXT_MAX - 1, nullptr is null
+    void ipv4(uint8_t id, uint8_t a, uint8_t b, uint8_t c, uint8_t d);
+    void uptime(uint8_t id, uint32_t ms);                // "<h>h <m>m <s>s" in JSON, milliseconds in CBOR
+    void null(uint8_t id);
+    uint32_t commit();                                   // End a refresh - advance seq if a stable field changed
+    uint32_t seq() const { return cur; }                 // Sequence of the latest change
+    bool modifiedSince(uint32_t since) const;            // False only when since is the current seq
+    void writeJson(JsonWriter &w, uint32_t since) const; // Object of fields changed after since (0 = all) + "seq"
+    void writeCbor(CborWriter &w, uint32_t since) const; // Same as writeJson, CBOR map
+
+private:
+    enum Kind : uint8_t
+    {
+        NONE,
+        NUMBER,
+        FIXED2,
+        BOOL,
+        TEXT,
+        IPV4,
+        UPTIME
+    };
+    struct Value
+    {
+        Kind kind;
+        uint32_t v;                  // Number, hundredths (as int32), bool, packed IPv4 or uptime ms
+        char text[METRICS_TEXT_MAX]; // TEXT only
+    };
+    void set(uint8_t id, Kind kind, uint32_t v, const char *s = nullptr);
+    bool included(uint8_t id, uint32_t since) const; // Field belongs in a response for since
+    template <typename W>
+    void writeValue(W &w, const Value &val) const;
+    template <typename W>
+    void write(W &w, uint32_t since) const;
+    const MetricField *fields;
+    uint8_t count;
+    Value values[METRICS_MAX_FIELDS];
+    uint32_t stamp[METRICS_MAX_FIELDS]; // seq of each field's last change
+    uint32_t dirty = 0;                 // Stable fields changed since the last commit()
+    uint32_t cur = 0;                   // Current seq
+};
+
+class RecentSamples
+{
+public:
+    struct Sample
+    {
+        uint32_t ms;        // millis() at the reading
+        int16_t tempCenti;  // Temperature in 0.01 C (NO_TEMP if unavailable)
+        uint16_t pressDeci; // Pressure in 0.1 hPa (0 if unavailable)
+    };
+    static const int16_t NO_TEMP = INT16_MIN;
+
+    void push(uint32_t ms, float tempC, float pressHpa); // Record the next reading
+    uint32_t next() const { return total; }              // Number the next reading will get (= readings so far)
+    uint32_t oldest() const;                             // Number of the oldest reading still held
+    bool get(uint32_t n, Sample &out) const;             // Reading number n, false if not held
+
+private:
+    Sample ring[RECENT_SAMPLES];
+    uint32_t total = 0;
+};
+
+// Next part of a /metrics/batch body into buf: the metrics object (fields changed after since) on the
+// first call, then up to BATCH_ROWS_PER_PART readings from cursor per call, the closing brackets after
+// the last one. Layout: {"metrics":{...},"from":<n>,"interval_ms":<ms>,"rows":[[age_ms, temp_c,
+// pressure_hpa],...],"next":<n>}. cursor and flags carry the state between calls (start with the
+// reading number asked for and 0 or BATCH_CBOR). Returns 0 once complete, BATCH_OVERFLOW if the
+// metrics object or a row did not fit - the body cannot be finished and must be failed.
+size_t writeBatchPart(const MetricsTable &metrics, const RecentSamples &recent, uint32_t since, uint32_t intervalMs,
+                      uint32_t nowMs, uint32_t &cursor, uint32_t &flags, char *buf, size_t cap);
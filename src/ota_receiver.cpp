@@ -0,0 +1,164 @@
+#include "ota_receiver.h"
+
+#include <stdio.h>
+#include <string.h>
+
+uint32_t OtaReceiver::crc32(const uint8_t *data, size_t len)
+{
+    static const uint32_t NIBBLE[16] = {0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+                                        0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+                                        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C}; // 64 bytes instead of 1 KB
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ NIBBLE[crc & 0x0F];
+        crc = (crc >> 4) ^ NIBBLE[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+const char *OtaReceiver::stateName() const
+{
+    switch (st)
+    {
+    case OtaState::Idle:      return "idle";
+    case OtaState::Receiving: return "receiving";
+    case OtaState::Received:  return "received";
+    case OtaState::Committed: return "committed";
+    case OtaState::Failed:    return "failed";
+    }
+    return "unknown";
+}
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+#include <Update.h>
+
+bool OtaReceiver::begin(uint32_t size, uint32_t zsize, const char *imageMd5, bool restart)
+{
+    wasResumed = false;
+    bool hexMd5 = imageMd5 && strlen(imageMd5) == 32 && strspn(imageMd5, "0123456789abcdefABCDEF") == 32;
+    if (!size || !zsize || !hexMd5)
+    {
+        strlcpy(err, "size, zsize and a 32-digit md5 are required", sizeof(err));
+        return false;
+    }
+    bool active = st == OtaState::Receiving || st == OtaState::Received;
+    if (active && !restart && size == imageSize && zsize == streamSize && strcasecmp(imageMd5, md5) == 0)
+    { // Same image - carry on from the current offset
+        wasResumed = true;
+        return true;
+    }
+    abort();
+    if (!Update.begin(size, U_FLASH))
+    { // Image does not fit the OTA partition, or an ElegantOTA upload is running
+        snprintf(err, sizeof(err), "update begin: %s", Update.errorString());
+        st = OtaState::Failed;
+        return false;
+    }
+    Update.setMD5(imageMd5); // Checked by Update.end() before the partition switch
+    strlcpy(md5, imageMd5, sizeof(md5));
+    imageSize = size;
+    streamSize = zsize;
+    off = rx = 0;
+    accepted = rejected = 0;
+    startMs = millis();
+    doneMs = 0;
+    err[0] = '\0';
+    inf.begin(sink, this);
+    st = OtaState::Receiving;
+    return true;
+}
+
+OtaChunk OtaReceiver::chunk(uint32_t offset, uint32_t crc, const uint8_t *data, size_t len)
+{
+    rx += len;
+    if (st != OtaState::Receiving)
+    {
+        if (st == OtaState::Received)
+            return OtaChunk::WrongOffset; // Repeat of the last chunk - offset() == zsize tells the client to commit
+        return OtaChunk::NoSession;
+    }
+    if (offset != off)
+    {
+        rejected++;
+        return OtaChunk::WrongOffset;
+    }
+    if (!len || len > INFLATE_MAX_FEED || len > streamSize - off)
+    {
+        rejected++;
+        return OtaChunk::BadLength;
+    }
+    if (crc32(data, len) != crc)
+    {
+        rejected++;
+        return OtaChunk::BadCrc;
+    }
+    bool last = off + len == streamSize;
+    InflateStatus s = inf.feed(data, len, last);
+    if (s == InflateStatus::Error)
+        return fail(Update.hasError() ? Update.errorString() : inf.error());
+    off += len;
+    accepted++;
+    if (s == InflateStatus::More)
+        return OtaChunk::Accepted;
+    if (!last)
+        return fail("stream ended before zsize");
+    if (inf.totalOut() != imageSize)
+        return fail("inflated size does not match size");
+    st = OtaState::Received;
+    doneMs = millis();
+    return OtaChunk::Complete;
+}
+
+bool OtaReceiver::commit()
+{
+    if (st != OtaState::Received)
+    {
+        strlcpy(err, "upload not complete", sizeof(err));
+        return false;
+    }
+    if (!Update.end())
+    { // MD5 mismatch or an image the bootloader would refuse - the running partition stays
+        snprintf(err, sizeof(err), "verify: %s", Update.errorString());
+        st = OtaState::Failed;
+        return false;
+    }
+    st = OtaState::Committed;
+    return true;
+}
+
+void OtaReceiver::abort()
+{
+    if (st == OtaState::Receiving || st == OtaState::Received)
+        Update.abort();
+    st = OtaState::Idle;
+}
+
+uint32_t OtaReceiver::elapsedMs() const
+{
+    if (st == OtaState::Idle)
+        return 0;
+    return (doneMs ? doneMs : millis()) - startMs;
+}
+
+bool OtaReceiver::sink(void *ctx, const uint8_t *data, size_t len)
+{
+    OtaReceiver &r = *(OtaReceiver *)ctx;
+    if (r.inf.totalOut() > r.imageSize)
+        return false; // Stream inflates to more than the announced image
+    return Update.write((uint8_t *)data, len) == len;
+}
+
+OtaChunk OtaReceiver::fail(const char *why)
+{
+    strlcpy(err, why, sizeof(err));
+    Update.abort();
+    doneMs = millis();
+    st = OtaState::Failed;
+    return OtaChunk::Failed;
+}
+
+#endif
@@ -0,0 +1,87 @@
+/*
+Compressed, resumable OTA receiver for Embedded Brew.
+
+ElegantOTA posts the raw image in one long multipart upload on the blocking :8080 server, so a
+drop over the 5 dBm link means starting again from byte 0. This receiver takes the image as a
+zlib stream (4 KB window, see inflate.h) in small numbered chunks on the main HTTP server:
+
+    POST /ota/begin?size=<image bytes>&zsize=<stream bytes>&md5=<image md5>[&restart=1]
+    POST /ota/chunk?offset=<stream offset>&crc=<crc32 hex>   body = stream bytes
+    GET  /ota/status
+    POST /ota/commit
+
+Each chunk carries its stream offset and CRC-32, so a lost or damaged chunk is simply sent again,
+and a client that lost its connection asks /ota/status (or repeats /ota/begin, which resumes a
+session with the same size/zsize/md5) for the offset to continue from. Chunks are inflated as
+they arrive and written straight to the OTA partition - nothing is buffered beyond the window.
+commit() lets Update check the MD5 of the written image and validate it before the boot
+partition is switched. A session lives in RAM: it survives dropped connections, not a reboot.
+
+tools/ota_upload.py is the matching client.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "inflate.h"
+
+enum class OtaState : uint8_t
+{
+    Idle,      // No session
+    Receiving, // Waiting for the chunk at offset()
+    Received,  // Whole stream inflated and written, waiting for commit()
+    Committed, // Image verified and set as the boot partition
+    Failed,    // Session aborted - see error(), begin() again
+};
+
+enum class OtaChunk : uint8_t
+{
+    Accepted,    // Chunk written, send the next one
+    Complete,    // Last chunk written, commit() next
+    WrongOffset, // Not the expected offset (duplicate or gap) - resume at offset()
+    BadCrc,      // Chunk damaged in transit - send it again
+    BadLength,   // Empty, larger than INFLATE_MAX_FEED or past zsize
+    Failed,      // Stream or flash error, the session is aborted
+    NoSession,   // No session receiving
+};
+
+class OtaReceiver
+{
+public:
+    // Start (or, with the same size/zsize/md5 and !restart, resume) a session - false sets error()
+    bool begin(uint32_t size, uint32_t zsize, const char *md5, bool restart);
+    OtaChunk chunk(uint32_t offset, uint32_t crc, const uint8_t *data, size_t len); // Verify and inflate one chunk
+    bool commit();                                                                 // Verify the image and switch partitions
+    void abort();                                                                  // Drop the session and the partial image
+    OtaState state() const { return st; }
+    const char *stateName() const;
+    uint32_t offset() const { return off; }                 // Next expected stream offset
+    uint32_t size() const { return imageSize; }             // Image bytes announced by begin()
+    uint32_t zsize() const { return streamSize; }           // Stream bytes announced by begin()
+    uint32_t written() const { return inf.totalOut(); }     // Image bytes written to flash
+    uint32_t rxBytes() const { return rx; }                 // Chunk bytes received, including rejected ones
+    uint16_t chunks() const { return accepted; }            // Chunks accepted
+    uint16_t rejects() const { return rejected; }           // Chunks rejected (offset or CRC)
+    uint32_t elapsedMs() const;                             // Since begin(), frozen once received
+    bool resumed() const { return wasResumed; }             // Last begin() continued an existing session
+    const char *error() const { return err; }               // Reason for the last failure ("" if none)
+    static uint32_t crc32(const uint8_t *data, size_t len); // CRC-32 (IEEE, same as zlib.crc32)
+
+private:
+    static bool sink(void *ctx, const uint8_t *data, size_t len); // Inflated bytes to Update
+    OtaChunk fail(const char *why);
+    Inflater inf;
+    OtaState st = OtaState::Idle;
+    uint32_t imageSize = 0;
+    uint32_t streamSize = 0;
+    char md5[33] = "";
+    uint32_t off = 0;
+    uint32_t rx = 0;
+    uint16_t accepted = 0;
+    uint16_t rejected = 0;
+    uint32_t startMs = 0;
+    uint32_t doneMs = 0;
+    bool wasResumed = false;
+    char err[64] = "";
+};
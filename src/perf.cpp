@@ -0,0 +1,231 @@
+#include "perf.h"
+
+#if BREW_PERF
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "json_writer.h"
+
+#ifdef ARDUINO
+#include <esp_timer.h>
+#else
+#include <time.h>
+#endif
+
+// Bucket upper bounds (inclusive), the last bucket catches everything above
+static const uint32_t BUCKET_LE_US[PERF_BUCKETS] = {100, 250, 500, 1000, 2500, 5000, 10000, 25000, 100000, UINT32_MAX};
+static const char *const BUCKET_LE_S[PERF_BUCKETS] = {"0.0001", "0.00025", "0.0005", "0.001", "0.0025",
+                                                      "0.005", "0.01", "0.025", "0.1", "+Inf"};
+static const char *const OP_NAMES[PERF_OPS] = {"root", "metrics", "metrics_batch", "press", "not_found", "loop", "i2c"};
+
+static PerfHistogram hist[PERF_OPS];
+static volatile uint32_t loopStalls = 0;
+
+uint32_t perfNowUs()
+{
+#ifdef ARDUINO
+    return (uint32_t)esp_timer_get_time();
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000ULL);
+#endif
+}
+
+void perfRecord(PerfOp op, uint32_t us)
+{
+    PerfHistogram &h = hist[op];
+    uint8_t b = 0;
+    while (us > BUCKET_LE_US[b])
+        b++; // Terminates at the UINT32_MAX bucket
+    h.buckets[b]++;
+    h.count++;
+    h.sumUs += us;
+    if (us > h.maxUs)
+        h.maxUs = us;
+    if (op == PERF_LOOP && us >= PERF_STALL_US)
+        loopStalls++;
+}
+
+const PerfHistogram &perfHistogram(PerfOp op) { return hist[op]; }
+uint32_t perfLoopStalls() { return loopStalls; }
+const char *perfOpName(PerfOp op) { return op < PERF_OPS ? OP_NAMES[op] : "?"; }
+
+uint32_t perfPercentileUs(PerfOp op, uint8_t pct)
+{
+    const PerfHistogram &h = hist[op];
+    if (!h.count)
+        return 0;
+    uint32_t target = (uint32_t)(((uint64_t)h.count * pct + 99) / 100); // Rank of the percentile sample
+    uint32_t seen = 0;
+    for (uint8_t b = 0; b < PERF_BUCKETS; b++)
+    {
+        seen += h.buckets[b];
+        if (seen >= target)
+            return BUCKET_LE_US[b] < h.maxUs ? BUCKET_LE_US[b] : h.maxUs;
+    }
+    return h.maxUs;
+}
+
+// Append printf output at buf + len, clamped to cap
+static void appendf(char *buf, size_t cap, size_t &len, const char *fmt, ...)
+{
+    if (len + 1 >= cap)
+        return;
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf + len, cap - len, fmt, ap);
+    va_end(ap);
+    if (n > 0)
+        len += (size_t)n < cap - len ? (size_t)n : cap - len - 1;
+}
+
+// Microseconds as decimal seconds without floating point
+static void appendSeconds(char *buf, size_t cap, size_t &len, uint64_t us)
+{
+    appendf(buf, cap, len, "%lu.%06lu", (unsigned long)(us / 1000000ULL), (unsigned long)(us % 1000000ULL));
+}
+
+static size_t renderJson(uint8_t part, const PerfGauges &g, char *buf, size_t cap)
+{
+    if (part == 0)
+    { // Gauges - leaves the top-level object open
+        JsonWriter w(buf, cap);
+        w.beginObject();
+        w.key("uptime_ms").number(g.uptimeMs);
+        w.key("heap").beginObject();
+        w.key("free").number(g.freeHeap);
+        w.key("largest_block").number(g.largestBlock);
+        w.key("min_free").number(g.minFreeHeap);
+        w.endObject();
+        w.key("wifi").beginObject();
+        w.key("rssi");
+        if (g.wifiLinked)
+            w.integer(g.rssi);
+        else
+            w.null();
+        w.key("reconnects").number(g.reconnects);
+        w.endObject();
+        w.key("power").beginObject();
+        w.key("mode").str(g.powerMode ? g.powerMode : "none");
+        w.key("cpu_mhz").number(g.cpuMhz);
+        w.key("active_ms").number(g.activeMs);
+        w.key("idle_ms").number(g.idleMs);
+        w.key("waiting_ms").number(g.waitingMs);
+        w.endObject();
+        w.key("scheduler").beginObject();
+        w.key("tasks").number(g.schedTasks);
+        w.key("runs").number(g.schedRuns);
+        w.key("late_max_ms").number(g.schedLateMax);
+        w.key("late_sum_ms").number64(g.schedLateSum);
+        w.key("skipped").number(g.schedSkipped);
+        w.endObject();
+        w.key("loop_stalls").number(loopStalls);
+        w.key("stall_threshold_us").number(PERF_STALL_US);
+        return w.length();
+    }
+    if (part == 1)
+    { // Bucket bounds shared by every histogram, then open latency_us
+        size_t len = 0;
+        appendf(buf, cap, len, ",\"bucket_le_us\":");
+        JsonWriter w(buf + len, cap - len);
+        w.beginArray();
+        for (uint8_t b = 0; b < PERF_BUCKETS - 1; b++)
+            w.number(BUCKET_LE_US[b]);
+        w.null(); // Unbounded last bucket
+        w.endArray();
+        len += w.length();
+        appendf(buf, cap, len, ",\"latency_us\":{");
+        return len;
+    }
+    PerfOp op = (PerfOp)(part - 2);
+    const PerfHistogram &h = hist[op];
+    size_t len = 0;
+    appendf(buf, cap, len, "%s\"%s\":", op ? "," : "", OP_NAMES[op]);
+    JsonWriter w(buf + len, cap - len);
+    w.beginObject();
+    w.key("count").number(h.count);
+    w.key("sum").number64(h.sumUs);
+    w.key("max").number(h.maxUs);
+    w.key("p50").number(perfPercentileUs(op, 50));
+    w.key("p90").number(perfPercentileUs(op, 90));
+    w.key("p99").number(perfPercentileUs(op, 99));
+    w.key("buckets").beginArray();
+    for (uint8_t b = 0; b < PERF_BUCKETS; b++)
+        w.number(h.buckets[b]);
+    w.endArray();
+    w.endObject();
+    len += w.length();
+    if (op == PERF_OPS - 1)
+        appendf(buf, cap, len, "}}"); // Close latency_us and the top-level object
+    return len;
+}
+
+static size_t renderPrometheus(uint8_t part, const PerfGauges &g, char *buf, size_t cap)
+{
+    size_t len = 0;
+    if (part == 0)
+    {
+        appendf(buf, cap, len, "# TYPE brew_uptime_seconds gauge\nbrew_uptime_seconds ");
+        appendSeconds(buf, cap, len, (uint64_t)g.uptimeMs * 1000ULL);
+        appendf(buf, cap, len, "\n# TYPE brew_heap_free_bytes gauge\nbrew_heap_free_bytes %lu\n", (unsigned long)g.freeHeap);
+        appendf(buf, cap, len, "# TYPE brew_heap_largest_block_bytes gauge\nbrew_heap_largest_block_bytes %lu\n", (unsigned long)g.largestBlock);
+        appendf(buf, cap, len, "# TYPE brew_heap_min_free_bytes gauge\nbrew_heap_min_free_bytes %lu\n", (unsigned long)g.minFreeHeap);
+        if (g.wifiLinked)
+            appendf(buf, cap, len, "# TYPE brew_wifi_rssi_dbm gauge\nbrew_wifi_rssi_dbm %ld\n", (long)g.rssi);
+        appendf(buf, cap, len, "# TYPE brew_wifi_reconnects_total counter\nbrew_wifi_reconnects_total %lu\n", (unsigned long)g.reconnects);
+        appendf(buf, cap, len, "# TYPE brew_loop_stalls_total counter\nbrew_loop_stalls_total %lu\n", (unsigned long)loopStalls);
+        appendf(buf, cap, len, "# TYPE brew_cpu_mhz gauge\nbrew_cpu_mhz %lu\n", (unsigned long)g.cpuMhz);
+        appendf(buf, cap, len, "# TYPE brew_power_seconds_total counter\n");
+        const char *states[] = {"active", "idle", "waiting"};
+        const uint32_t ms[] = {g.activeMs, g.idleMs, g.waitingMs};
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            appendf(buf, cap, len, "brew_power_seconds_total{state=\"%s\"} ", states[i]);
+            appendSeconds(buf, cap, len, (uint64_t)ms[i] * 1000ULL);
+            appendf(buf, cap, len, "\n");
+        }
+        return len;
+    }
+    if (part == 1)
+    { // Scheduler, then max gauges grouped in one family (Prometheus requires families to be contiguous)
+        appendf(buf, cap, len, "# TYPE brew_sched_tasks gauge\nbrew_sched_tasks %lu\n", (unsigned long)g.schedTasks);
+        appendf(buf, cap, len, "# TYPE brew_sched_runs_total counter\nbrew_sched_runs_total %lu\n", (unsigned long)g.schedRuns);
+        appendf(buf, cap, len, "# TYPE brew_sched_late_max_seconds gauge\nbrew_sched_late_max_seconds ");
+        appendSeconds(buf, cap, len, (uint64_t)g.schedLateMax * 1000ULL);
+        appendf(buf, cap, len, "\n# TYPE brew_sched_late_seconds_total counter\nbrew_sched_late_seconds_total ");
+        appendSeconds(buf, cap, len, g.schedLateSum * 1000ULL);
+        appendf(buf, cap, len, "\n# TYPE brew_sched_skipped_total counter\nbrew_sched_skipped_total %lu\n", (unsigned long)g.schedSkipped);
+        appendf(buf, cap, len, "# TYPE brew_latency_max_seconds gauge\n");
+        for (uint8_t i = 0; i < PERF_OPS; i++)
+        {
+            appendf(buf, cap, len, "brew_latency_max_seconds{op=\"%s\"} ", OP_NAMES[i]);
+            appendSeconds(buf, cap, len, hist[i].maxUs);
+            appendf(buf, cap, len, "\n");
+        }
+        appendf(buf, cap, len, "# TYPE brew_latency_seconds histogram\n");
+        return len;
+    }
+    PerfOp op = (PerfOp)(part - 2);
+    const PerfHistogram &h = hist[op];
+    uint32_t cumulative = 0;
+    for (uint8_t b = 0; b < PERF_BUCKETS; b++)
+    {
+        cumulative += h.buckets[b];
+        appendf(buf, cap, len, "brew_latency_seconds_bucket{op=\"%s\",le=\"%s\"} %lu\n", OP_NAMES[op], BUCKET_LE_S[b], (unsigned long)cumulative);
+    }
+    appendf(buf, cap, len, "brew_latency_seconds_sum{op=\"%s\"} ", OP_NAMES[op]);
+    appendSeconds(buf, cap, len, h.sumUs);
+    appendf(buf, cap, len, "\nbrew_latency_seconds_count{op=\"%s\"} %lu\n", OP_NAMES[op], (unsigned long)cumulative);
+    return len;
+}
+
+size_t perfRender(uint8_t part, bool prometheus, const PerfGauges &g, char *buf, size_t cap)
+{
+    if (part >= PERF_OPS + 2)
+        return 0; // Every part written
+    return prometheus ? renderPrometheus(part, g, buf, cap) : renderJson(part, g, buf, cap);
+}
+
+#endif
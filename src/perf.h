@@ -0,0 +1,100 @@
+/*
+Performance instrumentation for Embedded Brew.
+
+Fixed-bucket latency histograms for the HTTP handlers, loop() iterations and the BMP280 read, plus
+a renderer that emits them (with heap/Wi-Fi gauges supplied by the sketch) as JSON or Prometheus
+text for /debug/perf. Recording is two microsecond timer reads and a ten-entry bucket scan, cheap
+enough to leave on. Build with -DBREW_PERF=0 to strip it: PERF_SCOPE/PERF_RECORD compile to
+nothing and the sketch drops the /debug/perf route.
+
+Every histogram is written from the loop task (handlers, loop() itself and the scheduler's
+sampleFetch() for I2C), so no locking is needed.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef BREW_PERF
+#define BREW_PERF 1 // 0 = compile all instrumentation out
+#endif
+
+enum PerfOp : uint8_t
+{
+    PERF_ROOT,          // handleRoot
+    PERF_METRICS,       // handleMetrics
+    PERF_METRICS_BATCH, // handleMetricsBatch
+    PERF_PRESS,         // handlePress
+    PERF_NOT_FOUND,     // handleNotFound
+    PERF_LOOP,          // One loop() iteration
+    PERF_I2C,           // I2C bus time of one sample (sampleStart() trigger + sampleFetch() burst read)
+    PERF_OPS
+};
+
+const uint8_t PERF_BUCKETS = 10;      // Histogram buckets, the last one is unbounded
+const uint32_t PERF_STALL_US = 50000; // loop() iterations at least this long count as stalls - 50ms
+
+struct PerfHistogram
+{
+    uint32_t count;                 // Samples recorded
+    uint32_t maxUs;                 // Longest sample
+    uint64_t sumUs;                 // Sum of all samples
+    uint32_t buckets[PERF_BUCKETS]; // Samples per bucket (not cumulative)
+};
+
+// Point-in-time values the sketch reads from the platform when /debug/perf is requested
+struct PerfGauges
+{
+    uint32_t uptimeMs;     // millis() at render time
+    uint32_t freeHeap;     // Free heap bytes
+    uint32_t largestBlock; // Largest allocatable block
+    uint32_t minFreeHeap;  // Lowest free heap since boot
+    bool wifiLinked;       // STA connected (rssi valid)
+    int32_t rssi;          // STA signal strength in dBm
+    uint32_t reconnects;   // STA link losses since boot
+    const char *powerMode; // PowerManager mode name
+    uint32_t cpuMhz;       // Current CPU clock
+    uint32_t activeMs;     // Time awake with clients connected
+    uint32_t idleMs;       // Time awake without clients (reduced clock)
+    uint32_t waitingMs;    // Time blocked waiting for sockets/deadlines
+    uint32_t schedTasks;   // Scheduler tasks pending
+    uint32_t schedRuns;    // Scheduler task runs since boot
+    uint32_t schedLateMax; // Worst task lateness in ms
+    uint64_t schedLateSum; // Sum of task lateness in ms
+    uint32_t schedSkipped; // Periods dropped by periodic tasks that fell behind
+};
+
+#if BREW_PERF
+
+uint32_t perfNowUs();                              // Free-running microsecond clock
+void perfRecord(PerfOp op, uint32_t us);           // Add one sample to op's histogram
+const PerfHistogram &perfHistogram(PerfOp op);     // Histogram for op
+uint32_t perfPercentileUs(PerfOp op, uint8_t pct); // Upper bound of the bucket holding pct% (capped at max)
+uint32_t perfLoopStalls();                         // loop() iterations >= PERF_STALL_US
+const char *perfOpName(PerfOp op);                 // Label used in both output formats
+// Render part of the /debug/perf body into buf and return its length, 0 once every part is written.
+// Part 0 holds the gauges, part 1 the bucket bounds (plus the scheduler gauges in Prometheus text),
+// parts 2..PERF_OPS+1 one histogram each, so every part fits a small buffer.
+size_t perfRender(uint8_t part, bool prometheus, const PerfGauges &g, char *buf, size_t cap);
+
+// Times the enclosing scope into op's histogram
+class PerfScope
+{
+public:
+    explicit PerfScope(PerfOp op) : op(op), startUs(perfNowUs()) {}
+    ~PerfScope() { perfRecord(op, perfNowUs() - startUs); }
+
+private:
+    PerfOp op;
+    uint32_t startUs;
+};
+
+#define PERF_SCOPE(op) PerfScope perfScope_(op)
+#define PERF_RECORD(op, us) perfRecord(op, us)
+
+#else
+
+#define PERF_SCOPE(op) ((void)0)
+#define PERF_RECORD(op, us) ((void)0)
+
+#endif
@@ -0,0 +1,94 @@
+#include "power.h"
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+#include <esp_pm.h>
+#include <esp_timer.h>
+#include <sdkconfig.h>
+
+void PowerManager::begin()
+{
+    stateSinceUs = (uint64_t)esp_timer_get_time();
+#if CONFIG_PM_ENABLE
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_pm_config_t cfg = {};
+#else
+    esp_pm_config_esp32c3_t cfg = {};
+#endif
+    cfg.max_freq_mhz = POWER_ACTIVE_MHZ;
+    cfg.min_freq_mhz = POWER_IDLE_MHZ;
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    cfg.light_sleep_enable = true; // Sleeps between DTIM beacons while every task is blocked
+#endif
+    esp_pm_lock_handle_t lock = nullptr;
+    if (esp_pm_configure(&cfg) == ESP_OK && esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "clients", &lock) == ESP_OK)
+    {
+        maxLock = lock;
+        pmMode = cfg.light_sleep_enable ? PowerMode::DfsLightSleep : PowerMode::Dfs;
+        esp_pm_lock_acquire(lock); // Start busy, released once idle
+    }
+#endif
+    Serial.printf("[POWER] Mode %s, %lu/%lu MHz\n", modeName(), (unsigned long)POWER_ACTIVE_MHZ, (unsigned long)POWER_IDLE_MHZ);
+}
+
+void PowerManager::waitBegin()
+{
+    enter(PowerState::Waiting);
+}
+
+void PowerManager::waitEnd(bool clientsActive)
+{
+    uint32_t now = millis();
+    if (clientsActive)
+        lastBusyMs = now;
+    setBusy(clientsActive || now - lastBusyMs < POWER_IDLE_AFTER_MS);
+    enter(busy ? PowerState::Active : PowerState::Idle);
+}
+
+// Switch the clock between active and idle
+void PowerManager::setBusy(bool next)
+{
+    if (next == busy)
+        return;
+    busy = next;
+    if (maxLock)
+    { // DFS: the lock pins the max clock, the PM framework drops it (and sleeps) once released
+        if (busy)
+            esp_pm_lock_acquire((esp_pm_lock_handle_t)maxLock);
+        else
+            esp_pm_lock_release((esp_pm_lock_handle_t)maxLock);
+        mhz = busy ? POWER_ACTIVE_MHZ : POWER_IDLE_MHZ;
+        return;
+    }
+    if (setCpuFrequencyMhz(busy ? POWER_ACTIVE_MHZ : POWER_IDLE_MHZ))
+        mhz = getCpuFrequencyMhz();
+}
+
+void PowerManager::enter(PowerState next)
+{
+    uint64_t now = (uint64_t)esp_timer_get_time();
+    totalUs[(int)state] += now - stateSinceUs;
+    stateSinceUs = now;
+    state = next;
+}
+
+uint32_t PowerManager::timeInMs(PowerState s) const
+{
+    uint64_t us = totalUs[(int)s];
+    if (s == state)
+        us += (uint64_t)esp_timer_get_time() - stateSinceUs; // Include the running stretch
+    return (uint32_t)(us / 1000ULL);
+}
+
+const char *PowerManager::modeName() const
+{
+    switch (pmMode)
+    {
+    case PowerMode::Dfs: return "dfs";
+    case PowerMode::DfsLightSleep: return "dfs+light_sleep";
+    default: return "manual";
+    }
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+Power manager for Embedded Brew.
+
+loop() no longer spins: it blocks in HttpServer::wait() until a socket needs service or the next
+deadline (sensor sample, history, keepalive, Wi-Fi step) is due, and the CPU idles in between.
+On top of that the power manager
+  - uses ESP-IDF power management when the core was built with CONFIG_PM_ENABLE: dynamic frequency
+    scaling, plus automatic light sleep between DTIM beacons when tickless idle is also enabled.
+    A max-frequency lock is held only while clients are connected.
+  - otherwise drops the CPU to POWER_IDLE_MHZ with setCpuFrequencyMhz() when no client has been
+    connected for POWER_IDLE_AFTER_MS, and back to POWER_ACTIVE_MHZ on the next connection.
+Time spent in each state is accounted so the saving can be weighed against request latency
+(/debug/perf reports both).
+*/
+#pragma once
+
+#include <stdint.h>
+
+const uint32_t POWER_ACTIVE_MHZ = 160;     // CPU clock while clients are connected
+const uint32_t POWER_IDLE_MHZ = 80;        // Lowest clock that keeps Wi-Fi running
+const uint32_t POWER_IDLE_AFTER_MS = 2000; // No connections for this long before slowing down
+
+enum class PowerState : uint8_t
+{
+    Active,  // Awake, clients connected, full clock
+    Idle,    // Awake, no clients, reduced clock
+    Waiting, // Blocked until a socket or deadline - CPU in WFI or light sleep
+    Count
+};
+
+enum class PowerMode : uint8_t
+{
+    Manual,        // setCpuFrequencyMhz() from loop()
+    Dfs,           // esp_pm frequency scaling
+    DfsLightSleep, // esp_pm frequency scaling + automatic light sleep
+};
+
+class PowerManager
+{
+public:
+    void begin();                             // Pick the best mode the core supports
+    void waitBegin();                         // loop() is about to block
+    void waitEnd(bool clientsActive);         // loop() woke up, clientsActive = open connections
+    uint32_t timeInMs(PowerState s) const;    // Time spent in s since boot
+    uint32_t cpuMhz() const { return mhz; }   // Current CPU clock
+    PowerMode mode() const { return pmMode; } // Mode chosen by begin()
+    const char *modeName() const;             // "manual", "dfs" or "dfs+light_sleep"
+
+private:
+    void enter(PowerState next);
+    void setBusy(bool busy);
+    PowerMode pmMode = PowerMode::Manual;
+    PowerState state = PowerState::Active;
+    uint64_t stateSinceUs = 0;                     // Start of the running stretch
+    uint64_t totalUs[(int)PowerState::Count] = {}; // Finished stretches per state
+    uint32_t lastBusyMs = 0;                       // Last wake-up with clients connected
+    uint32_t mhz = POWER_ACTIVE_MHZ;               // Current CPU clock
+    bool busy = true;                              // Running at the active clock
+    void *maxLock = nullptr;                       // esp_pm_lock_handle_t when DFS is available
+};
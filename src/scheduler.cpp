@@ -0,0 +1,203 @@
+#include "scheduler.h"
+
+Scheduler::Scheduler()
+{
+    for (uint8_t i = 0; i < SCHED_MAX_TASKS; i++)
+    {
+        tasks[i].gen = 1;
+        tasks[i].pos = NO_POS;
+        freeSlots[i] = (uint8_t)(SCHED_MAX_TASKS - 1 - i); // Slot 0 handed out first
+    }
+}
+
+SchedId Scheduler::at(uint32_t deadlineMs, SchedFn fn, void *ctx)
+{
+    return insert(deadlineMs, 0, fn, ctx);
+}
+
+SchedId Scheduler::after(uint32_t nowMs, uint32_t delayMs, SchedFn fn, void *ctx)
+{
+    if (delayMs > SCHED_MAX_DELAY_MS)
+        delayMs = SCHED_MAX_DELAY_MS;
+    return insert(nowMs + delayMs, 0, fn, ctx);
+}
+
+SchedId Scheduler::every(uint32_t nowMs, uint32_t periodMs, SchedFn fn, void *ctx, uint32_t firstDelayMs)
+{
+    if (periodMs == 0)
+        periodMs = 1; // A zero period would run on every pass
+    if (periodMs > SCHED_MAX_DELAY_MS)
+        periodMs = SCHED_MAX_DELAY_MS;
+    if (firstDelayMs > SCHED_MAX_DELAY_MS)
+        firstDelayMs = periodMs;
+    return insert(nowMs + firstDelayMs, periodMs, fn, ctx);
+}
+
+SchedId Scheduler::insert(uint32_t deadline, uint32_t period, SchedFn fn, void *ctx)
+{
+    if (!fn || count >= SCHED_MAX_TASKS)
+    {
+        if (fn)
+            st.rejected++;
+        return 0;
+    }
+    uint8_t slot = freeSlots[SCHED_MAX_TASKS - 1 - count]; // Top of the free stack
+    Task &t = tasks[slot];
+    t.deadline = deadline;
+    t.period = period;
+    t.seq = nextSeq++;
+    t.fn = fn;
+    t.ctx = ctx;
+    place(count, slot);
+    siftUp(count++);
+    if (count > st.peakTasks)
+        st.peakTasks = count;
+    return (SchedId)(t.gen << 8 | (slot + 1));
+}
+
+int8_t Scheduler::slotOf(SchedId id) const
+{
+    uint8_t slot = (uint8_t)(id & 0xFF);
+    if (slot == 0 || slot > SCHED_MAX_TASKS)
+        return -1;
+    slot--;
+    const Task &t = tasks[slot];
+    return t.pos != NO_POS && t.gen == (uint8_t)(id >> 8) ? (int8_t)slot : -1;
+}
+
+bool Scheduler::cancel(SchedId id)
+{
+    int8_t slot = slotOf(id);
+    if (slot < 0)
+        return false;
+    removeAt(tasks[slot].pos);
+    release((uint8_t)slot);
+    return true;
+}
+
+bool Scheduler::pending(SchedId id) const
+{
+    return slotOf(id) >= 0;
+}
+
+uint8_t Scheduler::run(uint32_t nowMs)
+{
+    uint8_t ran = 0;
+    uint32_t fence = nextSeq; // Tasks armed (or re-armed) by this pass wait for the next one
+    while (count)
+    {
+        uint8_t slot = heap[0];
+        Task &t = tasks[slot];
+        if ((int32_t)(nowMs - t.deadline) < 0 || (int32_t)(t.seq - fence) >= 0)
+            break; // Earliest task not due (or new this pass)
+        uint32_t late = nowMs - t.deadline;
+        st.runs++;
+        st.lateSumMs += late;
+        if (late > st.lateMaxMs)
+            st.lateMaxMs = late;
+        SchedFn fn = t.fn;
+        void *ctx = t.ctx;
+        if (t.period)
+        { // Re-arm before running so the task may cancel itself
+            uint32_t missed = late / t.period;
+            st.skipped += missed;
+            t.deadline += (missed + 1) * t.period; // Same phase, no catch-up burst
+            t.seq = nextSeq++;
+            siftDown(0);
+        }
+        else
+        {
+            removeAt(0);
+            release(slot);
+        }
+        fn(ctx);
+        ran++;
+    }
+    return ran;
+}
+
+bool Scheduler::nextDeadline(uint32_t &deadlineMs) const
+{
+    if (!count)
+        return false;
+    deadlineMs = tasks[heap[0]].deadline;
+    return true;
+}
+
+uint32_t Scheduler::waitMs(uint32_t nowMs, uint32_t maxMs) const
+{
+    uint32_t deadline;
+    if (!nextDeadline(deadline))
+        return maxMs;
+    int32_t d = (int32_t)(deadline - nowMs);
+    if (d <= 0)
+        return 0;
+    return (uint32_t)d < maxMs ? (uint32_t)d : maxMs;
+}
+
+bool Scheduler::before(uint8_t a, uint8_t b) const
+{
+    int32_t d = (int32_t)(tasks[a].deadline - tasks[b].deadline);
+    if (d != 0)
+        return d < 0;
+    return (int32_t)(tasks[a].seq - tasks[b].seq) < 0; // Equal deadlines run in insert order
+}
+
+void Scheduler::place(uint8_t pos, uint8_t slot)
+{
+    heap[pos] = slot;
+    tasks[slot].pos = pos;
+}
+
+void Scheduler::siftUp(uint8_t pos)
+{
+    uint8_t slot = heap[pos];
+    while (pos > 0)
+    {
+        uint8_t parent = (uint8_t)((pos - 1) / 2);
+        if (!before(slot, heap[parent]))
+            break;
+        place(pos, heap[parent]);
+        pos = parent;
+    }
+    place(pos, slot);
+}
+
+void Scheduler::siftDown(uint8_t pos)
+{
+    uint8_t slot = heap[pos];
+    for (;;)
+    {
+        uint8_t child = (uint8_t)(pos * 2 + 1);
+        if (child >= count)
+            break;
+        if (child + 1 < count && before(heap[child + 1], heap[child]))
+            child++;
+        if (!before(heap[child], slot))
+            break;
+        place(pos, heap[child]);
+        pos = child;
+    }
+    place(pos, slot);
+}
+
+void Scheduler::removeAt(uint8_t pos)
+{
+    count--;
+    if (pos == count)
+        return;              // Removed the last leaf
+    place(pos, heap[count]); // Last leaf fills the hole, then moves whichever way it belongs
+    if (pos > 0 && before(heap[pos], heap[(pos - 1) / 2]))
+        siftUp(pos);
+    else
+        siftDown(pos);
+}
+
+void Scheduler::release(uint8_t slot)
+{
+    Task &t = tasks[slot];
+    t.pos = NO_POS;
+    t.fn = nullptr;
+    t.gen = (uint8_t)(t.gen == 255 ? 1 : t.gen + 1); // Stale ids of this slot stop matching
+    freeSlots[SCHED_MAX_TASKS - 1 - count] = slot;   // count already excludes the slot
+}
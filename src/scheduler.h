@@ -0,0 +1,78 @@
+/*
+Deadline scheduler for Embedded Brew.
+
+Every timed job (sensor sampling, history, event pushes and keepalives, Wi-Fi steps, auto-off,
+scheduled brewing) is a task on one binary min-heap ordered by deadline, so loop() only has to
+ask for the next deadline, sleep until then and call run(). Insert and cancel are O(log n),
+the next deadline is O(1). Tasks live in a fixed slot table - no heap allocation.
+
+Deadlines are millis() values compared as wrap-safe signed differences, so the 49.7-day rollover
+is invisible as long as no delay exceeds SCHED_MAX_DELAY_MS. Periodic tasks keep their phase
+(next = deadline + period) and skip missed periods instead of running a burst to catch up.
+Ids carry a per-slot generation, so cancelling a task that already ran is a harmless no-op.
+
+Portable C++ (no Arduino calls) - tools/scheduler_sim.cpp drives it with simulated time.
+*/
+#pragma once
+
+#include <stdint.h>
+
+const uint8_t SCHED_MAX_TASKS = 16;               // Slot table size
+const uint32_t SCHED_MAX_DELAY_MS = 0x7FFFFFFFUL; // Longest delay that still compares correctly (~24.8 days)
+
+typedef void (*SchedFn)(void *ctx); // Task body, runs from loop()
+typedef uint16_t SchedId;           // Generation << 8 | slot + 1 (0 = none)
+
+struct SchedStats
+{
+    uint32_t runs;      // Task runs since boot
+    uint32_t lateMaxMs; // Worst lateness of a run (run time - deadline)
+    uint64_t lateSumMs; // Sum of lateness over all runs
+    uint32_t skipped;   // Periods dropped because a periodic task fell a full period behind
+    uint8_t peakTasks;  // Most tasks pending at once
+    uint32_t rejected;  // Inserts refused because the slot table was full
+};
+
+class Scheduler
+{
+public:
+    Scheduler();
+    SchedId at(uint32_t deadlineMs, SchedFn fn, void *ctx = nullptr);                 // One-shot at an absolute millis() value
+    SchedId after(uint32_t nowMs, uint32_t delayMs, SchedFn fn, void *ctx = nullptr); // One-shot delayMs from now
+    // Periodic, first run after firstDelayMs (defaults to one period) - returns 0 if the table is full
+    SchedId every(uint32_t nowMs, uint32_t periodMs, SchedFn fn, void *ctx = nullptr, uint32_t firstDelayMs = UINT32_MAX);
+    bool cancel(SchedId id);                               // False if id already ran or was cancelled
+    bool pending(SchedId id) const;                        // Task still waiting to run
+    uint8_t run(uint32_t nowMs);                           // Run every due task once, returns how many ran
+    bool nextDeadline(uint32_t &deadlineMs) const;         // Earliest deadline, false if nothing is pending
+    uint32_t waitMs(uint32_t nowMs, uint32_t maxMs) const; // Time until the next deadline, capped at maxMs
+    uint8_t size() const { return count; }                 // Tasks pending
+    const SchedStats &stats() const { return st; }         // Run and jitter counters
+
+private:
+    struct Task
+    {
+        uint32_t deadline; // millis() value of the next run
+        uint32_t period;   // 0 = one-shot
+        uint32_t seq;      // Insert order - breaks deadline ties and fences run()
+        SchedFn fn;
+        void *ctx;
+        uint8_t gen; // Bumped every time the slot is freed (1..255)
+        uint8_t pos; // Index in heap, NO_POS when the slot is free
+    };
+    static const uint8_t NO_POS = 0xFF;
+    SchedId insert(uint32_t deadline, uint32_t period, SchedFn fn, void *ctx);
+    int8_t slotOf(SchedId id) const;         // Slot of a live id, -1 if stale
+    bool before(uint8_t a, uint8_t b) const; // Heap order of two slots
+    void place(uint8_t pos, uint8_t slot);
+    void siftUp(uint8_t pos);
+    void siftDown(uint8_t pos);
+    void removeAt(uint8_t pos);
+    void release(uint8_t slot);
+    Task tasks[SCHED_MAX_TASKS];
+    uint8_t heap[SCHED_MAX_TASKS];      // Slots ordered as a binary min-heap
+    uint8_t freeSlots[SCHED_MAX_TASKS]; // Stack of unused slots (SCHED_MAX_TASKS - count entries)
+    uint8_t count = 0;                  // Entries in heap
+    uint32_t nextSeq = 0;               // Next insert sequence number
+    SchedStats st = {};
+};
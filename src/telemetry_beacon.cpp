@@ -0,0 +1,121 @@
+#include "telemetry_beacon.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#ifdef ARDUINO
+#include <lwip/sockets.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#ifndef MSG_DONTWAIT
+#define MSG_DONTWAIT 0 // Socket is non-blocking anyway
+#endif
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    put16(p, (uint16_t)v);
+    put16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return get16(p) | (uint32_t)get16(p + 2) << 16;
+}
+
+size_t beaconEncode(const BeaconPacket &p, uint8_t *buf, size_t cap)
+{
+    if (cap < BEACON_SIZE)
+        return 0;
+    buf[0] = 'B';
+    buf[1] = 'W';
+    buf[2] = BEACON_VERSION;
+    buf[3] = p.flags;
+    memcpy(buf + 4, p.id, 6);
+    put32(buf + 10, p.seq);
+    put32(buf + 14, p.uptimeMs);
+    put16(buf + 18, (uint16_t)p.tempCenti);
+    put16(buf + 20, p.pressDeci);
+    buf[22] = p.phase;
+    buf[23] = (uint8_t)p.rssi;
+    put16(buf + 24, p.intervalMs);
+    return BEACON_SIZE;
+}
+
+bool beaconDecode(const uint8_t *buf, size_t len, BeaconPacket &out)
+{
+    if (len < BEACON_SIZE || buf[0] != 'B' || buf[1] != 'W' || buf[2] < 1)
+        return false;
+    out.version = buf[2];
+    out.flags = buf[3];
+    memcpy(out.id, buf + 4, 6);
+    out.seq = get32(buf + 10);
+    out.uptimeMs = get32(buf + 14);
+    out.tempCenti = (int16_t)get16(buf + 18);
+    out.pressDeci = get16(buf + 20);
+    out.phase = buf[22];
+    out.rssi = (int8_t)buf[23];
+    out.intervalMs = get16(buf + 24);
+    return true;
+}
+
+bool TelemetryBeacon::begin(const char *group, uint16_t port, const char *iface, uint8_t ttl)
+{
+    end();
+    in_addr addr;
+    if (!inet_aton(group, &addr))
+        return false;
+    fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd < 0)
+        return false;
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK); // A full send queue drops the beacon instead of stalling loop()
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    in_addr ifAddr;
+    if (iface && inet_aton(iface, &ifAddr))
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &ifAddr, sizeof(ifAddr));
+    groupAddr = addr.s_addr;
+    groupPort = port;
+    return true;
+}
+
+bool TelemetryBeacon::send(const BeaconPacket &p)
+{
+    if (fd < 0)
+        return false;
+    uint8_t buf[BEACON_SIZE];
+    size_t len = beaconEncode(p, buf, sizeof(buf));
+    sockaddr_in to = {};
+    to.sin_family = AF_INET;
+    to.sin_port = htons(groupPort);
+    to.sin_addr.s_addr = groupAddr;
+    if (sendto(fd, buf, len, MSG_DONTWAIT, (const sockaddr *)&to, sizeof(to)) != (int)len)
+    {
+        errorCount++;
+        return false;
+    }
+    sentCount++;
+    return true;
+}
+
+void TelemetryBeacon::end()
+{
+    if (fd >= 0)
+        close(fd);
+    fd = -1;
+}
@@ -0,0 +1,76 @@
+/*
+Multicast telemetry beacon for Embedded Brew.
+
+Each controller sends a small fixed-layout UDP datagram to a multicast group at a configurable
+rate, so a fleet can be watched by one listener (tools/brew_aggregator.cpp) instead of discovering
+every device over mDNS and polling it over HTTP. The datagram carries the device id (Wi-Fi MAC),
+a per-boot sequence number (gaps reveal loss), temperature, pressure, brew state and uptime.
+
+Wire format, version 1 - little-endian, BEACON_SIZE bytes:
+
+    0   2  magic 'B' 'W'
+    2   1  version
+    3   1  flags: bit 0 brew on, bit 1 sensor ok, bit 2 STA link up
+    4   6  device id
+    10  4  sequence number (0 at boot)
+    14  4  uptime in ms
+    18  2  temperature in 0.01 C, signed (BEACON_NO_TEMP if unavailable)
+    20  2  pressure in 0.1 hPa (0 if unavailable)
+    22  1  brew phase (BrewPhase)
+    23  1  RSSI in dBm, signed (0 without a STA link)
+    24  2  sender's beacon interval in ms
+
+Later versions may only append fields: a decoder accepts any version >= 1 that is at least
+BEACON_SIZE long and ignores the tail.
+
+Plain BSD sockets only, so the same sender runs on lwIP and on a Linux host.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+const uint8_t BEACON_VERSION = 1;            // Written into every datagram
+const size_t BEACON_SIZE = 26;               // Version 1 datagram length
+const char BEACON_GROUP[] = "239.255.47.10"; // Organisation-local multicast group
+const uint16_t BEACON_PORT = 47810;          // UDP port
+const int16_t BEACON_NO_TEMP = INT16_MIN;    // Temperature when the sensor had no reading
+const uint8_t BEACON_BREW_ON = 1;            // Flag bits
+const uint8_t BEACON_SENSOR_OK = 2;
+const uint8_t BEACON_STA = 4;
+
+struct BeaconPacket
+{
+    uint8_t version;     // Version of the received datagram (encode always writes BEACON_VERSION)
+    uint8_t flags;       // BEACON_BREW_ON | BEACON_SENSOR_OK | BEACON_STA
+    uint8_t id[6];       // Device id (Wi-Fi MAC)
+    uint32_t seq;        // Per-boot sequence number
+    uint32_t uptimeMs;   // Sender uptime
+    int16_t tempCenti;   // Temperature in 0.01 C (BEACON_NO_TEMP if unavailable)
+    uint16_t pressDeci;  // Pressure in 0.1 hPa (0 if unavailable)
+    uint8_t phase;       // BrewPhase
+    int8_t rssi;         // STA signal in dBm (0 if no link)
+    uint16_t intervalMs; // Sender's beacon period
+};
+
+size_t beaconEncode(const BeaconPacket &p, uint8_t *buf, size_t cap);  // Datagram length, 0 if cap is too small
+bool beaconDecode(const uint8_t *buf, size_t len, BeaconPacket &out); // False for foreign or short datagrams
+
+class TelemetryBeacon
+{
+public:
+    // Open the sending socket; iface picks the outgoing interface address (nullptr = default route)
+    bool begin(const char *group = BEACON_GROUP, uint16_t port = BEACON_PORT, const char *iface = nullptr, uint8_t ttl = 1);
+    bool send(const BeaconPacket &p); // Non-blocking send, false if the stack refused it
+    void end();
+    bool active() const { return fd >= 0; }        // Socket open
+    uint32_t sent() const { return sentCount; }    // Datagrams handed to the stack
+    uint32_t errors() const { return errorCount; } // Datagrams the stack refused (no link, buffers full)
+
+private:
+    int fd = -1;
+    uint32_t groupAddr = 0; // Network byte order
+    uint16_t groupPort = 0;
+    uint32_t sentCount = 0;
+    uint32_t errorCount = 0;
+};
@@ -0,0 +1,243 @@
+// Generated by tools/embed_ui.py from ui/index.html - do not edit by hand
+#pragma once
+#include <pgmspace.h>
+
+const char UI_INDEX_ETAG[] = "\"45e9a9bc1c9f16c8\""; // Strong ETag (hash of the gzip body)
+const size_t UI_INDEX_RAW_LEN = 11143; // Uncompressed size in bytes
+const size_t UI_INDEX_GZ_LEN = 3739; // Compressed size in bytes
+const uint8_t UI_INDEX_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x3a, 0xfd, 0x73, 0xdb, 0xc6,
+    0xb1, 0xbf, 0xf3, 0xaf, 0x38, 0x4f, 0xe6, 0xe5, 0x80, 0x08, 0x00, 0x41, 0x52, 0x94, 0x25, 0x92,
+    0xa0, 0x47, 0x4e, 0x95, 0xd4, 0x7d, 0x96, 0xad, 0xb1, 0xec, 0xd7, 0x76, 0xd2, 0x8c, 0xe7, 0x08,
+    0x1c, 0x49, 0x44, 0xf8, 0x1a, 0xe0, 0x48, 0x89, 0x65, 0xfc, 0xbf, 0xbf, 0xdd, 0xfb, 0xc0, 0x07,
+    0x45, 0x29, 0x49, 0xdb, 0xcc, 0x74, 0x3a, 0x1d, 0x5b, 0x24, 0x6e, 0x6f, 0x77, 0x6f, 0xbf, 0x6f,
+    0x97, 0xe4, 0xec, 0x45, 0x94, 0x87, 0x62, 0x57, 0x70, 0xb2, 0x16, 0x69, 0x32, 0xef, 0xcd, 0xf0,
+    0x8d, 0x24, 0x2c, 0x5b, 0x05, 0x94, 0x67, 0x14, 0x01, 0x9c, 0x45, 0xf0, 0x96, 0x72, 0xc1, 0x48,
+    0xb8, 0x66, 0x65, 0xc5, 0x45, 0x40, 0x37, 0x62, 0xe9, 0x9e, 0x53, 0x03, 0xce, 0x58, 0xca, 0x03,
+    0xba, 0x8d, 0xf9, 0x7d, 0x91, 0x97, 0x82, 0x92, 0x30, 0xcf, 0x04, 0xcf, 0x00, 0xed, 0x3e, 0x8e,
+    0xc4, 0x3a, 0x88, 0xf8, 0x36, 0x0e, 0xb9, 0x2b, 0x17, 0x4e, 0x9c, 0xc5, 0x22, 0x66, 0x89, 0x5b,
+    0x85, 0x2c, 0xe1, 0xc1, 0x00, 0x79, 0x88, 0x58, 0x24, 0x7c, 0x7e, 0x95, 0x2e, 0x78, 0x14, 0xf1,
+    0x88, 0xbc, 0x2e, 0xf9, 0x3d, 0xf9, 0x16, 0x58, 0x94, 0x79, 0x42, 0x6e, 0x58, 0xc6, 0x93, 0x59,
+    0x5f, 0xa1, 0xf4, 0x66, 0x95, 0xd8, 0xe1, 0xfb, 0x22, 0x8f, 0x76, 0xfb, 0x94, 0x95, 0xab, 0x38,
+    0x9b, 0xf8, 0xd3, 0x25, 0xe0, 0xba, 0x4b, 0x96, 0xc6, 0xc9, 0x6e, 0x52, 0xed, 0x2a, 0xc1, 0x53,
+    0x77, 0x13, 0x3b, 0x2e, 0x2b, 0x8a, 0x84, 0xbb, 0x0a, 0xe0, 0xdc, 0xf2, 0x55, 0xce, 0xc9, 0xa7,
+    0x37, 0xce, 0x87, 0x7c, 0x91, 0x8b, 0xdc, 0xa9, 0x58, 0x56, 0xb9, 0x15, 0x2f, 0xe3, 0xe5, 0x74,
+    0xc1, 0xc2, 0xbb, 0x55, 0x99, 0x6f, 0xb2, 0x68, 0xf2, 0x95, 0x3f, 0xf6, 0xcf, 0x7c, 0x36, 0x0d,
+    0xf3, 0x24, 0x2f, 0x27, 0x5f, 0xf1, 0x31, 0x7f, 0xc9, 0x17, 0xd3, 0x28, 0xae, 0x8a, 0x84, 0xed,
+    0x26, 0xcb, 0x84, 0x3f, 0x4c, 0x7f, 0xda, 0x54, 0x22, 0x5e, 0xee, 0x5c, 0xad, 0xe3, 0x24, 0x84,
+    0x17, 0x5e, 0x4e, 0x59, 0x12, 0xaf, 0x32, 0x37, 0x86, 0xa3, 0x2a, 0x03, 0x4a, 0xe3, 0xcc, 0x5d,
+    0xf3, 0x78, 0xb5, 0x16, 0x93, 0x81, 0xef, 0x6f, 0xd7, 0xd3, 0x82, 0x45, 0x51, 0x9c, 0xad, 0x26,
+    0x83, 0xb3, 0xe2, 0x61, 0xfa, 0xa5, 0xe7, 0x85, 0xac, 0x8c, 0xf6, 0xed, 0xd3, 0x07, 0x83, 0xc1,
+    0xf9, 0xf0, 0xe5, 0x74, 0x91, 0x97, 0x11, 0x2f, 0xdd, 0x92, 0x45, 0xf1, 0xa6, 0x9a, 0x0c, 0xce,
+    0x01, 0xdb, 0x90, 0x0e, 0x4f, 0x8b, 0x07, 0x32, 0x1c, 0xe2, 0x0b, 0x82, 0x53, 0xf6, 0xa0, 0xcc,
+    0x3a, 0x39, 0x1d, 0xfa, 0xb0, 0x56, 0xcf, 0x70, 0xda, 0xff, 0x00, 0x93, 0x07, 0xb7, 0x5a, 0xb3,
+    0x28, 0xbf, 0x9f, 0xf8, 0x04, 0x79, 0x90, 0xd3, 0x31, 0xbc, 0x94, 0xab, 0x05, 0xb3, 0x7c, 0x07,
+    0xff, 0x79, 0xa7, 0x63, 0xdb, 0xf1, 0x09, 0x32, 0x3b, 0x3f, 0xd8, 0x39, 0xb3, 0x41, 0xbe, 0xf5,
+    0xa0, 0x36, 0x31, 0x01, 0x16, 0xc8, 0x5f, 0x5a, 0xba, 0x8a, 0xff, 0xce, 0x27, 0x03, 0xef, 0xb4,
+    0xe4, 0xa9, 0x31, 0xd4, 0xf2, 0x62, 0xc9, 0x96, 0x8b, 0xa9, 0xe0, 0x0f, 0xc2, 0x95, 0x96, 0x30,
+    0x36, 0x00, 0x2d, 0x2b, 0xc1, 0x44, 0xa5, 0x39, 0xb9, 0x22, 0x2f, 0x26, 0xa7, 0x52, 0x70, 0xb9,
+    0x04, 0x57, 0x88, 0x3c, 0x9d, 0x1c, 0xf0, 0xf6, 0x2e, 0x5a, 0xac, 0xb5, 0x0f, 0x0c, 0x23, 0x52,
+    0x18, 0xa1, 0x50, 0x6e, 0x1f, 0xe1, 0xe9, 0x66, 0xe5, 0xde, 0x97, 0xac, 0xd8, 0xff, 0x1a, 0x3f,
+    0x69, 0xe2, 0x01, 0xda, 0xd1, 0x27, 0xda, 0x11, 0xc0, 0x61, 0x5f, 0xe4, 0x15, 0x04, 0x66, 0x9e,
+    0x4d, 0x4a, 0x9e, 0x30, 0x11, 0x6f, 0xb9, 0x36, 0xe6, 0x39, 0xca, 0xa6, 0xdd, 0x78, 0x36, 0xae,
+    0xf1, 0x5d, 0x19, 0x82, 0x35, 0x11, 0x5b, 0x54, 0x79, 0xb2, 0x11, 0x7c, 0xaa, 0x35, 0xf2, 0xa7,
+    0x09, 0x5f, 0x0a, 0xa9, 0xaa, 0x62, 0xf3, 0xb2, 0xc5, 0x66, 0x8c, 0xe0, 0xb6, 0xdf, 0xa5, 0xf9,
+    0xc6, 0x87, 0x7e, 0x07, 0xe1, 0x88, 0x7a, 0x39, 0xd7, 0x2f, 0xe6, 0xec, 0x35, 0xcb, 0xa2, 0x84,
+    0x1f, 0x39, 0xbd, 0x94, 0xfc, 0x5d, 0xd4, 0x6e, 0x8a, 0xa6, 0x1e, 0x34, 0x02, 0x60, 0xd0, 0x18,
+    0x01, 0x64, 0xec, 0xa8, 0xd3, 0x50, 0x44, 0x02, 0xd4, 0x71, 0x44, 0x0e, 0xc4, 0x90, 0x0a, 0x64,
+    0x79, 0xc6, 0x0f, 0xe4, 0xf2, 0x1b, 0x79, 0x94, 0xfd, 0x21, 0xbf, 0x58, 0x7a, 0x44, 0x18, 0x6d,
+    0xbf, 0xd6, 0xb1, 0xc3, 0xfa, 0x58, 0xc3, 0xec, 0xe2, 0xe2, 0xa2, 0x11, 0x65, 0xd8, 0x88, 0x02,
+    0x49, 0x38, 0x5e, 0x32, 0x83, 0xac, 0x8d, 0x2a, 0x85, 0xc9, 0x0b, 0x16, 0xc6, 0x62, 0x07, 0x16,
+    0x16, 0x25, 0xe4, 0xb0, 0x3a, 0x53, 0x03, 0x89, 0x37, 0x1a, 0x57, 0x84, 0xb3, 0x8a, 0xbb, 0xf9,
+    0x46, 0x38, 0x12, 0x61, 0x99, 0x97, 0x29, 0x81, 0x68, 0x6d, 0xe0, 0xb5, 0xcc, 0x5e, 0x35, 0xd8,
+    0x4b, 0x2d, 0xa5, 0x6d, 0xd1, 0x5e, 0xae, 0xcc, 0xa2, 0x9a, 0x6e, 0x22, 0x9f, 0x20, 0x1c, 0xf8,
+    0x5f, 0x2d, 0x70, 0x84, 0xdd, 0xa2, 0x1c, 0x2a, 0xca, 0x51, 0x43, 0x39, 0x7c, 0x8a, 0xf2, 0x5c,
+    0x53, 0x82, 0xe7, 0xbc, 0x3c, 0x23, 0xda, 0x5e, 0x46, 0x8f, 0xc1, 0xa3, 0x2d, 0x14, 0xeb, 0x28,
+    0x23, 0xdf, 0x3e, 0x82, 0x3b, 0x7c, 0x0e, 0x77, 0xc5, 0x36, 0x2b, 0x5e, 0x3d, 0x9f, 0x18, 0x15,
+    0x08, 0xc2, 0xdd, 0x05, 0x17, 0xf7, 0x9c, 0x67, 0xd3, 0x56, 0x9e, 0xca, 0xe0, 0x59, 0xb1, 0x42,
+    0xa5, 0xa7, 0xe1, 0xb6, 0x47, 0x26, 0x20, 0xf5, 0xe3, 0x5c, 0x6f, 0x25, 0xf0, 0x39, 0x26, 0xb0,
+    0xa1, 0x70, 0xab, 0xed, 0x6a, 0xdf, 0xaa, 0x4c, 0x46, 0x9a, 0x45, 0x92, 0x87, 0x77, 0x12, 0xcb,
+    0x65, 0x65, 0xb8, 0x5f, 0xc6, 0x49, 0xa2, 0x5c, 0x5c, 0x41, 0xe5, 0xbf, 0xe3, 0x93, 0xaf, 0x46,
+    0x2f, 0x4f, 0x07, 0xe3, 0x81, 0x5e, 0xea, 0x3a, 0x77, 0x66, 0x96, 0x49, 0x9c, 0xf1, 0x10, 0x84,
+    0x93, 0x29, 0xa4, 0xb8, 0x88, 0x38, 0xbc, 0xdb, 0x1b, 0xe2, 0xd3, 0xc5, 0x78, 0x7c, 0x36, 0xea,
+    0x12, 0x0f, 0x9f, 0x21, 0xce, 0x38, 0xc7, 0x9c, 0x32, 0xe4, 0xba, 0xec, 0x74, 0xc9, 0xbd, 0x27,
+    0x18, 0xd4, 0x1e, 0x70, 0x73, 0xc8, 0x40, 0x2c, 0x2f, 0xbe, 0x8f, 0x29, 0xe2, 0x77, 0xa3, 0xa9,
+    0xcc, 0xa1, 0x82, 0x71, 0xcb, 0xbd, 0xf0, 0x23, 0xbe, 0xb2, 0xdb, 0xf1, 0xdb, 0x44, 0xaa, 0x37,
+    0x1c, 0x77, 0x23, 0x75, 0xe5, 0x2a, 0xf3, 0x2a, 0xfb, 0x98, 0x2b, 0xe2, 0x79, 0x2d, 0x6b, 0xcb,
+    0x6f, 0x59, 0xb2, 0xe1, 0xed, 0xda, 0x7b, 0x76, 0x50, 0x68, 0xc7, 0x8f, 0x8b, 0x78, 0x4d, 0x9c,
+    0xb0, 0x05, 0x4f, 0xda, 0xc4, 0xfe, 0x23, 0x17, 0x6b, 0xca, 0x8b, 0x90, 0x8d, 0xd8, 0x12, 0x4a,
+    0x9e, 0x00, 0x41, 0x5d, 0x0c, 0x28, 0xbc, 0xab, 0x3c, 0xff, 0x14, 0x50, 0x64, 0x9c, 0x34, 0x36,
+    0xd8, 0x14, 0x05, 0x2f, 0x43, 0xd0, 0x0f, 0xcf, 0x59, 0xc7, 0x95, 0xc8, 0xcb, 0xdd, 0xfe, 0x30,
+    0xe8, 0x8e, 0xdf, 0x23, 0x05, 0x2b, 0xef, 0xda, 0x71, 0x64, 0x8a, 0x32, 0x1a, 0xb9, 0x1b, 0x53,
+    0x9d, 0x1b, 0x7d, 0x31, 0x18, 0x0e, 0xfd, 0x83, 0xb2, 0xa3, 0x6b, 0xa9, 0x64, 0x29, 0x7d, 0x79,
+    0x24, 0xfa, 0x74, 0x09, 0xea, 0x98, 0x76, 0xe0, 0x8d, 0xa7, 0x5b, 0x1e, 0x82, 0xd0, 0x2e, 0x5f,
+    0x2e, 0xe1, 0x01, 0x49, 0x64, 0x2b, 0x03, 0x0a, 0xbb, 0x0a, 0x55, 0x32, 0xe6, 0x59, 0x05, 0x38,
+    0x78, 0x63, 0x6d, 0xaa, 0x67, 0xec, 0x7f, 0xde, 0x31, 0xff, 0xcb, 0xd1, 0xcb, 0xd1, 0x71, 0xdd,
+    0x17, 0x22, 0x73, 0x53, 0x16, 0x67, 0xfb, 0xae, 0x9e, 0x2d, 0x63, 0xb4, 0x4d, 0xd8, 0x6e, 0x18,
+    0x06, 0x03, 0x73, 0x77, 0x3c, 0x53, 0x78, 0xa5, 0xde, 0x52, 0xac, 0x7b, 0x63, 0x53, 0xff, 0x48,
+    0x98, 0x6c, 0x4a, 0x50, 0x6a, 0x52, 0xe4, 0xb1, 0x14, 0xab, 0x6d, 0xe4, 0x21, 0x04, 0x21, 0x64,
+    0x8b, 0xd2, 0xe4, 0x7e, 0x0d, 0x6d, 0x50, 0x5b, 0xea, 0x09, 0x0b, 0xf1, 0x42, 0x3d, 0x5e, 0xa8,
+    0x06, 0xa6, 0xae, 0x86, 0x6b, 0x1e, 0xb9, 0x65, 0x7e, 0xdf, 0xad, 0x56, 0x58, 0x7f, 0x50, 0xfa,
+    0xdf, 0xd0, 0x76, 0xb5, 0x2c, 0xe1, 0x3f, 0x6d, 0x6e, 0x1d, 0xb3, 0xed, 0x93, 0x49, 0x9c, 0x15,
+    0x1b, 0xf1, 0x03, 0x76, 0xc3, 0x81, 0x88, 0x53, 0xfe, 0x63, 0xa7, 0x39, 0xf3, 0x87, 0xfe, 0xd9,
+    0xe0, 0xe5, 0x41, 0xb2, 0x68, 0x03, 0x0e, 0x9a, 0x9b, 0x6b, 0x34, 0x82, 0xa2, 0x75, 0x78, 0x97,
+    0x9f, 0xb5, 0x3c, 0x32, 0x02, 0x5c, 0xdd, 0x77, 0x34, 0x27, 0x2f, 0x36, 0x70, 0xc3, 0x65, 0xdd,
+    0x66, 0x90, 0x0f, 0x2f, 0x46, 0x8b, 0x83, 0x36, 0xa8, 0xed, 0xb0, 0x63, 0x0e, 0x35, 0x87, 0x60,
+    0xab, 0x37, 0xc0, 0x1b, 0xe9, 0xc0, 0x69, 0xf5, 0xa1, 0x8f, 0x43, 0xf3, 0xb4, 0x6b, 0xab, 0x97,
+    0xe3, 0xc7, 0xc6, 0x3a, 0x1a, 0x9b, 0x50, 0xd4, 0xa4, 0xdb, 0x5a, 0xac, 0xce, 0xff, 0x39, 0x56,
+    0x30, 0x3f, 0x44, 0xfc, 0x98, 0xed, 0x9f, 0x36, 0x2a, 0x3a, 0xe0, 0xa8, 0x02, 0x9a, 0x2b, 0xe4,
+    0xe7, 0x5d, 0x1d, 0x58, 0x71, 0x86, 0x29, 0xef, 0xaa, 0x1c, 0x7a, 0xc6, 0x02, 0xed, 0x70, 0xd1,
+    0xd5, 0x40, 0x8a, 0x1d, 0xf1, 0x30, 0x2f, 0x99, 0x2c, 0xdc, 0xd2, 0x11, 0xad, 0x33, 0x26, 0xeb,
+    0x7c, 0x0b, 0xb5, 0xfa, 0x10, 0x0d, 0x94, 0xe0, 0x25, 0x1e, 0x8a, 0xb8, 0x88, 0x27, 0x2d, 0xf6,
+    0xd8, 0x06, 0x4f, 0x57, 0x8a, 0x5a, 0x1b, 0x43, 0x4d, 0xd8, 0xfe, 0xd7, 0x89, 0xd6, 0x10, 0xfc,
+    0x0a, 0xe1, 0x66, 0x7d, 0x3d, 0x61, 0xcd, 0xfa, 0x7a, 0xee, 0xc3, 0x3e, 0x17, 0xe7, 0x3c, 0xc8,
+    0x63, 0x12, 0x26, 0xac, 0xaa, 0x02, 0x8a, 0x73, 0x8b, 0x9c, 0x0c, 0x07, 0xcf, 0x0f, 0x6d, 0xb0,
+    0xdf, 0x9b, 0x45, 0xf1, 0xd6, 0xd0, 0xc9, 0x06, 0x1e, 0x09, 0x0b, 0x12, 0x47, 0x30, 0x43, 0x16,
+    0x98, 0x64, 0x74, 0xfe, 0x49, 0xbe, 0x4f, 0x88, 0xeb, 0xce, 0xfa, 0x45, 0xbd, 0x7b, 0x1f, 0x2f,
+    0xe3, 0x6b, 0x88, 0x03, 0x3a, 0xff, 0x73, 0xec, 0x7e, 0x17, 0x93, 0x14, 0x9e, 0x0f, 0x71, 0x32,
+    0x68, 0x5a, 0xf2, 0xf2, 0x8e, 0xce, 0xdf, 0xa9, 0x87, 0xc3, 0xfd, 0xb8, 0xa0, 0xf3, 0x37, 0x37,
+    0x04, 0x62, 0xa4, 0xe4, 0x55, 0xd5, 0xda, 0x9d, 0x7f, 0x7a, 0x43, 0x0a, 0xb6, 0x02, 0x86, 0x6b,
+    0x21, 0x8a, 0x49, 0xbf, 0xbf, 0x00, 0xf1, 0x3d, 0x88, 0x07, 0x96, 0xf4, 0x15, 0x4a, 0x1f, 0xe4,
+    0xee, 0x4a, 0x6f, 0xc6, 0x0c, 0x3a, 0x97, 0x50, 0xe4, 0x0f, 0x20, 0xda, 0xda, 0xa6, 0x87, 0xea,
+    0x42, 0x83, 0x46, 0x2a, 0x18, 0x71, 0x8f, 0x70, 0xd3, 0x9b, 0xc3, 0xa3, 0x9b, 0x66, 0xbe, 0x78,
+    0x72, 0x53, 0x0d, 0x00, 0xcd, 0xb6, 0x7c, 0x3b, 0x82, 0xab, 0xfa, 0x3f, 0x7a, 0x04, 0x48, 0xd4,
+    0x1d, 0x0f, 0x85, 0xb3, 0xc0, 0x6d, 0x68, 0xd1, 0x3a, 0xdb, 0xd8, 0xb3, 0x51, 0x82, 0x13, 0xfd,
+    0xeb, 0xfc, 0x21, 0xa0, 0x38, 0x00, 0x0e, 0x7d, 0xe8, 0xfc, 0x87, 0xbe, 0xf4, 0x1f, 0x13, 0xeb,
+    0x1a, 0x1d, 0x9b, 0x37, 0x4a, 0xc0, 0x1a, 0xd7, 0x43, 0x9c, 0x12, 0x7d, 0x72, 0x79, 0xee, 0x93,
+    0x73, 0xa4, 0x80, 0x25, 0x5c, 0x3d, 0x12, 0x48, 0x49, 0x1f, 0xe8, 0x9a, 0x33, 0x64, 0xaf, 0x26,
+    0x05, 0xc3, 0xc0, 0xeb, 0x82, 0x29, 0x79, 0x18, 0x04, 0x54, 0x12, 0xed, 0xe0, 0x61, 0x78, 0x0e,
+    0x80, 0xa1, 0x01, 0xc0, 0xc3, 0xe8, 0x4c, 0x71, 0xfb, 0xc7, 0x28, 0xeb, 0x4b, 0x28, 0xa0, 0xa6,
+    0x1f, 0x3b, 0x53, 0x72, 0xc3, 0x9f, 0xfd, 0x2f, 0xe6, 0x3c, 0xfa, 0xbd, 0x38, 0xff, 0x6e, 0x8c,
+    0x7f, 0x37, 0x5b, 0x5c, 0xfc, 0x6e, 0x46, 0x7e, 0xc4, 0xb9, 0xbf, 0x32, 0xec, 0x31, 0x49, 0x31,
+    0xc4, 0xdf, 0xc9, 0xe6, 0x9e, 0x36, 0xc7, 0x65, 0x1a, 0xd0, 0x39, 0x50, 0x3e, 0x74, 0x4e, 0x44,
+    0x11, 0x90, 0x63, 0x18, 0x97, 0x61, 0xd2, 0x92, 0x56, 0x95, 0x6b, 0xe0, 0xf7, 0xa0, 0x91, 0xc3,
+    0x9d, 0x7e, 0x28, 0x03, 0xaa, 0xc3, 0xb3, 0x0f, 0x29, 0xa4, 0x13, 0xcf, 0x88, 0xf1, 0x7f, 0xd8,
+    0x8e, 0xd3, 0x6e, 0xa2, 0xc9, 0x16, 0x9d, 0xce, 0x5d, 0x97, 0x7c, 0x0d, 0x53, 0xc1, 0xf4, 0xdb,
+    0xa7, 0xb2, 0x58, 0xb5, 0xe3, 0x74, 0xfe, 0xf1, 0xea, 0xfa, 0xe6, 0xea, 0xc3, 0xe5, 0xc7, 0x4f,
+    0x1f, 0xae, 0x3a, 0xd9, 0xff, 0x64, 0x8a, 0x17, 0x58, 0xfb, 0xfe, 0x9b, 0xe3, 0xff, 0xcd, 0xf1,
+    0xff, 0xe0, 0x1c, 0x97, 0x31, 0xfe, 0x6f, 0x90, 0xe4, 0x52, 0x8e, 0xe7, 0xb3, 0x7c, 0x7d, 0xc3,
+    0x7e, 0x29, 0xc5, 0x6f, 0x3e, 0x5c, 0xdd, 0xde, 0x3e, 0xce, 0xef, 0xc7, 0x54, 0x7a, 0x7e, 0x3e,
+    0x48, 0x6e, 0x39, 0xd5, 0x1e, 0x24, 0xf6, 0x08, 0x8c, 0x77, 0x06, 0x92, 0xa3, 0x80, 0xbc, 0xdc,
+    0xf2, 0xcb, 0xaa, 0x80, 0xe9, 0xf5, 0x03, 0x36, 0x80, 0xd0, 0x46, 0x41, 0xa7, 0x08, 0xbd, 0x44,
+    0x91, 0x27, 0xbb, 0xda, 0xa2, 0x92, 0xc9, 0x5b, 0x58, 0xd1, 0x0e, 0x5b, 0x39, 0x2c, 0x03, 0x1b,
+    0x1c, 0x27, 0x00, 0x86, 0x46, 0x68, 0xdb, 0xe0, 0x68, 0xc1, 0x82, 0xc2, 0xc7, 0xa1, 0xd5, 0xdc,
+    0x94, 0x9c, 0x68, 0x81, 0xc9, 0x0c, 0x98, 0x65, 0xcd, 0x39, 0x1f, 0x58, 0xb6, 0x92, 0xdd, 0x0c,
+    0x82, 0xe7, 0x07, 0xfa, 0xaa, 0x56, 0x4e, 0x4d, 0xd4, 0xb7, 0x72, 0x6a, 0x69, 0x44, 0x6a, 0x8f,
+    0xd9, 0x94, 0xc8, 0xd6, 0x35, 0xa0, 0xa6, 0xcd, 0x97, 0x0d, 0x30, 0x9d, 0xdf, 0x4a, 0x24, 0xc2,
+    0xcb, 0x12, 0x5e, 0xad, 0xd7, 0xd7, 0x37, 0x43, 0x28, 0x57, 0x59, 0x2e, 0x48, 0xc4, 0x05, 0xd8,
+    0x80, 0x47, 0xb6, 0xea, 0xf8, 0xe4, 0xc7, 0x2f, 0x29, 0x17, 0xeb, 0x1c, 0x8e, 0xbb, 0x79, 0x7f,
+    0xfb, 0x91, 0x12, 0x9c, 0x5b, 0xf3, 0x2c, 0xa0, 0x7d, 0x5d, 0x43, 0x67, 0x72, 0x40, 0x6c, 0x3c,
+    0xfd, 0xbf, 0x7c, 0x07, 0xd1, 0x8a, 0xe3, 0x22, 0xb8, 0x02, 0xda, 0xe0, 0x8c, 0xea, 0xaf, 0x42,
+    0xee, 0x38, 0xf6, 0x6e, 0x6a, 0xa8, 0x93, 0xe8, 0xd8, 0x5f, 0xbe, 0x96, 0xcb, 0x5a, 0x78, 0x33,
+    0x1d, 0x1b, 0x0e, 0xd5, 0x66, 0x91, 0xc6, 0x02, 0xe4, 0x15, 0xac, 0x14, 0xb2, 0x9f, 0x86, 0xc1,
+    0x66, 0xd6, 0x57, 0x4c, 0xc0, 0x28, 0x28, 0x9f, 0x11, 0xd3, 0xe8, 0x6f, 0xe6, 0x47, 0xfa, 0x94,
+    0xe0, 0x12, 0x63, 0x83, 0xad, 0x62, 0xaf, 0x25, 0x3c, 0x4a, 0x73, 0x29, 0xcc, 0xc1, 0xb2, 0x0b,
+    0xd7, 0x82, 0x33, 0x21, 0xeb, 0x35, 0x7a, 0xce, 0x68, 0xab, 0x90, 0x80, 0x4f, 0x78, 0xb7, 0xc8,
+    0x1f, 0x0c, 0x62, 0xc4, 0xe2, 0x04, 0x94, 0x97, 0x71, 0x0d, 0x59, 0x41, 0xe7, 0x44, 0x42, 0x66,
+    0x7d, 0x45, 0xdb, 0x33, 0xca, 0x1f, 0xe8, 0xa6, 0xc5, 0xa9, 0xd5, 0xea, 0xd5, 0x7a, 0x69, 0x37,
+    0x23, 0xc2, 0xa1, 0x97, 0x5b, 0x03, 0x2b, 0xb4, 0xfa, 0x39, 0x41, 0xf1, 0x89, 0xd1, 0x2c, 0x22,
+    0x16, 0x64, 0x2d, 0x2b, 0x89, 0x58, 0x73, 0x82, 0xaa, 0x10, 0x91, 0x93, 0x90, 0x65, 0x21, 0x4f,
+    0xb4, 0x63, 0x5b, 0x81, 0xa9, 0x07, 0x4c, 0x3a, 0x7f, 0xff, 0xf1, 0x92, 0x6c, 0x8a, 0x08, 0x6a,
+    0x0b, 0x61, 0x82, 0xcc, 0x70, 0xe0, 0x9c, 0xf7, 0x15, 0x60, 0xd6, 0x97, 0xab, 0xd9, 0xa2, 0x9c,
+    0xcf, 0x58, 0x9b, 0x10, 0x07, 0x29, 0x4a, 0xd6, 0x25, 0x5f, 0x82, 0x61, 0x15, 0x2e, 0x30, 0x2a,
+    0x78, 0x46, 0x90, 0xdb, 0x27, 0x4d, 0xcc, 0x9a, 0xf8, 0x45, 0xef, 0x62, 0x6a, 0x86, 0x65, 0x5c,
+    0x88, 0x79, 0xaf, 0xdf, 0x27, 0xdf, 0xcb, 0x7b, 0xb9, 0xc4, 0x70, 0xaf, 0x88, 0x05, 0x6f, 0x89,
+    0x5e, 0x11, 0xa8, 0x70, 0x9e, 0x77, 0x72, 0xe1, 0x3b, 0xa4, 0xd8, 0x54, 0xa0, 0x19, 0xc1, 0x51,
+    0x8d, 0xf4, 0xf9, 0x16, 0x8a, 0x50, 0x45, 0xee, 0x63, 0xb8, 0x8c, 0x87, 0xde, 0xb8, 0x82, 0xcc,
+    0x4b, 0xf0, 0xb3, 0x26, 0xb2, 0x64, 0x49, 0x82, 0x13, 0xb2, 0x43, 0xaa, 0x34, 0xcf, 0x05, 0x52,
+    0xa8, 0x72, 0x57, 0xd9, 0xbd, 0x30, 0xcf, 0x2a, 0x41, 0xb0, 0x51, 0xf8, 0x7c, 0xfd, 0xe6, 0x5d,
+    0x30, 0xf4, 0x3d, 0xdf, 0x51, 0xab, 0xcb, 0xbf, 0x04, 0xe7, 0xb8, 0x92, 0x15, 0x46, 0x6e, 0x5e,
+    0xb4, 0xd7, 0xb0, 0x3d, 0xf0, 0x47, 0x08, 0xf8, 0xfe, 0xf2, 0xd3, 0xf7, 0x57, 0x88, 0xf0, 0xf9,
+    0xf2, 0xdd, 0xf7, 0x6f, 0xaf, 0x02, 0x10, 0xcf, 0xc0, 0x2e, 0xff, 0xa2, 0x61, 0x17, 0xfe, 0xb4,
+    0xb7, 0xdc, 0x64, 0x32, 0xd4, 0xd0, 0x4e, 0x69, 0x61, 0x6d, 0x9d, 0x34, 0xce, 0x9c, 0x94, 0x3d,
+    0xd8, 0xfb, 0x92, 0x43, 0xc6, 0x67, 0x64, 0x3b, 0x03, 0xc8, 0x2b, 0xf8, 0x9b, 0x58, 0xdb, 0x39,
+    0x6c, 0xbc, 0x82, 0xbf, 0xc9, 0x16, 0x3f, 0xf1, 0x49, 0xb8, 0x20, 0x60, 0x5c, 0x81, 0xf5, 0xe1,
+    0x12, 0x2d, 0x11, 0x64, 0x9b, 0x24, 0x71, 0x10, 0x74, 0x83, 0xc9, 0xd5, 0xc0, 0x5a, 0xc7, 0x28,
+    0x65, 0xe5, 0x96, 0x05, 0x79, 0xb2, 0xe2, 0x42, 0x12, 0x38, 0x2c, 0x29, 0xd6, 0xcc, 0xde, 0xf7,
+    0xe2, 0xa5, 0x85, 0xeb, 0x20, 0x90, 0x84, 0x3f, 0xff, 0x1c, 0x57, 0xef, 0xd8, 0x3b, 0x09, 0xb2,
+    0x6d, 0x2d, 0x91, 0x22, 0x9b, 0xf6, 0xf4, 0x12, 0xf7, 0x4e, 0x34, 0x2f, 0x57, 0x22, 0x7e, 0x23,
+    0x99, 0x4d, 0x7b, 0x5f, 0x5a, 0xc7, 0x72, 0x10, 0xf3, 0x41, 0x58, 0x71, 0xe4, 0xe0, 0xf4, 0x6c,
+    0xef, 0xb7, 0x10, 0x70, 0x3c, 0x88, 0xf2, 0x70, 0x93, 0x82, 0x83, 0x3c, 0xa0, 0xbd, 0x4a, 0x38,
+    0x3e, 0xbe, 0xde, 0xbd, 0x89, 0x00, 0xcd, 0x9e, 0x82, 0x24, 0xdc, 0xe6, 0x1e, 0xa2, 0x7f, 0xab,
+    0xbf, 0x0e, 0xc5, 0xe7, 0x69, 0x8b, 0xab, 0x8a, 0xa1, 0xef, 0xca, 0x3c, 0xbd, 0xe6, 0xa2, 0x8c,
+    0xc3, 0xca, 0x82, 0xb5, 0xd6, 0x02, 0x9f, 0x3c, 0x35, 0x21, 0xdb, 0xe6, 0x74, 0x33, 0x31, 0x3b,
+    0xd4, 0x8c, 0xcc, 0xf4, 0xa4, 0x8d, 0x37, 0xad, 0x09, 0x71, 0x78, 0xfe, 0x8c, 0x13, 0x73, 0x43,
+    0x5b, 0xcf, 0xd3, 0x0e, 0x6d, 0x0f, 0xd4, 0x9a, 0x43, 0x43, 0xd0, 0x30, 0xd1, 0xd3, 0x75, 0xc3,
+    0xc2, 0x8c, 0xdb, 0x0e, 0xad, 0xe7, 0x6d, 0x4d, 0x6e, 0x50, 0x1b, 0xe2, 0xb8, 0x68, 0xe8, 0x60,
+    0x0c, 0x77, 0x68, 0x7b, 0x0e, 0xd7, 0x54, 0x80, 0x33, 0xed, 0xa1, 0x25, 0x55, 0x1d, 0x7f, 0x7f,
+    0x17, 0xbc, 0x78, 0x21, 0x37, 0xd4, 0xfa, 0x73, 0x7e, 0xd7, 0xde, 0xbe, 0xae, 0x56, 0x4f, 0x1a,
+    0xbc, 0x7b, 0x3d, 0x28, 0x31, 0x6a, 0x2a, 0x7b, 0x5f, 0x3f, 0x7a, 0xf2, 0x8a, 0xf0, 0xf4, 0x0d,
+    0x11, 0x98, 0x73, 0x5f, 0xa9, 0x2b, 0x70, 0x42, 0xe5, 0x47, 0x42, 0x14, 0x7c, 0x54, 0xd3, 0xbf,
+    0xbf, 0x03, 0x7f, 0xa0, 0x10, 0x22, 0x90, 0xa2, 0x61, 0x1b, 0xff, 0x39, 0x9c, 0x22, 0xa4, 0x50,
+    0x10, 0x79, 0x13, 0xc0, 0xe5, 0xf6, 0x79, 0x5d, 0x30, 0x25, 0xaf, 0xd8, 0x3e, 0x2d, 0x68, 0x33,
+    0x06, 0x68, 0xdd, 0x8b, 0x67, 0x90, 0x5b, 0xed, 0x84, 0xd2, 0x49, 0x6c, 0xed, 0xbd, 0xd8, 0x7a,
+    0x71, 0x96, 0xf1, 0xf2, 0x8f, 0x1f, 0xaf, 0xdf, 0x06, 0x96, 0x78, 0x21, 0x23, 0xfd, 0x15, 0x11,
+    0x9e, 0xc8, 0xbf, 0x8b, 0x1f, 0x78, 0x64, 0x0d, 0xec, 0x13, 0xaa, 0x87, 0x09, 0x50, 0xa9, 0x1e,
+    0x2c, 0xa8, 0xad, 0xf4, 0x2a, 0x80, 0x47, 0xb1, 0xed, 0x04, 0xa6, 0x55, 0x18, 0x2e, 0x45, 0x97,
+    0x0b, 0x34, 0x2b, 0x8a, 0x05, 0x3e, 0x20, 0xbd, 0x54, 0x2f, 0x7b, 0x5e, 0x3d, 0xdd, 0x87, 0x69,
+    0x89, 0x33, 0xf2, 0xf5, 0xd7, 0x44, 0x4b, 0x69, 0x4c, 0x99, 0x81, 0x4e, 0x81, 0xaa, 0x18, 0xc2,
+    0x31, 0x75, 0xaa, 0x2e, 0x51, 0xda, 0x30, 0x22, 0x7b, 0x87, 0x2d, 0xa0, 0x25, 0xb1, 0x5d, 0x83,
+    0x65, 0xf7, 0x2d, 0x83, 0xd7, 0xc0, 0x0c, 0x01, 0xd4, 0x85, 0xe0, 0xa0, 0x72, 0x9d, 0x58, 0x07,
+    0x65, 0xcb, 0x3d, 0x40, 0xb0, 0xbf, 0x51, 0x07, 0x4d, 0x7b, 0x8a, 0xbe, 0x53, 0x61, 0x10, 0xe2,
+    0x74, 0x8a, 0x94, 0xe3, 0x7b, 0xa3, 0x31, 0x1c, 0xd8, 0xad, 0x5c, 0x12, 0x11, 0x39, 0xe8, 0x00,
+    0x7b, 0xdc, 0xc1, 0xd2, 0x13, 0x89, 0x73, 0x42, 0xf1, 0xab, 0x1f, 0xaa, 0x2d, 0x59, 0x64, 0xbf,
+    0xe0, 0xfb, 0x8e, 0x29, 0x0b, 0x69, 0xca, 0xa2, 0x63, 0xca, 0xa2, 0x65, 0xca, 0xa2, 0x29, 0xeb,
+    0x4d, 0x41, 0x37, 0x51, 0xa6, 0x8d, 0x29, 0xf1, 0xdd, 0x1a, 0x0f, 0xac, 0x59, 0x63, 0xb6, 0xa0,
+    0x86, 0xe6, 0x1f, 0xb3, 0x67, 0xa1, 0xed, 0x59, 0x3c, 0xb2, 0x67, 0x51, 0xdb, 0xb3, 0xa9, 0xf0,
+    0x6d, 0x83, 0xb6, 0xea, 0x7e, 0xa1, 0x2c, 0x5a, 0x3c, 0x67, 0xd1, 0xa2, 0x6b, 0x51, 0x19, 0xdd,
+    0xb2, 0xb7, 0xf9, 0x0c, 0x6d, 0x0c, 0x89, 0x33, 0x22, 0xcb, 0x69, 0x5d, 0x86, 0xda, 0xbd, 0x85,
+    0x23, 0x53, 0x57, 0xe3, 0xbe, 0xa2, 0xaf, 0xbb, 0x1d, 0x05, 0x9c, 0x63, 0x6a, 0x94, 0x46, 0x39,
+    0xb1, 0x9a, 0x95, 0x6c, 0x74, 0x5e, 0x51, 0xd5, 0xf0, 0x40, 0x7a, 0x50, 0x7b, 0x42, 0x7f, 0x4b,
+    0x57, 0x62, 0x32, 0x3f, 0xdd, 0x3c, 0x53, 0xd0, 0xf0, 0xe3, 0x44, 0x8d, 0xb7, 0x78, 0x2e, 0xe1,
+    0x5a, 0x8d, 0x65, 0xab, 0xfa, 0x4a, 0x39, 0xf3, 0x4c, 0x5d, 0x25, 0xc0, 0xca, 0xc6, 0x2f, 0x8d,
+    0x65, 0x2b, 0xf3, 0x16, 0x3a, 0x70, 0x0f, 0x0a, 0xb1, 0x45, 0x6b, 0x0a, 0xe0, 0x6f, 0xc3, 0x5f,
+    0xa7, 0x22, 0xd0, 0x8f, 0x78, 0x37, 0xbe, 0x5f, 0x2e, 0x29, 0xdc, 0x83, 0x3c, 0xa9, 0xf8, 0x13,
+    0x9c, 0x4a, 0x9e, 0x42, 0xa3, 0xf2, 0x4b, 0xcc, 0x3a, 0x2d, 0x2d, 0x72, 0x6c, 0xdf, 0xad, 0xd8,
+    0xd1, 0x98, 0xfb, 0x0f, 0x04, 0x5e, 0x72, 0x11, 0xae, 0x2d, 0xda, 0x4f, 0x15, 0x88, 0xda, 0x1e,
+    0x98, 0x30, 0xb3, 0x0c, 0xba, 0x55, 0xd6, 0xad, 0x45, 0xe9, 0xfd, 0x54, 0x01, 0x00, 0xca, 0x92,
+    0xc6, 0x79, 0x74, 0x9f, 0xda, 0xf8, 0x1b, 0x1b, 0x64, 0x57, 0x53, 0x73, 0x7b, 0x8f, 0xdd, 0x51,
+    0x0e, 0x7d, 0x17, 0xe4, 0x92, 0x7e, 0xf4, 0xee, 0x59, 0x99, 0x1d, 0xae, 0xc1, 0x05, 0x8a, 0x89,
+    0x9a, 0x1c, 0xa8, 0xc3, 0xf1, 0xa0, 0x4e, 0x57, 0x90, 0xe4, 0x2c, 0xfa, 0xa3, 0x9a, 0x68, 0xda,
+    0x92, 0xeb, 0x21, 0xe7, 0x55, 0x25, 0x78, 0x11, 0xc0, 0xd0, 0xf5, 0x1b, 0x34, 0x68, 0x70, 0xf2,
+    0xfb, 0xca, 0xa4, 0x38, 0x0c, 0x5a, 0xb8, 0xf4, 0x96, 0x71, 0x02, 0xf3, 0xe8, 0x51, 0x3e, 0x3f,
+    0x0c, 0x7e, 0x54, 0x65, 0x41, 0x8a, 0x88, 0x54, 0x38, 0xa7, 0x3d, 0x73, 0x5d, 0xd6, 0xd3, 0x9d,
+    0xf2, 0xda, 0x0b, 0x44, 0xff, 0xf9, 0x67, 0x38, 0xca, 0x4b, 0x78, 0xb6, 0x12, 0xeb, 0xd9, 0x50,
+    0xb7, 0x4b, 0xba, 0xb4, 0xfa, 0x01, 0xec, 0xfd, 0xe0, 0xff, 0x08, 0xff, 0x1d, 0x31, 0x90, 0x8b,
+    0x06, 0xd9, 0x1d, 0x48, 0x78, 0x92, 0x07, 0x6f, 0xb2, 0x25, 0xfe, 0xbe, 0x6b, 0xe7, 0xac, 0xe3,
+    0xc0, 0x35, 0x0b, 0xc8, 0x62, 0x40, 0x85, 0x9c, 0xba, 0x62, 0x6d, 0x57, 0x80, 0xf8, 0x40, 0x71,
+    0xcd, 0xc4, 0xda, 0x83, 0xf6, 0xd0, 0x4a, 0x72, 0x07, 0xd5, 0xb0, 0xa7, 0x40, 0xaa, 0x80, 0xec,
+    0xc1, 0x5a, 0xc7, 0x1a, 0xf8, 0x45, 0xc9, 0xb9, 0x8e, 0xdd, 0x24, 0x9f, 0x0d, 0xec, 0xfd, 0x3a,
+    0x3e, 0x09, 0x7c, 0x6f, 0x3c, 0x4d, 0x72, 0x57, 0xbe, 0x43, 0x3b, 0x09, 0x1a, 0x40, 0xe3, 0x20,
+    0x2e, 0x05, 0x78, 0x0d, 0xa6, 0x0b, 0x08, 0x4a, 0x35, 0xa5, 0x52, 0x07, 0x8f, 0x4f, 0x59, 0xd1,
+    0x39, 0xda, 0xb4, 0x7f, 0x96, 0x55, 0x82, 0xec, 0xae, 0xf0, 0xed, 0x7e, 0x7d, 0xea, 0x00, 0x54,
+    0x44, 0xc8, 0x37, 0x30, 0x35, 0xdb, 0x9d, 0x0b, 0xd1, 0xa1, 0x27, 0xd6, 0xf8, 0xdc, 0xb5, 0x50,
+    0x28, 0x90, 0x04, 0xca, 0xa7, 0x94, 0xc8, 0xfe, 0x66, 0x7c, 0xd6, 0x46, 0x84, 0x28, 0xb1, 0xbd,
+    0x9f, 0xe0, 0x74, 0x8b, 0x12, 0x6a, 0xc3, 0xb2, 0xa9, 0x41, 0xcd, 0xb8, 0xeb, 0x50, 0x28, 0x61,
+    0x49, 0xde, 0xbd, 0x70, 0x5d, 0xa8, 0x3b, 0xeb, 0xb8, 0x0b, 0xfb, 0xdb, 0xc6, 0xf7, 0x17, 0xfe,
+    0xb7, 0xb2, 0x6e, 0x00, 0xdf, 0x7f, 0x22, 0xa2, 0xcd, 0xf8, 0x7d, 0x18, 0xd1, 0xd8, 0x8a, 0x63,
+    0x1a, 0x7e, 0x84, 0x42, 0x55, 0x3e, 0x6a, 0xb9, 0x31, 0x79, 0x6f, 0xd4, 0xd8, 0x01, 0x61, 0x8e,
+    0xd1, 0x52, 0xe3, 0x42, 0x27, 0xd1, 0xce, 0xde, 0x69, 0xc3, 0x04, 0x34, 0x7e, 0x83, 0x1f, 0x9f,
+    0xc0, 0x80, 0x68, 0xb5, 0x70, 0x9c, 0xe1, 0xd8, 0xc7, 0x9f, 0xa6, 0xb4, 0x7b, 0x6b, 0x91, 0x17,
+    0x1d, 0xf6, 0x2d, 0xee, 0xb2, 0x86, 0x76, 0xf8, 0xa8, 0x8d, 0xe9, 0x81, 0xb4, 0x5d, 0x7e, 0x20,
+    0xef, 0x95, 0x9c, 0x9b, 0x2c, 0x55, 0x00, 0x5f, 0x40, 0xd9, 0x89, 0xf2, 0x7b, 0x4f, 0x02, 0x6f,
+    0xf3, 0x4d, 0x19, 0x82, 0xd1, 0xba, 0x6a, 0x4d, 0x75, 0xb4, 0xab, 0x7b, 0x99, 0x57, 0x41, 0x06,
+    0xc5, 0xbc, 0x85, 0x0f, 0x69, 0xad, 0x46, 0x31, 0x74, 0x02, 0xaf, 0xbc, 0x3c, 0xcb, 0x61, 0xf0,
+    0x0b, 0x5a, 0xb2, 0x6b, 0x70, 0x0a, 0x37, 0x18, 0x5b, 0xf1, 0xa0, 0xed, 0x1f, 0x51, 0xee, 0xf6,
+    0x8f, 0x7b, 0xfd, 0x3f, 0xdd, 0xbe, 0x7f, 0xe7, 0x15, 0xf8, 0x7b, 0x4a, 0x0b, 0x3a, 0x52, 0xbc,
+    0xa9, 0xc0, 0x2e, 0xca, 0xb9, 0xe0, 0x1f, 0x7b, 0xff, 0xe5, 0x8b, 0x66, 0x29, 0xbd, 0x15, 0xb4,
+    0xe5, 0x9d, 0x12, 0x98, 0x25, 0x5b, 0xd2, 0x91, 0x12, 0x79, 0xc2, 0x48, 0xb9, 0xd8, 0x91, 0x58,
+    0x54, 0x3c, 0x59, 0x3a, 0xf5, 0xa0, 0x18, 0xe2, 0x20, 0x59, 0xc9, 0x7b, 0x68, 0xc5, 0x0a, 0x02,
+    0x37, 0x1b, 0x03, 0xf4, 0xe5, 0xa6, 0x82, 0x3b, 0xaa, 0x12, 0x25, 0x67, 0x29, 0x04, 0x40, 0x5d,
+    0x28, 0xe0, 0x66, 0x90, 0x7c, 0xb1, 0xb8, 0x73, 0x38, 0xd9, 0xa2, 0x7f, 0x78, 0x7f, 0xad, 0xeb,
+    0xf8, 0x5b, 0x28, 0x77, 0x3c, 0xa2, 0x4e, 0xad, 0x1a, 0x58, 0x17, 0xe4, 0x78, 0x9f, 0x71, 0x72,
+    0xc7, 0x77, 0xa4, 0x80, 0x79, 0x15, 0xbf, 0x53, 0x93, 0x65, 0x71, 0x02, 0xa7, 0x44, 0xf9, 0x66,
+    0x21, 0x3f, 0x4f, 0x8b, 0xc3, 0x3b, 0x73, 0xae, 0xfa, 0x20, 0x40, 0xa8, 0x3b, 0x36, 0x05, 0x40,
+    0xc1, 0xf1, 0x47, 0x7d, 0xb1, 0x20, 0x2c, 0x8b, 0xe4, 0xa7, 0x53, 0x15, 0xa8, 0x91, 0x67, 0xc9,
+    0x0e, 0x5e, 0x42, 0x2e, 0xbd, 0x01, 0xcc, 0x7f, 0xa1, 0x4d, 0xc2, 0xcf, 0x61, 0x54, 0x81, 0x00,
+    0x5c, 0x1b, 0xfe, 0x3c, 0xf5, 0xb9, 0xc4, 0x1f, 0xc0, 0xe4, 0x5e, 0x96, 0xdf, 0x5b, 0x98, 0x9c,
+    0xb7, 0x60, 0x22, 0x70, 0xf5, 0xe8, 0xcc, 0x3e, 0x91, 0x99, 0x0e, 0x0d, 0x45, 0x94, 0xa7, 0x07,
+    0x5b, 0x5e, 0x05, 0xd2, 0x72, 0x6b, 0xe8, 0x0c, 0x20, 0x4a, 0x7b, 0xdd, 0xe0, 0xee, 0x75, 0x22,
+    0x0b, 0x3a, 0x96, 0x76, 0xf9, 0x97, 0x39, 0x5e, 0x47, 0x6a, 0x6b, 0xcb, 0x39, 0xf3, 0x7d, 0x0c,
+    0xf9, 0x1e, 0xa6, 0xda, 0xac, 0x6f, 0x3e, 0x0c, 0x98, 0xf5, 0xf5, 0x17, 0xab, 0x7d, 0xf9, 0xbb,
+    0xdb, 0xff, 0x07, 0xaf, 0x87, 0x1c, 0x65, 0x87, 0x2b, 0x00, 0x00,
+};
@@ -0,0 +1,109 @@
+/*
+Host-side check: BMP280 integer compensation (src/bmp280.cpp) vs the datasheet double-precision path.
+
+Build and run from the repository root:
+
+    g++ -O2 -std=c++17 -Isrc tools/bmp280_compare.cpp src/bmp280.cpp -o bmp280_compare && ./bmp280_compare
+
+Runs the datasheet worked example, then sweeps raw ADC values covering roughly 0-100 C and
+850-1100 hPa, and reports the largest difference between the two paths and the cost per sample.
+Exits non-zero if the integer path is off by more than 0.01 C or 1 Pa.
+*/
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "bmp280.h"
+
+// Datasheet section 8.1 reference implementation
+static double floatTemp(const Bmp280Calib &c, int32_t adcT, double &tFine)
+{
+    double var1 = (adcT / 16384.0 - c.t1 / 1024.0) * c.t2;
+    double var2 = (adcT / 131072.0 - c.t1 / 8192.0) * (adcT / 131072.0 - c.t1 / 8192.0) * c.t3;
+    tFine = var1 + var2;
+    return (var1 + var2) / 5120.0;
+}
+
+static double floatPress(const Bmp280Calib &c, int32_t adcP, double tFine)
+{
+    double var1 = tFine / 2.0 - 64000.0;
+    double var2 = var1 * var1 * c.p6 / 32768.0;
+    var2 = var2 + var1 * c.p5 * 2.0;
+    var2 = var2 / 4.0 + c.p4 * 65536.0;
+    var1 = (c.p3 * var1 * var1 / 524288.0 + c.p2 * var1) / 524288.0;
+    var1 = (1.0 + var1 / 32768.0) * c.p1;
+    if (var1 == 0.0)
+        return 0;
+    double p = 1048576.0 - adcP;
+    p = (p - var2 / 4096.0) * 6250.0 / var1;
+    var1 = c.p9 * p * p / 2147483648.0;
+    var2 = p * c.p8 / 32768.0;
+    return p + (var1 + var2 + c.p7) / 16.0;
+}
+
+int main()
+{
+    // Trim values from the datasheet example (section 3.12)
+    Bmp280Calib cal = {27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000};
+
+    int32_t tFine;
+    int32_t t = bmp280CompensateTemp(cal, 519888, tFine);
+    uint32_t p = bmp280CompensatePress(cal, 415148, tFine);
+    printf("datasheet example: %.2f C, %.2f Pa (expected 25.08 C, ~100653.27 Pa)\n", t / 100.0, p / 256.0);
+
+    std::vector<int32_t> adcT, adcP;
+    for (int32_t v = 420000; v <= 620000; v += 2000)
+        adcT.push_back(v);
+    for (int32_t v = 250000; v <= 480000; v += 2300)
+        adcP.push_back(v);
+
+    double maxTempErr = 0, maxPressErr = 0;
+    size_t checked = 0;
+    for (int32_t at : adcT)
+    {
+        for (int32_t ap : adcP)
+        {
+            double tf;
+            double ft = floatTemp(cal, at, tf);
+            double fp = floatPress(cal, ap, tf);
+            if (ft < 0 || ft > 100 || fp < 85000 || fp > 110000)
+                continue; // Outside the range the pot can see
+            int32_t it = bmp280CompensateTemp(cal, at, tFine);
+            uint32_t ip = bmp280CompensatePress(cal, ap, tFine);
+            maxTempErr = fmax(maxTempErr, fabs(it / 100.0 - ft));
+            maxPressErr = fmax(maxPressErr, fabs(ip / 256.0 - fp));
+            checked++;
+        }
+    }
+    printf("%zu samples: max |int - float| %.4f C, %.3f Pa\n", checked, maxTempErr, maxPressErr);
+
+    const int ROUNDS = 200;
+    volatile uint32_t sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++)
+        for (int32_t at : adcT)
+            for (int32_t ap : adcP)
+            {
+                int32_t tf;
+                sink = sink + (uint32_t)bmp280CompensateTemp(cal, at, tf) + bmp280CompensatePress(cal, ap, tf);
+            }
+    auto t1 = std::chrono::steady_clock::now();
+    volatile double fsink = 0;
+    for (int r = 0; r < ROUNDS; r++)
+        for (int32_t at : adcT)
+            for (int32_t ap : adcP)
+            {
+                double tf;
+                fsink = fsink + floatTemp(cal, at, tf) + floatPress(cal, ap, tf);
+            }
+    auto t2 = std::chrono::steady_clock::now();
+    double n = (double)ROUNDS * adcT.size() * adcP.size();
+    printf("integer %.1f ns/sample, double %.1f ns/sample (host; the ESP32-C3 has no FPU, so double is emulated there)\n",
+           std::chrono::duration<double, std::nano>(t1 - t0).count() / n,
+           std::chrono::duration<double, std::nano>(t2 - t1).count() / n);
+
+    bool ok = maxTempErr <= 0.01 && maxPressErr <= 1.0 && t == 2508;
+    printf("%s\n", ok ? "OK" : "MISMATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,541 @@
+/*
+Fleet aggregator for Embedded Brew telemetry beacons (src/telemetry_beacon.h) - Linux host tool.
+
+Joins the beacon multicast group, keeps the latest reading of every device it hears from, counts
+lost, late and duplicated datagrams from the sequence numbers, notices reboots, and serves the
+combined view as JSON on GET /devices. A table is printed every few seconds.
+
+Build and run from the repository root:
+
+    g++ -O2 -std=c++17 -pthread -Isrc tools/brew_aggregator.cpp src/telemetry_beacon.cpp \
+        src/http_server.cpp src/brew_detector.cpp -o brew_aggregator
+    ./brew_aggregator [--iface ADDR] [--http PORT] [--print S]
+    ./brew_aggregator --simulate 50 --rate 5000 --loss 2 --seconds 10
+
+--simulate N runs N fake devices on a sender thread over loopback multicast (127.0.0.1) through
+the firmware's own TelemetryBeacon, at --rate datagrams per second in total. --loss, --reorder
+and --dup inject drops, swapped pairs and duplicates; every device reboots once half way through.
+At the end each device's counters are checked against what was sent: received + lost must equal
+the datagrams sent, lost must cover every injected drop (the kernel may add its own), and
+duplicates and reboots must match exactly. Exits non-zero on a mismatch.
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "brew_detector.h"
+#include "http_server.h"
+#include "json_writer.h"
+#include "telemetry_beacon.h"
+
+const uint32_t SEQ_WINDOW = 64;         // Reordering tolerated before a datagram counts as stale
+const uint32_t OFFLINE_INTERVALS = 5;   // Missed beacon periods before a device shows as offline
+const int RCVBUF_BYTES = 4 * 1024 * 1024; // Room for bursts of thousands of datagrams
+
+struct Device
+{
+    uint8_t id[6];
+    uint32_t ip = 0;             // Sender address (network byte order)
+    BeaconPacket last = {};      // Newest datagram (highest seq)
+    uint32_t highest = 0;        // Highest seq of the current boot
+    uint64_t window = 0;         // Bit n set: seq highest - n received
+    uint32_t uptimeAt[SEQ_WINDOW]; // Uptime carried by each seq in the window, tells duplicates from reboots
+    uint32_t received = 0;       // Distinct datagrams
+    uint32_t lost = 0;           // Sequence gaps not (yet) filled
+    uint32_t late = 0;           // Arrived after a higher seq, filling a gap
+    uint32_t duplicates = 0;     // Same seq and uptime seen again
+    uint32_t stale = 0;          // Older than the window, ignored
+    uint32_t restarts = 0;       // Reboots seen (seq and uptime went back)
+    uint64_t lastSeenMs = 0;     // Aggregator clock at the newest datagram
+};
+
+static std::vector<Device> devices;
+static std::unordered_map<uint64_t, size_t> deviceIndex; // 48-bit id -> devices[]
+static uint64_t datagrams = 0;                           // All datagrams received
+static uint64_t foreign = 0;                             // Datagrams that were not beacons
+
+static uint64_t nowMs()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static uint64_t idKey(const uint8_t *id)
+{
+    uint64_t k = 0;
+    for (int i = 0; i < 6; i++)
+        k = k << 8 | id[i];
+    return k;
+}
+
+static void idText(const uint8_t *id, char *buf, size_t len)
+{
+    snprintf(buf, len, "%02x:%02x:%02x:%02x:%02x:%02x", id[0], id[1], id[2], id[3], id[4], id[5]);
+}
+
+// Start counting a new boot from this datagram
+static void startBoot(Device &d, const BeaconPacket &p)
+{
+    d.highest = p.seq;
+    d.window = 1;
+    d.uptimeAt[p.seq % SEQ_WINDOW] = p.uptimeMs;
+    d.last = p;
+    d.received++;
+}
+
+// Account one datagram against the device's sequence window
+static void track(Device &d, const BeaconPacket &p)
+{
+    if (p.seq > d.highest)
+    {
+        uint32_t step = p.seq - d.highest;
+        d.lost += step - 1;
+        d.window = step >= SEQ_WINDOW ? 1 : d.window << step | 1;
+        d.highest = p.seq;
+        d.uptimeAt[p.seq % SEQ_WINDOW] = p.uptimeMs;
+        d.last = p;
+        d.received++;
+        return;
+    }
+    uint32_t back = d.highest - p.seq;
+    bool inWindow = back < SEQ_WINDOW;
+    if (inWindow && (d.window >> back & 1) && d.uptimeAt[p.seq % SEQ_WINDOW] == p.uptimeMs)
+    {
+        d.duplicates++;
+        return;
+    }
+    if (p.uptimeMs < d.last.uptimeMs && (!inWindow || (d.window >> back & 1)))
+    {
+        // Seq went back beyond any plausible reordering, or repeats with a different uptime
+        d.restarts++;
+        d.lost += p.seq; // Seqs of the new boot before this one (a reboot starts at 0)
+        startBoot(d, p);
+        return;
+    }
+    if (!inWindow)
+    {
+        d.stale++;
+        return;
+    }
+    d.window |= 1ULL << back;
+    d.uptimeAt[p.seq % SEQ_WINDOW] = p.uptimeMs;
+    if (d.lost)
+        d.lost--;
+    d.late++;
+    d.received++;
+}
+
+static void onDatagram(const uint8_t *buf, size_t len, uint32_t fromIp)
+{
+    datagrams++;
+    BeaconPacket p;
+    if (!beaconDecode(buf, len, p))
+    {
+        foreign++;
+        return;
+    }
+    uint64_t key = idKey(p.id);
+    auto it = deviceIndex.find(key);
+    if (it == deviceIndex.end())
+    {
+        deviceIndex[key] = devices.size();
+        devices.emplace_back();
+        Device &d = devices.back();
+        memcpy(d.id, p.id, 6);
+        startBoot(d, p);
+        d.ip = fromIp;
+        d.lastSeenMs = nowMs();
+        return;
+    }
+    Device &d = devices[it->second];
+    track(d, p);
+    d.ip = fromIp;
+    d.lastSeenMs = nowMs();
+}
+
+static int openReceiver(const char *group, uint16_t port, const char *iface)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd < 0)
+        return -1;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)); // Several listeners on one host
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &RCVBUF_BYTES, sizeof(RCVBUF_BYTES));
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    ip_mreq mreq = {};
+    inet_aton(group, &mreq.imr_multiaddr);
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+    if (iface)
+        inet_aton(iface, &mreq.imr_interface);
+    if (bind(fd, (sockaddr *)&addr, sizeof(addr)) < 0 ||
+        setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)
+    {
+        perror("[AGG] receiver");
+        close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+// Read every datagram already queued, waiting up to waitMs for the first
+static void drain(int fd, uint32_t waitMs)
+{
+    fd_set rd;
+    FD_ZERO(&rd);
+    FD_SET(fd, &rd);
+    timeval tv = {(time_t)(waitMs / 1000), (suseconds_t)(waitMs % 1000) * 1000};
+    if (select(fd + 1, &rd, nullptr, nullptr, &tv) <= 0)
+        return;
+    uint8_t buf[512];
+    for (int i = 0; i < 4096; i++) // Bounded so HTTP clients are still served under a flood
+    {
+        sockaddr_in from;
+        socklen_t fromLen = sizeof(from);
+        ssize_t n = recvfrom(fd, buf, sizeof(buf), 0, (sockaddr *)&from, &fromLen);
+        if (n < 0)
+            return;
+        onDatagram(buf, (size_t)n, from.sin_addr.s_addr);
+    }
+}
+
+/*------- Combined view -------*/
+static void writeDevice(JsonWriter &w, const Device &d, uint64_t now)
+{
+    char id[18];
+    idText(d.id, id, sizeof(id));
+    const BeaconPacket &p = d.last;
+    uint32_t age = (uint32_t)(now - d.lastSeenMs);
+    uint32_t total = d.received + d.lost;
+    const uint8_t *ip = (const uint8_t *)&d.ip;
+    w.beginObject();
+    w.key("id").str(id);
+    w.key("ip").ipv4(ip[0], ip[1], ip[2], ip[3]);
+    w.key("online").boolean(age < OFFLINE_INTERVALS * std::max<uint32_t>(p.intervalMs, 100));
+    w.key("age_ms").number(age);
+    w.key("version").number(p.version);
+    w.key("seq").number(p.seq);
+    w.key("uptime").uptime(p.uptimeMs);
+    w.key("interval_ms").number(p.intervalMs);
+    w.key("temp_c");
+    if (p.tempCenti == BEACON_NO_TEMP)
+        w.null();
+    else
+        w.fixed<2>(p.tempCenti / 100.0f);
+    w.key("pressure_hpa");
+    if (!p.pressDeci)
+        w.null();
+    else
+        w.fixed<1>(p.pressDeci / 10.0f);
+    w.key("sensor_ok").boolean(p.flags & BEACON_SENSOR_OK);
+    w.key("brew_on").boolean(p.flags & BEACON_BREW_ON);
+    w.key("phase").str(brewPhaseName((BrewPhase)p.phase));
+    w.key("rssi").integer(p.rssi);
+    w.key("received").number(d.received);
+    w.key("lost").number(d.lost);
+    w.key("loss_pct").fixed<2>(total ? 100.0f * d.lost / total : 0.0f);
+    w.key("late").number(d.late);
+    w.key("duplicates").number(d.duplicates);
+    w.key("restarts").number(d.restarts);
+    w.endObject();
+}
+
+// One device per chunk; cursor is the next device, arg0 is set once the closing part is written
+static size_t devicesChunk(HttpStreamState &st, char *buf, size_t cap)
+{
+    if (st.arg0)
+        return 0;
+    int n = snprintf(buf, cap, "%s", st.cursor ? "," : "{\"devices\":[");
+    if (st.cursor < devices.size())
+    {
+        JsonWriter w(buf + n, cap - n);
+        writeDevice(w, devices[st.cursor], nowMs());
+        st.cursor++;
+        return n + w.length();
+    }
+    if (st.cursor)
+        n = 0; // No comma before the closing bracket
+    n += snprintf(buf + n, cap - n, "],\"datagrams\":%llu,\"foreign\":%llu}", (unsigned long long)datagrams,
+                  (unsigned long long)foreign);
+    st.arg0 = 1;
+    return (size_t)n;
+}
+
+static void handleDevices(const HttpRequest &, HttpResponse &res)
+{
+    HttpStreamState st = {};
+    res.header("Cache-Control", "no-store");
+    res.sendChunked(200, "application/json", devicesChunk, st);
+}
+
+static void printTable()
+{
+    uint64_t now = nowMs();
+    printf("%-17s %-15s %9s %7s %7s %8s %6s %5s %4s %5s %-9s\n", "device", "ip", "seq", "temp", "hPa", "received",
+           "lost", "late", "dup", "boots", "phase");
+    for (const Device &d : devices)
+    {
+        char id[18], ip[16];
+        idText(d.id, id, sizeof(id));
+        inet_ntop(AF_INET, &d.ip, ip, sizeof(ip));
+        const BeaconPacket &p = d.last;
+        bool online = now - d.lastSeenMs < OFFLINE_INTERVALS * std::max<uint32_t>(p.intervalMs, 100);
+        printf("%-17s %-15s %9u %7.2f %7.1f %8u %6u %5u %4u %5u %-9s%s\n", id, ip, p.seq,
+               p.tempCenti == BEACON_NO_TEMP ? 0.0 : p.tempCenti / 100.0, p.pressDeci / 10.0, d.received, d.lost,
+               d.late, d.duplicates, d.restarts + 1, brewPhaseName((BrewPhase)p.phase), online ? "" : " offline");
+    }
+    printf("%zu devices, %llu datagrams, %llu foreign\n\n", devices.size(), (unsigned long long)datagrams,
+           (unsigned long long)foreign);
+}
+
+/*------- Simulated devices -------*/
+struct SimDevice
+{
+    BeaconPacket p;
+    uint32_t sent = 0;     // Datagrams put on the wire (duplicates not counted)
+    uint32_t dropped = 0;  // Seqs skipped on purpose
+    uint32_t dups = 0;     // Datagrams sent twice
+    uint32_t reboots = 0;
+    bool held = false;     // Datagram held back for a reorder
+    BeaconPacket heldPacket;
+};
+
+struct SimConfig
+{
+    uint32_t devices = 0;
+    uint32_t rate = 1000;  // Datagrams per second, all devices together
+    double lossPct = 0;
+    double reorderPct = 0;
+    double dupPct = 0;
+    uint32_t seconds = 5;
+};
+
+static std::vector<SimDevice> sims;
+static std::atomic<bool> simDone(false);
+
+static void simulate(SimConfig cfg)
+{
+    TelemetryBeacon tx;
+    if (!tx.begin(BEACON_GROUP, BEACON_PORT, "127.0.0.1"))
+    {
+        perror("[SIM] beacon");
+        simDone = true;
+        return;
+    }
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> pct(0.0, 100.0);
+    uint32_t perDevice = (uint32_t)((uint64_t)cfg.rate * cfg.seconds / cfg.devices);
+    uint16_t intervalMs = (uint16_t)std::min<uint64_t>(65535, 1000ULL * cfg.devices / cfg.rate);
+    for (uint32_t i = 0; i < cfg.devices; i++)
+    {
+        BeaconPacket &p = sims[i].p;
+        p = {};
+        uint8_t id[6] = {0x02, 0xB5, 0xE7, (uint8_t)(i >> 16), (uint8_t)(i >> 8), (uint8_t)i}; // Locally administered
+        memcpy(p.id, id, 6);
+        p.uptimeMs = 1000 + (uint32_t)(rng() % 100000);
+        p.intervalMs = intervalMs;
+        p.flags = BEACON_SENSOR_OK | BEACON_STA;
+        p.rssi = -(int8_t)(40 + i % 40);
+        p.pressDeci = 10132;
+        p.tempCenti = (int16_t)(2100 + i);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t total = (uint64_t)perDevice * cfg.devices, done = 0;
+    for (uint32_t round = 0; round < perDevice; round++)
+    {
+        bool last = round == perDevice - 1;
+        bool rebootBefore = round == perDevice / 2;
+        bool quiet = !round || last || round == perDevice / 2 - 1; // First and last seq of a boot always go out
+        for (uint32_t i = 0; i < cfg.devices; i++)
+        {
+            SimDevice &s = sims[i];
+            BeaconPacket &p = s.p;
+            if (rebootBefore)
+            {
+                p.seq = 0;
+                p.uptimeMs = 800 + (uint32_t)(rng() % 400);
+                s.reboots++;
+            }
+            p.uptimeMs += p.intervalMs;
+            p.tempCenti = (int16_t)(p.tempCenti + (int)(rng() % 5) - 2);
+            bool drop = !quiet && pct(rng) < cfg.lossPct;
+            if (drop)
+                s.dropped++;
+            else if (!quiet && !s.held && pct(rng) < cfg.reorderPct)
+            {
+                s.heldPacket = p; // Goes out after the next one
+                s.held = true;
+            }
+            else
+            {
+                tx.send(p);
+                s.sent++;
+                if (s.held)
+                {
+                    tx.send(s.heldPacket);
+                    s.sent++;
+                    s.held = false;
+                }
+                if (pct(rng) < cfg.dupPct)
+                {
+                    tx.send(p);
+                    s.dups++;
+                }
+            }
+            p.seq++;
+            done++;
+        }
+        // Pace to the requested rate in 1 ms steps
+        auto due = start + std::chrono::microseconds(done * 1000000 / cfg.rate);
+        if (done % std::max<uint32_t>(cfg.rate / 1000, 1) == 0 || done == total)
+            std::this_thread::sleep_until(due);
+    }
+    if (tx.errors())
+        printf("[SIM] %u datagrams refused by the stack\n", tx.errors());
+    simDone = true;
+}
+
+static int checkSimulation()
+{
+    int failures = 0;
+    uint64_t sent = 0, dropped = 0, lost = 0, kernelLost = 0, late = 0;
+    for (uint32_t i = 0; i < sims.size(); i++)
+    {
+        const SimDevice &s = sims[i];
+        sent += s.sent;
+        dropped += s.dropped;
+        auto it = deviceIndex.find(idKey(s.p.id));
+        if (it == deviceIndex.end())
+        {
+            printf("   FAIL: device %u never heard\n", i);
+            failures++;
+            continue;
+        }
+        const Device &d = devices[it->second];
+        lost += d.lost;
+        late += d.late;
+        kernelLost += d.lost - std::min(d.lost, s.dropped);
+        uint32_t seqs = s.sent + s.dropped;
+        bool ok = d.received + d.lost == seqs && d.lost >= s.dropped && d.restarts == s.reboots &&
+                  d.stale == 0 && (d.lost > s.dropped || d.duplicates == s.dups);
+        if (!ok && failures++ < 20)
+            printf("   FAIL: device %u: received %u + lost %u != %u seqs, or lost < %u dropped, or dups %u != %u, "
+                   "or restarts %u != %u, stale %u\n",
+                   i, d.received, d.lost, seqs, s.dropped, d.duplicates, s.dups, d.restarts, s.reboots, d.stale);
+    }
+    printf("== %zu devices, %llu datagrams sent, %llu dropped on purpose\n", sims.size(), (unsigned long long)sent,
+           (unsigned long long)dropped);
+    printf("   detected lost %llu (%llu by the kernel), late %llu, foreign %llu\n", (unsigned long long)lost,
+           (unsigned long long)kernelLost, (unsigned long long)late, (unsigned long long)foreign);
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *iface = nullptr;
+    uint16_t httpPort = 8047;
+    uint32_t printS = 5;
+    SimConfig sim;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *a = argv[i];
+        const char *v = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!v)
+        {
+            fprintf(stderr, "usage: %s [--iface ADDR] [--http PORT] [--print S] [--simulate N --rate PPS "
+                            "--loss PCT --reorder PCT --dup PCT --seconds S]\n", argv[0]);
+            return 2;
+        }
+        i++;
+        if (!strcmp(a, "--iface"))
+            iface = v;
+        else if (!strcmp(a, "--http"))
+            httpPort = (uint16_t)atoi(v);
+        else if (!strcmp(a, "--print"))
+            printS = (uint32_t)atoi(v);
+        else if (!strcmp(a, "--simulate"))
+            sim.devices = (uint32_t)atoi(v);
+        else if (!strcmp(a, "--rate"))
+            sim.rate = std::max(1, atoi(v));
+        else if (!strcmp(a, "--loss"))
+            sim.lossPct = atof(v);
+        else if (!strcmp(a, "--reorder"))
+            sim.reorderPct = atof(v);
+        else if (!strcmp(a, "--dup"))
+            sim.dupPct = atof(v);
+        else if (!strcmp(a, "--seconds"))
+            sim.seconds = std::max(1, atoi(v));
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", a);
+            return 2;
+        }
+    }
+    if (sim.devices && !iface)
+        iface = "127.0.0.1";
+
+    int fd = openReceiver(BEACON_GROUP, BEACON_PORT, iface);
+    if (fd < 0)
+        return 1;
+    static HttpServer server(httpPort); // Connection buffers are too big for the stack
+    server.on("/devices", (uint8_t)HttpMethod::Get | (uint8_t)HttpMethod::Head, handleDevices);
+    if (!server.begin())
+        printf("[AGG] HTTP port %u unavailable, no /devices\n", httpPort);
+    else
+        printf("[AGG] listening on %s:%u, view on http://localhost:%u/devices\n", BEACON_GROUP, BEACON_PORT, httpPort);
+
+    std::thread sender;
+    if (sim.devices)
+    {
+        sims.resize(sim.devices);
+        sender = std::thread(simulate, sim);
+    }
+    uint64_t nextPrint = nowMs() + printS * 1000, quietUntil = 0;
+    for (;;)
+    {
+        drain(fd, 5);
+        server.poll(0);
+        uint64_t now = nowMs();
+        if (printS && now >= nextPrint)
+        {
+            if (devices.size() <= 40)
+                printTable();
+            else
+                printf("%zu devices, %llu datagrams\n", devices.size(), (unsigned long long)datagrams);
+            nextPrint = now + printS * 1000;
+        }
+        if (sim.devices && simDone)
+        {
+            if (!quietUntil)
+                quietUntil = now + 300; // Let the last datagrams arrive
+            else if (now >= quietUntil)
+                break;
+        }
+    }
+    sender.join();
+    close(fd);
+    if (sim.devices <= 40)
+        printTable();
+    return checkSimulation();
+}
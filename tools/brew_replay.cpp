@@ -0,0 +1,259 @@
+/*
+Host-side replay harness: runs temperature traces through the brew phase detector (src/brew_detector.cpp)
+and scores how quickly it follows the labelled phases.
+
+Build and run from the repository root:
+
+    g++ -O2 -std=c++17 -Isrc tools/brew_replay.cpp src/brew_detector.cpp -o brew_replay
+    ./brew_replay --synthetic          # generated brew cycle with known phases
+    ./brew_replay trace.csv ...        # recorded traces
+    curl -s 'http://brew.local/history' > h.json && ./brew_replay h.json
+
+Trace formats:
+    CSV   one sample per line: t_s,temp_c[,phase]  (phase = idle|heating|brewing|keep_warm|cooled,
+          lines starting with '#' or a letter are skipped)
+    JSON  the /history array of [ts, temp_c, pressure_hpa, brew_on] rows (no phase labels)
+
+Prints every detected transition. For labelled traces it also prints the detection latency of each
+labelled transition (time until the detector first reports the new phase, "missed" if it never
+does before the next label change), the share of samples where detector and label agree, and
+when the auto-off press would be allowed (keepWarmSteady): on how much of the labelled keep-warm, and
+how long into a labelled switch-off it still reads as steady (filter lag - seconds, not the ~95 s
+the detector takes to report cooled).
+*/
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "brew_detector.h"
+
+struct TraceSample
+{
+    uint32_t ms;
+    float tempC;
+    int label; // BrewPhase as int, -1 = unlabelled
+};
+
+static int parsePhase(const char *s)
+{
+    for (int p = 0; p <= (int)BrewPhase::Cooled; p++)
+        if (strncmp(s, brewPhaseName((BrewPhase)p), strlen(brewPhaseName((BrewPhase)p))) == 0)
+            return p;
+    return -1;
+}
+
+static bool loadCsv(FILE *f, std::vector<TraceSample> &out)
+{
+    char line[256];
+    while (fgets(line, sizeof(line), f))
+    {
+        char *p = line;
+        while (*p == ' ' || *p == '\t')
+            p++;
+        if (*p == '#' || !(isdigit((unsigned char)*p) || *p == '-' || *p == '.'))
+            continue;
+        char *end;
+        double t = strtod(p, &end);
+        if (*end != ',')
+            continue;
+        double temp = strtod(end + 1, &end);
+        int label = -1;
+        if (*end == ',')
+        {
+            end++;
+            while (*end == ' ')
+                end++;
+            label = parsePhase(end);
+        }
+        out.push_back({(uint32_t)llround(t * 1000.0), (float)temp, label});
+    }
+    return !out.empty();
+}
+
+// Rows of the /history array: [ts, temp_c|null, pressure_hpa|null, brew_on]
+static bool loadHistoryJson(FILE *f, std::vector<TraceSample> &out)
+{
+    std::string text;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        text.append(buf, n);
+    const char *p = text.c_str();
+    while ((p = strchr(p, '[')) != nullptr)
+    {
+        p++;
+        if (*p == '[')
+            continue; // Outer array
+        char *end;
+        double ts = strtod(p, &end);
+        if (end == p || *end != ',')
+            continue;
+        p = end + 1;
+        if (strncmp(p, "null", 4) == 0)
+            continue; // No sensor reading
+        double temp = strtod(p, &end);
+        out.push_back({(uint32_t)(ts * 1000.0), (float)temp, -1});
+        p = end;
+    }
+    return !out.empty();
+}
+
+// One labelled brew cycle: idle, switch on, brew, keep-warm with plate cycling, switch off, cool down
+static void synthetic(std::vector<TraceSample> &out, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> noise(0.0f, 0.05f);
+    const float AMBIENT = 22.0f;
+    const uint32_t ON = 600, BREW = 690, WARM = 1140, OFF = 3540, END = 7200; // Seconds
+    float temp = AMBIENT;
+    for (uint32_t t = 0; t < END; t++)
+    {
+        BrewPhase label;
+        if (t < ON)
+        {
+            label = BrewPhase::Idle;
+        }
+        else if (t < WARM)
+        { // Heater full on, sensor approaches 70 C
+            label = t < BREW ? BrewPhase::Heating : BrewPhase::Brewing;
+            temp += (70.0f - temp) / 240.0f;
+        }
+        else if (t < OFF)
+        { // Warming plate cycles around 55 C with a 4 minute period
+            label = BrewPhase::KeepWarm;
+            float target = 55.0f + 1.0f * sinf((t - WARM) * 6.2832f / 240.0f);
+            temp += (target - temp) / 120.0f;
+        }
+        else
+        {
+            temp += (AMBIENT - temp) / 900.0f;
+            label = temp - AMBIENT > BREW_IDLE_RISE_C ? BrewPhase::Cooled : BrewPhase::Idle;
+        }
+        out.push_back({t * 1000, temp + noise(rng), (int)label});
+    }
+}
+
+static void replay(const char *name, const std::vector<TraceSample> &trace)
+{
+    printf("== %s (%zu samples, %.1f min)\n", name, trace.size(), (trace.back().ms - trace.front().ms) / 60000.0);
+    BrewDetector det;
+    BrewPhase last = det.phase();
+    size_t agree = 0, labelled = 0;
+    int pendingLabel = -1;    // Labelled phase the detector has not reached yet
+    uint32_t pendingMs = 0;   // When that label started
+    int prevLabel = -1;
+    double latencySum = 0, latencyMax = 0;
+    int detected = 0, missed = 0;
+    size_t warmSamples = 0, warmSteady = 0, offSteady = 0; // keepWarmSteady() on labelled keep-warm / after it
+    uint32_t offMs = 0;                                    // Start of the labelled switch-off (0 = none yet)
+    double offSteadyMax = 0;                               // Latest steady sample after it, seconds in
+    for (const TraceSample &s : trace)
+    {
+        if (s.label >= 0 && s.label != prevLabel)
+        { // New labelled phase - score the previous one if still pending
+            if (pendingLabel >= 0 && prevLabel >= 0)
+            {
+                printf("   %-9s at %7.1f s: missed\n", brewPhaseName((BrewPhase)pendingLabel), pendingMs / 1000.0);
+                missed++;
+            }
+            pendingLabel = prevLabel >= 0 ? s.label : -1; // The initial phase is not a transition
+            pendingMs = s.ms;
+            prevLabel = s.label;
+        }
+        det.update(s.ms, s.tempC);
+        if (det.phase() != last)
+        {
+            printf("%9.1f s  %-9s -> %-9s  temp %.2f  base %.2f  slope %+.2f C/min\n", s.ms / 1000.0,
+                   brewPhaseName(last), brewPhaseName(det.phase()), det.smoothedC(), det.baselineC(), det.slopePerMin());
+            last = det.phase();
+        }
+        if (pendingLabel >= 0 && (int)det.phase() == pendingLabel)
+        {
+            double lat = (s.ms - pendingMs) / 1000.0;
+            printf("   %-9s at %7.1f s: detected after %.1f s\n", brewPhaseName((BrewPhase)pendingLabel), pendingMs / 1000.0, lat);
+            latencySum += lat;
+            latencyMax = lat > latencyMax ? lat : latencyMax;
+            detected++;
+            pendingLabel = -1;
+        }
+        if (s.label >= 0)
+        {
+            labelled++;
+            agree += (int)det.phase() == s.label;
+            bool steady = det.keepWarmSteady(s.ms);
+            if (s.label == (int)BrewPhase::KeepWarm)
+            {
+                warmSamples++;
+                warmSteady += steady;
+                offMs = 0;
+            }
+            else if (s.label == (int)BrewPhase::Cooled && warmSamples)
+            {
+                if (!offMs)
+                    offMs = s.ms | 1;
+                if (steady)
+                {
+                    offSteady++;
+                    offSteadyMax = (s.ms - offMs) / 1000.0;
+                }
+            }
+        }
+    }
+    if (pendingLabel >= 0)
+    {
+        printf("   %-9s at %7.1f s: missed\n", brewPhaseName((BrewPhase)pendingLabel), pendingMs / 1000.0);
+        missed++;
+    }
+    if (labelled)
+    {
+        printf("   transitions: %d detected, %d missed, latency mean %.1f s, max %.1f s\n", detected, missed,
+               detected ? latencySum / detected : 0.0, latencyMax);
+        printf("   phase agreement: %.1f%% of %zu labelled samples\n", 100.0 * agree / labelled, labelled);
+        if (warmSamples)
+            printf("   auto-off allowed on %.1f%% of keep-warm samples, on %zu after switch-off (last %.1f s in)\n",
+                   100.0 * warmSteady / warmSamples, offSteady, offSteadyMax);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s --synthetic [seed] | trace.csv|history.json ...\n", argv[0]);
+        return 2;
+    }
+    if (strcmp(argv[1], "--synthetic") == 0)
+    {
+        std::vector<TraceSample> trace;
+        synthetic(trace, argc > 2 ? (unsigned)atoi(argv[2]) : 1);
+        replay("synthetic", trace);
+        return 0;
+    }
+    for (int i = 1; i < argc; i++)
+    {
+        FILE *f = fopen(argv[i], "r");
+        if (!f)
+        {
+            perror(argv[i]);
+            return 1;
+        }
+        int first = fgetc(f);
+        while (first == ' ' || first == '\n' || first == '\r' || first == '\t')
+            first = fgetc(f);
+        ungetc(first, f);
+        std::vector<TraceSample> trace;
+        bool ok = first == '[' ? loadHistoryJson(f, trace) : loadCsv(f, trace);
+        fclose(f);
+        if (!ok)
+        {
+            fprintf(stderr, "%s: no samples\n", argv[i]);
+            return 1;
+        }
+        replay(argv[i], trace);
+    }
+    return 0;
+}
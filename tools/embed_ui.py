@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""
+Embed the static control panel (ui/index.html) as a gzip-compressed PROGMEM blob.
+
+Writes src/ui_index.h with the compressed bytes and a strong ETag derived from their hash.
+Run it by hand after editing the UI, or add it to platformio.ini as a pre-build step:
+
+    extra_scripts = pre:tools/embed_ui.py
+"""
+import gzip
+import hashlib
+import os
+
+
+def project_root():
+    if "__file__" in globals():
+        return os.path.abspath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+    return os.getcwd()  # PlatformIO runs extra scripts from the project directory
+
+
+def minify(html):
+    # Drop indentation and blank lines - the UI is written one statement per line
+    return "\n".join(line.strip() for line in html.splitlines() if line.strip())
+
+
+def embed(root):
+    src = os.path.join(root, "ui", "index.html")
+    out = os.path.join(root, "src", "ui_index.h")
+    with open(src, "r", encoding="utf-8") as f:
+        raw = minify(f.read()).encode("utf-8")
+    gz = gzip.compress(raw, compresslevel=9, mtime=0)  # mtime=0 keeps the output reproducible
+    etag = hashlib.sha256(gz).hexdigest()[:16]
+    lines = [
+        "// Generated by tools/embed_ui.py from ui/index.html - do not edit by hand",
+        "#pragma once",
+        "#include <pgmspace.h>",
+        "",
+        "const char UI_INDEX_ETAG[] = \"\\\"%s\\\"\"; // Strong ETag (hash of the gzip body)" % etag,
+        "const size_t UI_INDEX_RAW_LEN = %d; // Uncompressed size in bytes" % len(raw),
+        "const size_t UI_INDEX_GZ_LEN = %d; // Compressed size in bytes" % len(gz),
+        "const uint8_t UI_INDEX_GZ[] PROGMEM = {",
+    ]
+    for i in range(0, len(gz), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in gz[i:i + 16]) + ",")
+    lines.append("};")
+    text = "\n".join(lines) + "\n"
+    old = open(out, "r", encoding="utf-8").read() if os.path.exists(out) else None
+    if old != text:  # Only touch the header when the UI changed to avoid needless rebuilds
+        with open(out, "w", encoding="utf-8") as f:
+            f.write(text)
+    print("[UI] %s: %d bytes -> %d bytes gzip, ETag %s" % (os.path.relpath(out, root), len(raw), len(gz), etag))
+
+
+if __name__ == "__main__":
+    embed(project_root())
+else:
+    try:  # Loaded by PlatformIO as an extra_script
+        Import("env")  # noqa: F821
+        embed(env["PROJECT_DIR"])  # noqa: F821
+    except NameError:
+        pass
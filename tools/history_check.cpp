@@ -0,0 +1,141 @@
+/*
+Host-side check for the telemetry history ring (src/history.cpp).
+
+Build and run from the repository root:
+
+    g++ -O2 -std=c++17 -Isrc tools/history_check.cpp src/history.cpp -o history_check
+    ./history_check [seed]
+
+Two scenarios:
+    rollover   samples timestamped the way recordHistory() does (esp_timer seconds), starting two
+               minutes before the point where millis() / 1000 wraps after 49.7 days - every sample
+               must be readable with ?since= right after it was appended, across the wrap
+    roundtrip  random readings through the delta encoding and block eviction, read back with and
+               without a step and compared with what was appended
+
+Exits non-zero if any check fails.
+*/
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "history.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                     \
+    do                                       \
+    {                                        \
+        if (!(cond))                         \
+        {                                    \
+            printf("   FAIL: " __VA_ARGS__); \
+            printf("\n");                    \
+            failures++;                      \
+        }                                    \
+    } while (0)
+
+static TelemetryHistory history; // 4 KB of blocks - static like the firmware's
+
+// Append every 10 s across the millis() rollover and read each sample back as a ?since= poller would
+static void rollover()
+{
+    printf("== rollover\n");
+    const uint64_t WRAP_US = 4294967296ULL * 1000ULL; // millis() wraps here
+    const uint64_t START_US = WRAP_US - 120ULL * 1000000ULL;
+    const uint32_t SPAN_S = 2 * 3600;
+    history = TelemetryHistory();
+    uint32_t unread = 0, poll = 0;
+    TelemetryHistory::Sample rows[16];
+    for (uint32_t t = 0; t <= SPAN_S; t += 10)
+    {
+        uint64_t us = START_US + (uint64_t)t * 1000000ULL;
+        uint32_t ts = (uint32_t)(us / 1000000ULL); // recordHistory()'s clock
+        float tempC = 60.0f + 5.0f * sinf(t / 600.0f);
+        history.append(ts, tempC, 1013.2f, true);
+        uint32_t next;
+        size_t n = history.read(poll, 0, rows, 16, next);
+        if (n == 0 || rows[n - 1].ts != ts)
+            unread++;
+        poll = next;
+    }
+    printf("   %lu s appended from %.1f days of uptime, across the millis() rollover\n", (unsigned long)SPAN_S,
+           START_US / 86400e6);
+    CHECK(unread == 0, "%lu samples not returned by the following read", (unsigned long)unread);
+}
+
+// Random readings in, same readings out (at the stored resolution), including after evictions
+static void roundtrip(unsigned seed)
+{
+    printf("== roundtrip (seed %u)\n", seed);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> temp(15.0f, 95.0f);
+    std::uniform_real_distribution<float> press(950.0f, 1050.0f);
+    std::uniform_int_distribution<uint32_t> gap(1, 30);
+    history = TelemetryHistory();
+    std::vector<TelemetryHistory::Sample> appended;
+    uint32_t ts = 1000;
+    for (int i = 0; i < 5000; i++)
+    {
+        ts += gap(rng);
+        float t = (i % 97 == 0) ? NAN : temp(rng);
+        float p = press(rng);
+        bool on = (i / 200) & 1;
+        history.append(ts, t, p, on);
+        TelemetryHistory::Sample s;
+        s.ts = ts;
+        s.tempCenti = std::isnan(t) ? HISTORY_NO_TEMP : (int16_t)lroundf(t * 100.0f);
+        s.pressDeci = (uint16_t)lroundf(p * 10.0f);
+        s.brewOn = on;
+        appended.push_back(s);
+    }
+    std::vector<TelemetryHistory::Sample> all;
+    TelemetryHistory::Sample rows[16];
+    uint32_t cursor = 0;
+    for (;;)
+    {
+        size_t n = history.read(cursor, 0, rows, 16, cursor);
+        all.insert(all.end(), rows, rows + n);
+        if (n < 16)
+            break;
+    }
+    CHECK(!all.empty() && all.size() < appended.size(), "%zu of %zu samples kept, expected the ring to evict",
+          all.size(), appended.size());
+    size_t base = appended.size() - all.size();
+    uint32_t mismatches = 0;
+    for (size_t i = 0; i < all.size(); i++)
+    {
+        const TelemetryHistory::Sample &a = all[i], &b = appended[base + i];
+        mismatches += a.ts != b.ts || a.tempCenti != b.tempCenti || a.pressDeci != b.pressDeci || a.brewOn != b.brewOn;
+    }
+    printf("   %zu appended, %zu kept (%lu s)\n", appended.size(), all.size(),
+           (unsigned long)(all.back().ts - all.front().ts));
+    CHECK(mismatches == 0, "%lu kept samples differ from what was appended", (unsigned long)mismatches);
+
+    uint32_t stepped = 0, prev = 0;
+    bool spaced = true;
+    cursor = 0;
+    for (;;)
+    {
+        size_t n = history.read(cursor, 60, rows, 16, cursor);
+        for (size_t i = 0; i < n; i++)
+        {
+            spaced &= stepped == 0 || rows[i].ts >= prev + 60;
+            prev = rows[i].ts;
+            stepped++;
+        }
+        if (n < 16)
+            break;
+    }
+    CHECK(spaced && stepped > 0, "step=60 returned samples closer than 60 s apart");
+}
+
+int main(int argc, char **argv)
+{
+    unsigned seed = argc > 1 ? (unsigned)strtoul(argv[1], nullptr, 10) : 1;
+    rollover();
+    roundtrip(seed);
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
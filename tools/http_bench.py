@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+HTTP load benchmark for the Embedded Brew web server.
+
+Runs N concurrent clients against one or more routes for a fixed duration and reports
+requests/sec and latency percentiles per concurrency level. Each client reuses one
+keep-alive connection unless --no-keepalive is given, which mimics a client that
+opens a new connection per request. A request that fails on a reused connection is
+retried once on a new one (as browsers do) and counted under "retries". Responses are tallied
+by status code, so refusals (429/503) are visible next to the latency they buy.
+
+    python3 tools/http_bench.py --host brew.local --paths /metrics / --clients 1 4 8
+"""
+import argparse
+import http.client
+import threading
+import time
+
+
+def percentile(sorted_vals, pct):
+    if not sorted_vals:
+        return float("nan")
+    idx = min(len(sorted_vals) - 1, int(round(pct / 100.0 * (len(sorted_vals) - 1))))
+    return sorted_vals[idx]
+
+
+def worker(args, stop_at, results, errors, retries, codes, idx):
+    conn = None
+    reused = False
+    paths = args.paths
+    i = idx
+    headers = {"Connection": "close"} if args.no_keepalive else {}
+    source = (args.source, 0) if getattr(args, "source", None) else None
+    while time.monotonic() < stop_at:
+        path = paths[i % len(paths)]
+        i += 1
+        t0 = time.perf_counter()
+        for attempt in range(2):
+            try:
+                if conn is None:
+                    conn = http.client.HTTPConnection(args.host, args.port, timeout=args.timeout, source_address=source)
+                    reused = False
+                conn.request(args.method, path, headers=headers)
+                resp = conn.getresponse()
+                resp.read()
+                results.append((time.perf_counter() - t0) * 1000.0)
+                codes.append(resp.status)
+                if args.no_keepalive or resp.getheader("Connection", "").lower() == "close":
+                    conn.close()
+                    conn = None
+                else:
+                    reused = True
+                break
+            except (OSError, http.client.HTTPException):
+                if conn is not None:
+                    conn.close()
+                conn = None
+                if reused and attempt == 0:
+                    # Server closed an idle keep-alive connection - retry once on a fresh one, like a browser
+                    retries.append(1)
+                    continue
+                errors.append(1)
+                break
+    if conn is not None:
+        conn.close()
+
+
+def run(args, clients):
+    results, errors, retries, codes = [], [], [], []
+    stop_at = time.monotonic() + args.duration
+    threads = [threading.Thread(target=worker, args=(args, stop_at, results, errors, retries, codes, n)) for n in range(clients)]
+    t0 = time.monotonic()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    elapsed = time.monotonic() - t0
+    lat = sorted(results)
+    return {
+        "clients": clients,
+        "requests": len(lat),
+        "errors": len(errors),
+        "retries": len(retries),
+        "rps": len(lat) / elapsed if elapsed > 0 else 0.0,
+        "p50": percentile(lat, 50),
+        "p90": percentile(lat, 90),
+        "p99": percentile(lat, 99),
+        "max": lat[-1] if lat else float("nan"),
+        "codes": {c: codes.count(c) for c in sorted(set(codes))},
+    }
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("--host", default="brew.local")
+    ap.add_argument("--port", type=int, default=80)
+    ap.add_argument("--paths", nargs="+", default=["/metrics"], help="routes to request round-robin")
+    ap.add_argument("--method", default="GET")
+    ap.add_argument("--clients", type=int, nargs="+", default=[1, 4, 8], help="concurrency levels to run")
+    ap.add_argument("--duration", type=float, default=10.0, help="seconds per concurrency level")
+    ap.add_argument("--timeout", type=float, default=5.0, help="per-request socket timeout in seconds")
+    ap.add_argument("--no-keepalive", action="store_true", help="open a new connection for every request")
+    ap.add_argument("--source", help="local address to connect from (e.g. 127.0.0.2 to act as another client)")
+    args = ap.parse_args()
+
+    print("[BENCH] %s:%d %s %s keep-alive=%s, %.0fs per level"
+          % (args.host, args.port, args.method, " ".join(args.paths), "off" if args.no_keepalive else "on", args.duration))
+    print("%8s %9s %7s %8s %9s %9s %9s %9s %9s"
+          % ("clients", "requests", "errors", "retries", "req/s", "p50 ms", "p90 ms", "p99 ms", "max ms"))
+    for clients in args.clients:
+        r = run(args, clients)
+        print("%8d %9d %7d %8d %9.1f %9.2f %9.2f %9.2f %9.2f"
+              % (r["clients"], r["requests"], r["errors"], r["retries"], r["rps"], r["p50"], r["p90"], r["p99"], r["max"]))
+        if set(r["codes"]) - {200}:
+            print("%8s status %s" % ("", " ".join("%d x%d" % (c, n) for c, n in r["codes"].items())))
+
+
+if __name__ == "__main__":
+    main()
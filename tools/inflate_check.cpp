@@ -0,0 +1,228 @@
+/*
+Host-side check for the streaming inflater (src/inflate.cpp) against the system zlib.
+
+Build and run from the repository root:
+
+    g++ -O2 -std=c++17 -Isrc tools/inflate_check.cpp src/inflate.cpp -lz -o inflate_check
+    ./inflate_check [seed] [file...]
+
+Every input (built-in samples plus any files given, e.g. a firmware .bin) is compressed with
+wbits 12 at several levels and strategies, then fed to the inflater in random piece sizes of
+1..INFLATE_MAX_FEED bytes, the way HTTP chunks arrive. The decoded output must match byte for
+byte. Truncated, corrupted and oversized-window streams must be rejected.
+
+Exits non-zero if any check fails.
+*/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+#include "inflate.h"
+
+typedef std::vector<uint8_t> Bytes;
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                     \
+    do                                       \
+    {                                        \
+        if (!(cond))                         \
+        {                                    \
+            printf("   FAIL: " __VA_ARGS__); \
+            printf("\n");                    \
+            failures++;                      \
+        }                                    \
+    } while (0)
+
+static Bytes compress(const Bytes &src, int level, int wbits, int strategy)
+{
+    z_stream z = {};
+    deflateInit2(&z, level, Z_DEFLATED, wbits, 8, strategy);
+    Bytes out(deflateBound(&z, src.size()) + 64);
+    z.next_in = (Bytes::value_type *)src.data();
+    z.avail_in = (uInt)src.size();
+    z.next_out = out.data();
+    z.avail_out = (uInt)out.size();
+    deflate(&z, Z_FINISH);
+    out.resize(z.total_out);
+    deflateEnd(&z);
+    return out;
+}
+
+static bool collect(void *ctx, const uint8_t *data, size_t len)
+{
+    Bytes &out = *(Bytes *)ctx;
+    out.insert(out.end(), data, data + len);
+    return true;
+}
+
+static size_t sinkLimit = 0;
+static bool limited(void *ctx, const uint8_t *data, size_t len)
+{
+    collect(ctx, data, len);
+    return ((Bytes *)ctx)->size() <= sinkLimit;
+}
+
+static Inflater inf; // ~7 KB, kept off the stack like the firmware does
+
+// Feed z in random pieces, returns the final status and the decoded bytes in out
+static InflateStatus run(const Bytes &z, Bytes &out, std::mt19937 &rng, size_t maxPiece, InflateSink sink = collect)
+{
+    out.clear();
+    inf.begin(sink, &out);
+    std::uniform_int_distribution<size_t> piece(1, maxPiece);
+    size_t pos = 0;
+    InflateStatus st = InflateStatus::More;
+    while (pos < z.size() && st == InflateStatus::More)
+    {
+        size_t n = std::min(piece(rng), z.size() - pos);
+        st = inf.feed(z.data() + pos, n, pos + n == z.size());
+        pos += n;
+    }
+    return st;
+}
+
+static Bytes sampleText()
+{
+    std::string s;
+    for (int i = 0; i < 4000; i++)
+        s += "{\"t\":" + std::to_string(2000 + i % 700) + ",\"p\":" + std::to_string(101325 + i * 7 % 900) + "}\n";
+    return Bytes(s.begin(), s.end());
+}
+
+// Roughly firmware-shaped: code-like runs, string tables, zero padding and incompressible noise
+static Bytes sampleBinary(std::mt19937 &rng)
+{
+    Bytes b;
+    for (int block = 0; block < 200; block++)
+    {
+        switch (rng() % 4)
+        {
+        case 0:
+            for (int i = 0; i < 1500; i++)
+                b.push_back((uint8_t)(rng() % 16 * 0x11)); // Small alphabet, like opcodes
+            break;
+        case 1:
+        {
+            const char *str = "[WIFI] connected to %s, rssi %d dBm\n";
+            for (int i = 0; i < 40; i++)
+                b.insert(b.end(), str, str + strlen(str));
+            break;
+        }
+        case 2:
+            b.insert(b.end(), 1024 + rng() % 4096, 0xFF); // Erased flash / padding
+            break;
+        default:
+            for (int i = 0; i < 700; i++)
+                b.push_back((uint8_t)rng());
+        }
+    }
+    return b;
+}
+
+static bool readFile(const char *path, Bytes &out)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        out.insert(out.end(), buf, buf + n);
+    fclose(f);
+    return true;
+}
+
+static void roundTrip(const char *name, const Bytes &src, std::mt19937 &rng)
+{
+    struct
+    {
+        int level, strategy;
+        const char *label;
+    } modes[] = {{9, Z_DEFAULT_STRATEGY, "level 9"}, {1, Z_DEFAULT_STRATEGY, "level 1"}, {0, Z_DEFAULT_STRATEGY, "stored"},
+                 {9, Z_FIXED, "fixed"}, {9, Z_HUFFMAN_ONLY, "huffman"}, {9, Z_RLE, "rle"}};
+    for (auto &m : modes)
+    {
+        Bytes z = compress(src, m.level, 12, m.strategy);
+        Bytes out;
+        size_t pieces[] = {1, 7, 300, INFLATE_MAX_FEED};
+        for (size_t maxPiece : pieces)
+        {
+            InflateStatus st = run(z, out, rng, maxPiece);
+            CHECK(st == InflateStatus::Done, "%s %s pieces<=%zu: status %d (%s)", name, m.label, maxPiece, (int)st, inf.error());
+            CHECK(out == src, "%s %s pieces<=%zu: output differs (%zu of %zu bytes)", name, m.label, maxPiece, out.size(), src.size());
+            CHECK(inf.totalIn() == z.size() && inf.totalOut() == src.size(), "%s %s: totals", name, m.label);
+        }
+        printf("   %-10s %-8s %8zu -> %8zu bytes (%5.1f%%)\n", name, m.label, src.size(), z.size(),
+               src.empty() ? 0.0 : 100.0 * z.size() / src.size());
+    }
+}
+
+static void rejects(const Bytes &src, std::mt19937 &rng)
+{
+    Bytes z = compress(src, 9, 12, Z_DEFAULT_STRATEGY);
+    Bytes out;
+
+    CHECK(run(Bytes(z.begin(), z.end() - 3), out, rng, 500) == InflateStatus::Error, "truncated stream accepted");
+
+    Bytes bad = z;
+    bad[bad.size() - 2] ^= 0x01; // Adler-32 trailer
+    CHECK(run(bad, out, rng, 500) == InflateStatus::Error && !strcmp(inf.error(), "Adler-32 mismatch"), "bad trailer: %s", inf.error());
+
+    int caught = 0;
+    for (int i = 0; i < 200; i++)
+    { // Random bit flips in the body must never crash and almost always fail
+        bad = z;
+        size_t at = 2 + rng() % (bad.size() - 6);
+        bad[at] ^= (uint8_t)(1 << rng() % 8);
+        if (run(bad, out, rng, 500) == InflateStatus::Error)
+            caught++;
+    }
+    CHECK(caught >= 195, "only %d of 200 corrupted streams rejected", caught);
+    printf("   %d of 200 single-bit corruptions rejected\n", caught);
+
+    Bytes wide = compress(src, 9, 15, Z_DEFAULT_STRATEGY);
+    CHECK(run(wide, out, rng, 500) == InflateStatus::Error && strstr(inf.error(), "window"), "32 KB window accepted: %s", inf.error());
+
+    bad = z;
+    bad[0] = 0x1F; // gzip magic, not zlib
+    CHECK(run(bad, out, rng, 500) == InflateStatus::Error, "gzip header accepted");
+
+    Bytes tail = z;
+    tail.push_back(0);
+    CHECK(run(tail, out, rng, 500) == InflateStatus::Error, "trailing garbage accepted");
+
+    sinkLimit = src.size() / 2;
+    CHECK(run(z, out, rng, 500, limited) == InflateStatus::Error && strstr(inf.error(), "sink"), "sink failure ignored: %s", inf.error());
+
+    inf.begin(collect, &out);
+    Bytes big(INFLATE_MAX_FEED + 1);
+    CHECK(inf.feed(big.data(), big.size(), false) == InflateStatus::Error, "oversized piece accepted");
+}
+
+int main(int argc, char **argv)
+{
+    unsigned seed = argc > 1 ? (unsigned)atoi(argv[1]) : 1;
+    std::mt19937 rng(seed);
+    printf("== round trip (seed %u)\n", seed);
+    Bytes text = sampleText();
+    Bytes bin = sampleBinary(rng);
+    roundTrip("text", text, rng);
+    roundTrip("binary", bin, rng);
+    roundTrip("empty", Bytes(), rng);
+    for (int i = 2; i < argc; i++)
+    {
+        Bytes file;
+        CHECK(readFile(argv[i], file), "cannot read %s", argv[i]);
+        if (!file.empty())
+            roundTrip(argv[i], file, rng);
+    }
+    printf("== rejects\n");
+    rejects(bin, rng);
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
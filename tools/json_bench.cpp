@@ -0,0 +1,143 @@
+/*
+Host-side microbenchmark: /metrics JSON formatting, legacy String + snprintf path vs JsonWriter.
+
+Build and run from the repository root:
+
+    g++ -O2 -std=c++17 -Isrc tools/json_bench.cpp -o json_bench && ./json_bench
+
+The legacy path is reproduced with LegacyString, a stand-in for Arduino String that keeps its text
+in a heap buffer (String(float, 2) and uptimeString() each return one). Allocations are counted by
+replacing the global operator new/delete.
+*/
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "json_writer.h"
+
+static unsigned long allocCount = 0;
+
+void *operator new(size_t n)
+{
+    allocCount++;
+    void *p = malloc(n ? n : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+void *operator new[](size_t n) { return operator new(n); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+// Heap-backed string standing in for Arduino String
+class LegacyString
+{
+public:
+    explicit LegacyString(const char *s) : buf(new char[strlen(s) + 1]) { strcpy(buf, s); }
+    LegacyString(float v, int decimals)
+    {
+        char tmp[33];
+        snprintf(tmp, sizeof(tmp), "%.*f", decimals, (double)v);
+        buf = new char[strlen(tmp) + 1];
+        strcpy(buf, tmp);
+    }
+    ~LegacyString() { delete[] buf; }
+    const char *c_str() const { return buf; }
+
+private:
+    char *buf;
+};
+
+static LegacyString uptimeString(unsigned long ms)
+{
+    unsigned long s = ms / 1000UL;
+    unsigned long m = s / 60UL;
+    unsigned long h = m / 60UL;
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%luh %lum %lus", h, m % 60, s % 60);
+    return LegacyString(buf);
+}
+
+struct Sample
+{
+    unsigned long ms;
+    float temp;
+    float press;
+};
+
+static size_t legacyMetrics(const Sample &s, char *buf, size_t len)
+{
+    return snprintf(buf, len,
+                    "{\"uptime\":\"%s\",\"temp_c\":%s,\"pressure_hpa\":%s,\"sensor_ok\":%s,\"brew_on\":%s,"
+                    "\"sample_age_ms\":%lu,\"samples\":%lu,\"read_errors\":%lu,"
+                    "\"wifi_mode\":\"%s\",\"network\":\"%s\",\"ip\":\"%u.%u.%u.%u\"}",
+                    uptimeString(s.ms).c_str(),
+                    !std::isnan(s.temp) ? LegacyString(s.temp, 2).c_str() : "null",
+                    !std::isnan(s.press) ? LegacyString(s.press, 2).c_str() : "null",
+                    "true", "false", 120UL, s.ms / 1000UL, 0UL,
+                    "Station (client)", "YOUR_WIFI_SSID", 192u, 168u, 1u, 42u);
+}
+
+static size_t writerMetrics(const Sample &s, char *buf, size_t len)
+{
+    JsonWriter w(buf, len);
+    w.beginObject();
+    w.key("uptime").uptime(s.ms);
+    w.key("temp_c").fixed<2>(s.temp);
+    w.key("pressure_hpa").fixed<2>(s.press);
+    w.key("sensor_ok").boolean(true);
+    w.key("brew_on").boolean(false);
+    w.key("sample_age_ms").number(120);
+    w.key("samples").number(s.ms / 1000UL);
+    w.key("read_errors").number(0);
+    w.key("wifi_mode").str("Station (client)");
+    w.key("network").str("YOUR_WIFI_SSID");
+    w.key("ip").ipv4(192, 168, 1, 42);
+    w.endObject();
+    return w.overflow() ? 0 : w.length();
+}
+
+template <typename Fn>
+static void run(const char *name, Fn fn, const Sample *samples, size_t count, size_t iters)
+{
+    char buf[448];
+    volatile size_t sink = 0;
+    unsigned long allocsBefore = allocCount;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iters; i++)
+        sink = sink + fn(samples[i % count], buf, sizeof(buf));
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / iters;
+    printf("%-14s %9.1f ns/call %6.2f allocs/call\n", name, ns, (double)(allocCount - allocsBefore) / iters);
+}
+
+int main()
+{
+    const size_t COUNT = 64;
+    const size_t ITERS = 2000000;
+    Sample samples[COUNT];
+    for (size_t i = 0; i < COUNT; i++)
+        samples[i] = {i * 61237UL, 20.0f + i * 0.913f, 990.0f + i * 0.377f};
+    samples[7].temp = NAN; // Exercise the null path
+
+    // Both paths must agree on the output before timing them
+    for (size_t i = 0; i < COUNT; i++)
+    {
+        char a[448], b[448];
+        legacyMetrics(samples[i], a, sizeof(a));
+        writerMetrics(samples[i], b, sizeof(b));
+        if (strcmp(a, b) != 0)
+        {
+            printf("[BENCH] Output mismatch for sample %zu:\n  legacy: %s\n  writer: %s\n", i, a, b);
+            return 1;
+        }
+    }
+    run("legacy String", legacyMetrics, samples, COUNT, ITERS);
+    run("JsonWriter", writerMetrics, samples, COUNT, ITERS);
+    return 0;
+}
@@ -0,0 +1,388 @@
+/*
+Host benchmark for the /metrics encoders (src/metrics_store.cpp): bytes per scrape and encode time
+for full JSON, full CBOR and ?since= deltas, plus a batched scrape against one scrape per reading.
+
+Build and run from the repository root:
+
+    g++ -O2 -std=c++17 -Isrc tools/metrics_bench.cpp src/metrics_store.cpp -o metrics_bench
+    ./metrics_bench [scrape interval s]
+
+Replays an hour of 1 Hz readings (idle pot, one brew, keep-warm) through the same field table as
+main.cpp and scrapes it every few seconds the way a collector would. Every CBOR document is
+checked for well-formedness and for the same keys as the JSON one. The /metrics/batch body is
+streamed through writeBatchPart() in HTTP-chunk-sized parts and checked the same way, and a table
+too large for one part must report BATCH_OVERFLOW rather than a truncated body. Exits non-zero on
+a mismatch.
+*/
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "metrics_store.h"
+
+static int failures = 0;
+
+// Fields as in main.cpp
+enum : uint8_t
+{
+    UPTIME,
+    TEMP_C,
+    PRESSURE_HPA,
+    SENSOR_OK,
+    BREW_ON,
+    PHASE,
+    BREW_AT,
+    BREW_DAILY,
+    SAMPLE_AGE_MS,
+    SAMPLES,
+    READ_ERRORS,
+    WIFI_MODE,
+    NETWORK,
+    IP,
+    WIFI_RECONNECTS,
+    BOOT_TO_HTTP_MS,
+    COUNT
+};
+static const MetricField FIELDS[COUNT] = {
+    {"uptime", true},
+    {"temp_c", false},
+    {"pressure_hpa", false},
+    {"sensor_ok", false},
+    {"brew_on", false},
+    {"phase", false},
+    {"brew_at", false},
+    {"brew_daily", false},
+    {"sample_age_ms", true},
+    {"samples", true},
+    {"read_errors", false},
+    {"wifi_mode", false},
+    {"network", false},
+    {"ip", false},
+    {"wifi_reconnects", false},
+    {"boot_to_http_ms", false},
+};
+
+// Walk one CBOR item, collecting top-level map keys; false if malformed
+static bool walk(const uint8_t *&p, const uint8_t *end, int depth, std::vector<std::string> *keys)
+{
+    if (p >= end)
+        return false;
+    uint8_t ib = *p++;
+    uint8_t major = ib >> 5, info = ib & 31;
+    uint64_t arg = info;
+    if (info == 31)
+    { // Indefinite map or array until the break byte
+        if (major != 4 && major != 5)
+            return false;
+        bool isKey = true;
+        while (p < end && *p != 0xFF)
+        {
+            const uint8_t *start = p;
+            if (!walk(p, end, depth + 1, nullptr))
+                return false;
+            if (major == 5 && isKey && depth == 0 && keys)
+            {
+                if ((*start >> 5) != 3)
+                    return false; // Text keys only
+                keys->push_back(std::string((const char *)start + 1, (size_t)(p - start - 1)));
+            }
+            if (major == 5)
+                isKey = !isKey;
+        }
+        if (p >= end || (major == 5 && !isKey))
+            return false;
+        p++;
+        return true;
+    }
+    if (info >= 24 && info <= 27)
+    {
+        uint8_t n = (uint8_t)(1 << (info - 24));
+        if (end - p < n)
+            return false;
+        arg = 0;
+        for (uint8_t i = 0; i < n; i++)
+            arg = arg << 8 | *p++;
+    }
+    else if (info > 27)
+        return false;
+    switch (major)
+    {
+    case 0:
+    case 1:
+    case 7:
+        return true;
+    case 2:
+    case 3:
+        if ((uint64_t)(end - p) < arg)
+            return false;
+        p += arg;
+        return true;
+    case 6:
+        return walk(p, end, depth, nullptr);
+    default:
+        return false; // Definite-length containers are never written
+    }
+}
+
+// Top-level keys of a flat JSON object
+static std::vector<std::string> jsonKeys(const char *s)
+{
+    std::vector<std::string> keys;
+    int depth = 0;
+    bool inStr = false, expectKey = false;
+    std::string cur;
+    for (; *s; s++)
+    {
+        if (inStr)
+        {
+            if (*s == '"')
+            {
+                inStr = false;
+                if (expectKey && depth == 1 && s[1] == ':')
+                    keys.push_back(cur);
+            }
+            else
+                cur += *s;
+            continue;
+        }
+        if (*s == '"')
+        {
+            inStr = true;
+            cur.clear();
+        }
+        else if (*s == '{' || *s == '[')
+            depth++;
+        else if (*s == '}' || *s == ']')
+            depth--;
+        expectKey = true;
+    }
+    return keys;
+}
+
+struct Tally
+{
+    uint64_t bytes = 0;
+    uint64_t ns = 0;
+    uint32_t calls = 0;
+    void add(size_t b, uint64_t t)
+    {
+        bytes += b;
+        ns += t;
+        calls++;
+    }
+};
+
+// Stream a whole /metrics/batch body in parts of cap bytes, false if a part overflowed
+static bool streamBatch(const MetricsTable &table, const RecentSamples &recent, bool cbor, size_t cap, std::string &out)
+{
+    std::vector<char> part(cap);
+    uint32_t cursor = 0, flags = cbor ? BATCH_CBOR : 0;
+    out.clear();
+    for (;;)
+    {
+        size_t n = writeBatchPart(table, recent, 0, 1000, recent.next() * 1000, cursor, flags, part.data(), cap);
+        if (n == BATCH_OVERFLOW)
+            return false;
+        if (n == 0)
+            return true;
+        out.append(part.data(), n);
+    }
+}
+
+// Batch bodies streamed part by part: complete documents normally, an overflow for an oversized table
+static void batchParts(const MetricsTable &table, const RecentSamples &recent)
+{
+    const size_t PART_CAP = 1016; // HTTP_TX_BUF less the chunk size line and CRLF
+    const std::vector<std::string> KEYS = {"metrics", "from", "interval_ms", "rows", "next"};
+    std::string json, cbor;
+    if (!streamBatch(table, recent, false, PART_CAP, json) || jsonKeys(json.c_str()) != KEYS)
+    {
+        printf("   FAIL: JSON batch overflowed or is not one complete object\n");
+        failures++;
+    }
+    bool cborDone = streamBatch(table, recent, true, PART_CAP, cbor);
+    const uint8_t *p = (const uint8_t *)cbor.data(), *end = p + cbor.size();
+    std::vector<std::string> ck;
+    if (!cborDone || !walk(p, end, 0, &ck) || p != end || ck != KEYS)
+    {
+        printf("   FAIL: CBOR batch overflowed or is malformed\n");
+        failures++;
+    }
+    printf("== batch streamed in %zu-byte parts: %zu bytes JSON, %zu bytes CBOR\n", PART_CAP, json.size(), cbor.size());
+
+    // Every field a 32-character string - the metrics object alone is larger than one part
+    static MetricField wide[METRICS_MAX_FIELDS];
+    static char names[METRICS_MAX_FIELDS][24];
+    for (uint8_t i = 0; i < METRICS_MAX_FIELDS; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "oversized_field_%02u", i);
+        wide[i] = {names[i], false};
+    }
+    MetricsTable big(wide, METRICS_MAX_FIELDS);
+    for (uint8_t i = 0; i < METRICS_MAX_FIELDS; i++)
+        big.text(i, "0123456789abcdef0123456789abcdef");
+    big.commit();
+    char probe[2048];
+    JsonWriter jw(probe, sizeof(probe));
+    big.writeJson(jw, 0);
+    bool jsonOverflow = !streamBatch(big, recent, false, PART_CAP, json);
+    bool cborOverflow = !streamBatch(big, recent, true, PART_CAP, cbor);
+    printf("   oversized table: %zu-byte object, JSON %s, CBOR %s\n", jw.length(),
+           jsonOverflow ? "overflow" : "streamed", cborOverflow ? "overflow" : "streamed");
+    if (jw.length() <= PART_CAP || !jsonOverflow || !cborOverflow)
+    {
+        printf("   FAIL: oversized metrics object was not reported as an overflow\n");
+        failures++;
+    }
+}
+
+static uint64_t nowNs()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t interval = argc > 1 ? (uint32_t)atoi(argv[1]) : 5;
+    if (!interval)
+        interval = 5;
+    std::mt19937 rng(1);
+    std::normal_distribution<float> noise(0.0f, 0.004f);
+    MetricsTable table(FIELDS, COUNT);
+    RecentSamples recent;
+    table.begin(0x1234000);
+
+    Tally jsonFull, cborFull, jsonDelta, cborDelta;
+    uint32_t notModified = 0, scrapes = 0;
+    uint32_t lastSeqJson = 0, lastSeqCbor = 0;
+    const uint32_t SPAN_S = 3600;
+    for (uint32_t t = 1; t <= SPAN_S; t++)
+    {
+        // Brew from 10 to 20 min, keep-warm until 50 min, then cooling
+        float temp = 21.0f;
+        bool brewing = t > 600 && t < 3000;
+        if (t > 600 && t <= 1200)
+            temp = 21.0f + (t - 600) * 0.1f;
+        else if (t > 1200 && t < 3000)
+            temp = 81.0f;
+        else if (t >= 3000)
+            temp = 21.0f + 60.0f * expf(-(float)(t - 3000) / 900.0f);
+        temp += noise(rng);
+        float press = 1013.25f + noise(rng) * 2;
+        recent.push(t * 1000, temp, press);
+        if (t % interval)
+            continue;
+
+        // Refresh like refreshMetrics() does
+        table.uptime(UPTIME, t * 1000 + 37);
+        table.fixed2(TEMP_C, temp);
+        table.fixed2(PRESSURE_HPA, press);
+        table.boolean(SENSOR_OK, true);
+        table.boolean(BREW_ON, brewing);
+        table.text(PHASE, t <= 600 ? "idle" : t <= 1200 ? "heating" : t < 3000 ? "keep_warm" : "cooled");
+        table.text(BREW_AT, "06:30");
+        table.boolean(BREW_DAILY, true);
+        table.number(SAMPLE_AGE_MS, 37);
+        table.number(SAMPLES, t);
+        table.number(READ_ERRORS, 0);
+        table.text(WIFI_MODE, "STA");
+        table.text(NETWORK, "YOUR_WIFI_SSID");
+        table.ipv4(IP, 192, 168, 1, 42);
+        table.number(WIFI_RECONNECTS, 1);
+        table.number(BOOT_TO_HTTP_MS, 412);
+        table.commit();
+        scrapes++;
+
+        char jbuf[512];
+        uint8_t cbuf[512];
+        uint64_t t0 = nowNs();
+        JsonWriter jw(jbuf, sizeof(jbuf));
+        table.writeJson(jw, 0);
+        uint64_t t1 = nowNs();
+        CborWriter cw(cbuf, sizeof(cbuf));
+        table.writeCbor(cw, 0);
+        uint64_t t2 = nowNs();
+        jsonFull.add(jw.length(), t1 - t0);
+        cborFull.add(cw.length(), t2 - t1);
+        if (jw.overflow() || cw.overflow() || jw.length() > 480 - 16)
+        {
+            printf("   FAIL: full document too large (%zu JSON, %zu CBOR)\n", jw.length(), cw.length());
+            failures++;
+        }
+
+        const uint8_t *p = cbuf;
+        std::vector<std::string> ck;
+        if (!walk(p, cbuf + cw.length(), 0, &ck) || p != cbuf + cw.length() || ck != jsonKeys(jbuf))
+        {
+            printf("   FAIL: CBOR document malformed or keys differ at t=%u\n", t);
+            failures++;
+        }
+
+        if (lastSeqJson && !table.modifiedSince(lastSeqJson))
+            notModified++; // 304, no body
+        else
+        {
+            t0 = nowNs();
+            JsonWriter dj(jbuf, sizeof(jbuf));
+            table.writeJson(dj, lastSeqJson);
+            t1 = nowNs();
+            CborWriter dc(cbuf, sizeof(cbuf));
+            table.writeCbor(dc, lastSeqCbor);
+            t2 = nowNs();
+            jsonDelta.add(dj.length(), t1 - t0);
+            cborDelta.add(dc.length(), t2 - t1);
+            p = cbuf;
+            ck.clear();
+            if (!walk(p, cbuf + dc.length(), 0, &ck) || ck != jsonKeys(jbuf))
+            {
+                printf("   FAIL: delta CBOR malformed or keys differ at t=%u\n", t);
+                failures++;
+            }
+        }
+        lastSeqJson = lastSeqCbor = table.seq();
+        if (failures > 20)
+            break;
+    }
+
+    auto line = [&](const char *name, const Tally &x, uint32_t n) {
+        printf("   %-12s %8.1f bytes/scrape %8.0f ns/encode\n", name, n ? (double)x.bytes / n : 0.0,
+               x.calls ? (double)x.ns / x.calls : 0.0);
+    };
+    printf("== %u scrapes, one every %u s over %u s of readings\n", scrapes, interval, SPAN_S);
+    line("json full", jsonFull, scrapes);
+    line("cbor full", cborFull, scrapes);
+    line("json since", jsonDelta, scrapes); // Averaged over all scrapes - 304s count as 0 bytes
+    line("cbor since", cborDelta, scrapes);
+    printf("   %u of %u delta scrapes answered 304\n", notModified, scrapes);
+
+    // Batch: one response with RECENT_SAMPLES rows against that many full scrapes
+    size_t jsonRows = 0, cborRows = 0;
+    RecentSamples::Sample s;
+    for (uint32_t n = recent.oldest(); n < recent.next(); n++)
+    {
+        recent.get(n, s);
+        char jb[48];
+        uint8_t cb[32];
+        JsonWriter jw(jb, sizeof(jb));
+        jw.beginArray().number(1000 * (recent.next() - n)).fixed<2>(s.tempCenti / 100.0f).fixed<1>(s.pressDeci / 10.0f).endArray();
+        CborWriter cw(cb, sizeof(cb));
+        cw.beginArray().number(1000 * (recent.next() - n)).fixed<2>(s.tempCenti / 100.0f).fixed<1>(s.pressDeci / 10.0f).endArray();
+        jsonRows += jw.length() + 1;
+        cborRows += cw.length();
+    }
+    uint32_t held = recent.next() - recent.oldest();
+    printf("== batch of %u readings\n", held);
+    printf("   json batch   %8zu bytes   vs %8.0f for %u full scrapes\n", (size_t)(jsonFull.bytes / scrapes) + jsonRows + 40,
+           (double)jsonFull.bytes / scrapes * held, held);
+    printf("   cbor batch   %8zu bytes   vs %8.0f for %u full scrapes\n", (size_t)(cborFull.bytes / scrapes) + cborRows + 30,
+           (double)cborFull.bytes / scrapes * held, held);
+    batchParts(table, recent);
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
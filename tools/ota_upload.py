@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""
+Compressed, resumable OTA upload for Embedded Brew (client for /ota/* in src/ota_receiver.h).
+
+Compresses the firmware image as a zlib stream with a 4 KB window (what the device's inflater
+holds), sends it in CRC-checked chunks that each name their stream offset, and resumes from the
+offset the device reports after a timeout or dropped connection. When every chunk is in, the
+device checks the image MD5 and validity before switching partitions and reboots into it.
+
+    python3 tools/ota_upload.py build/esp32_embedded_brew.ino.bin --host brew.local
+    python3 tools/ota_upload.py firmware.bin --via elegantota     # time the old path for comparison
+
+Reports upload time, bytes on the wire and the compression ratio. --drop-every N closes the
+connection after every N chunks to exercise resume; --no-commit stops before the reboot.
+"""
+import argparse
+import hashlib
+import http.client
+import json
+import os
+import sys
+import time
+import uuid
+import zlib
+
+WBITS = 12  # INFLATE_WINDOW_BITS in src/inflate.h
+MAX_CHUNK = 1792  # Body + headers must fit HTTP_RX_BUF (2048) in src/http_server.h
+
+
+class Link:
+    """One keep-alive connection that is reopened after any error, counting bytes sent."""
+
+    def __init__(self, host, port, timeout):
+        self.host, self.port, self.timeout = host, port, timeout
+        self.conn = None
+        self.sent = 0
+
+    def request(self, method, path, body=None, headers=None):
+        headers = dict(headers or {})
+        try:
+            if self.conn is None:
+                self.conn = http.client.HTTPConnection(self.host, self.port, timeout=self.timeout)
+            self.conn.request(method, path, body=body, headers=headers)
+            resp = self.conn.getresponse()
+            data = resp.read()
+            # Request line + headers are ~120 bytes; count them so the comparison is honest
+            self.sent += len(path) + 120 + (len(body) if body else 0)
+            return resp.status, data
+        except (OSError, http.client.HTTPException):
+            self.close()
+            raise
+
+    def close(self):
+        if self.conn is not None:
+            self.conn.close()
+        self.conn = None
+
+
+def call_json(link, method, path, body=None, headers=None):
+    status, data = link.request(method, path, body, headers)
+    try:
+        return status, json.loads(data)
+    except ValueError:
+        return status, {"error": data.decode(errors="replace")}
+
+
+def with_retries(args, fn):
+    for attempt in range(args.retries + 1):
+        try:
+            return fn()
+        except (OSError, http.client.HTTPException) as e:
+            if attempt == args.retries:
+                raise
+            print(f"  retry after {type(e).__name__}: {e}", file=sys.stderr)
+            time.sleep(min(0.5 * 2**attempt, 5.0))
+
+
+def upload_compressed(args, image):
+    md5 = hashlib.md5(image).hexdigest()
+    comp = zlib.compressobj(args.level, zlib.DEFLATED, WBITS, 9)
+    stream = comp.compress(image) + comp.flush()
+    print(f"image {len(image)} bytes, stream {len(stream)} bytes ({100.0 * len(stream) / len(image):.1f}%), md5 {md5}")
+
+    link = Link(args.host, args.port, args.timeout)
+    t0 = time.monotonic()
+    query = f"/ota/begin?size={len(image)}&zsize={len(stream)}&md5={md5}" + ("&restart=1" if args.restart else "")
+    status, st = with_retries(args, lambda: call_json(link, "POST", query))
+    if status != 200:
+        sys.exit(f"begin failed ({status}): {st.get('error')}")
+    offset = st["offset"]
+    if st.get("resumed"):
+        print(f"resuming at offset {offset}")
+
+    sent_chunks = resent = resumes = 0
+    while offset < len(stream):
+        piece = stream[offset : offset + args.chunk]
+        path = f"/ota/chunk?offset={offset}&crc={zlib.crc32(piece):08x}"
+        try:
+            status, st = call_json(link, "POST", path, piece, {"Content-Type": "application/octet-stream"})
+        except (OSError, http.client.HTTPException) as e:
+            # Dropped connection or lost response - ask the device where to continue
+            resumes += 1
+            print(f"  {type(e).__name__} at offset {offset}, resuming", file=sys.stderr)
+            time.sleep(0.5)
+            status, st = with_retries(args, lambda: call_json(link, "GET", "/ota/status"))
+            if st.get("state") not in ("receiving", "received"):
+                sys.exit(f"session lost ({st.get('state')}): {st.get('error')} - run again with --restart")
+            offset = st["offset"]
+            continue
+        if status == 200:
+            offset += len(piece)
+            sent_chunks += 1
+            if args.drop_every and sent_chunks % args.drop_every == 0:
+                link.close()
+        elif status == 409 and st.get("state") in ("receiving", "received"):
+            resent += 1
+            offset = st["offset"]  # Duplicate or gap - the device's offset wins
+        elif status == 400:
+            resent += 1  # Damaged in transit - send the same chunk again
+            if resent > args.retries * 8:
+                sys.exit(f"too many rejected chunks: {st.get('error')}")
+        else:
+            sys.exit(f"upload failed ({status}, {st.get('state')}): {st.get('error')}")
+        done = min(offset, len(stream))
+        print(f"\r  {done}/{len(stream)} bytes {100.0 * done / len(stream):5.1f}%", end="", flush=True)
+    print()
+    transfer_s = time.monotonic() - t0
+
+    if args.no_commit:
+        print("stream received, not committing (--no-commit)")
+    else:
+        status, st = with_retries(args, lambda: call_json(link, "POST", "/ota/commit"))
+        if status != 200:
+            sys.exit(f"commit failed ({status}): {st.get('error')}")
+        print("image verified, device rebooting")
+    link.close()
+
+    wire = link.sent
+    print(f"upload {transfer_s:.1f} s, {wire} bytes on the wire ({len(stream)} stream), "
+          f"{sent_chunks} chunks, {resent} resent, {resumes} resumes")
+    rate = len(stream) / transfer_s if transfer_s > 0 else 0
+    if rate:
+        legacy = len(image) + 400  # Raw image + multipart framing
+        print(f"raw upload at the same rate: ~{legacy / rate:.1f} s for {legacy} bytes "
+              f"({100.0 * (1 - wire / legacy):.0f}% fewer bytes)")
+
+
+def upload_elegantota(args, image):
+    """The existing path: ElegantOTA on :8080, one multipart POST of the raw image."""
+    md5 = hashlib.md5(image).hexdigest()
+    link = Link(args.host, args.ota_port, max(args.timeout, 120))
+    t0 = time.monotonic()
+    status, _ = link.request("GET", f"/ota/start?mode=fr&hash={md5}")
+    if status != 200:
+        sys.exit(f"ElegantOTA start failed ({status})")
+    boundary = uuid.uuid4().hex
+    body = (f"--{boundary}\r\nContent-Disposition: form-data; name=\"file\"; filename=\"firmware.bin\"\r\n"
+            f"Content-Type: application/octet-stream\r\n\r\n").encode() + image + f"\r\n--{boundary}--\r\n".encode()
+    status, data = link.request("POST", "/ota/upload", body, {"Content-Type": f"multipart/form-data; boundary={boundary}"})
+    elapsed = time.monotonic() - t0
+    link.close()
+    if status != 200:
+        sys.exit(f"ElegantOTA upload failed ({status}): {data[:200]!r}")
+    print(f"ElegantOTA upload {elapsed:.1f} s, {link.sent} bytes on the wire (image {len(image)} bytes)")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("image", help="firmware .bin")
+    ap.add_argument("--host", default="brew.local")
+    ap.add_argument("--port", type=int, default=80)
+    ap.add_argument("--ota-port", type=int, default=8080, help="ElegantOTA port for --via elegantota")
+    ap.add_argument("--via", choices=("compressed", "elegantota"), default="compressed")
+    ap.add_argument("--chunk", type=int, default=1536, help=f"stream bytes per chunk (max {MAX_CHUNK})")
+    ap.add_argument("--level", type=int, default=9, help="zlib level")
+    ap.add_argument("--timeout", type=float, default=10.0, help="seconds per request")
+    ap.add_argument("--retries", type=int, default=8, help="attempts per request before giving up")
+    ap.add_argument("--restart", action="store_true", help="discard a session the device is holding")
+    ap.add_argument("--no-commit", action="store_true", help="upload but do not switch partitions")
+    ap.add_argument("--drop-every", type=int, default=0, help="close the connection every N chunks (resume test)")
+    args = ap.parse_args()
+    if not 1 <= args.chunk <= MAX_CHUNK:
+        ap.error(f"--chunk must be 1..{MAX_CHUNK}")
+    with open(args.image, "rb") as f:
+        image = f.read()
+    if not image:
+        ap.error(f"{args.image} is empty")
+    print(f"{os.path.basename(args.image)} -> {args.host}")
+    if args.via == "elegantota":
+        upload_elegantota(args, image)
+    else:
+        upload_compressed(args, image)
+
+
+if __name__ == "__main__":
+    main()
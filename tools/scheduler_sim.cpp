@@ -0,0 +1,240 @@
+/*
+Host-side simulation for the deadline scheduler (src/scheduler.cpp) with a fake millis() clock.
+
+Build and run from the repository root:
+
+    g++ -O2 -std=c++17 -Isrc tools/scheduler_sim.cpp src/scheduler.cpp -o scheduler_sim
+    ./scheduler_sim [seed]
+
+Three scenarios, all starting a few seconds before the 32-bit millis() rollover:
+    periodic   the firmware's task mix driven by a loop that sleeps until the next deadline, with
+               random handler time and occasional stalls - reports deadline jitter per task and
+               checks that no run is early, no period is lost and the phase survives the wrap
+    oneshot    one-shot tasks whose deadlines straddle the wrap fire in order and on time
+    fuzz       random inserts/cancels (including stale ids) checked against a reference model
+
+Exits non-zero if any check fails.
+*/
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "scheduler.h"
+
+static uint32_t simNow = 0; // Fake millis()
+static int failures = 0;
+
+#define CHECK(cond, ...)                     \
+    do                                       \
+    {                                        \
+        if (!(cond))                         \
+        {                                    \
+            printf("   FAIL: " __VA_ARGS__); \
+            printf("\n");                    \
+            failures++;                      \
+        }                                    \
+    } while (0)
+
+struct Probe
+{
+    const char *name;
+    uint32_t period;
+    uint32_t expect; // Deadline of the next run
+    uint32_t runs;
+    uint32_t early;
+    uint32_t skipped;
+    std::vector<uint32_t> lateMs;
+};
+
+static void probeTask(void *ctx)
+{
+    Probe &p = *(Probe *)ctx;
+    int32_t late = (int32_t)(simNow - p.expect);
+    if (late < 0)
+    {
+        p.early++;
+        return;
+    }
+    p.runs++;
+    p.lateMs.push_back((uint32_t)late);
+    uint32_t missed = (uint32_t)late / p.period;
+    p.skipped += missed;
+    p.expect += (missed + 1) * p.period;
+}
+
+static uint32_t percentile(std::vector<uint32_t> v, double pct)
+{
+    if (v.empty())
+        return 0;
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)(pct / 100.0 * (v.size() - 1) + 0.5);
+    return v[i];
+}
+
+// Loop that sleeps until the next deadline (capped like loop() does), then spends random time in handlers
+static void periodic(unsigned seed)
+{
+    printf("== periodic (seed %u)\n", seed);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> work(0, 8);    // Handler time per iteration
+    std::uniform_int_distribution<uint32_t> stall(0, 999); // 1 in 1000 iterations stalls
+    const uint32_t START = 0xFFFFFFFFUL - 30000; // 30 s before the rollover
+    const uint32_t SPAN = 2 * 3600 * 1000UL;     // Two simulated hours
+    simNow = START;
+    Scheduler s;
+    Probe probes[] = {{"sample", 1000, 0, 0, 0, 0, {}}, {"history", 10000, 0, 0, 0, 0, {}},
+                      {"keepalive", 15000, 0, 0, 0, 0, {}}, {"slow", 3600000, 0, 0, 0, 0, {}}};
+    for (Probe &p : probes)
+    {
+        p.expect = simNow + p.period;
+        CHECK(s.every(simNow, p.period, probeTask, &p) != 0, "every(%s) rejected", p.name);
+    }
+    uint32_t wakes = 0;
+    while (simNow - START < SPAN)
+    {
+        uint32_t wait = s.waitMs(simNow, 250);
+        simNow += wait; // Sleep in select()
+        wakes++;
+        simNow += work(rng);
+        if (stall(rng) == 0)
+            simNow += 1500; // A blocking OTA request, longer than a sample period
+        s.run(simNow);
+    }
+    printf("   %lu ms simulated across the rollover, %lu wake-ups\n", (unsigned long)SPAN, (unsigned long)wakes);
+    printf("   %-10s %7s %8s %8s %8s %8s\n", "task", "runs", "p50 ms", "p99 ms", "max ms", "skipped");
+    for (Probe &p : probes)
+    {
+        printf("   %-10s %7lu %8lu %8lu %8lu %8lu\n", p.name, (unsigned long)p.runs, (unsigned long)percentile(p.lateMs, 50),
+               (unsigned long)percentile(p.lateMs, 99), (unsigned long)percentile(p.lateMs, 100), (unsigned long)p.skipped);
+        CHECK(p.early == 0, "%s ran early %lu times", p.name, (unsigned long)p.early);
+        uint32_t expected = SPAN / p.period;
+        CHECK(p.runs + p.skipped + 1 >= expected && p.runs + p.skipped <= expected, "%s: %lu runs + %lu skipped, expected %lu",
+              p.name, (unsigned long)p.runs, (unsigned long)p.skipped, (unsigned long)expected);
+        CHECK(percentile(p.lateMs, 100) < 1500 + 8 + 250, "%s: lateness beyond the worst stall", p.name);
+    }
+    const SchedStats &st = s.stats();
+    printf("   scheduler: %lu runs, late mean %.2f ms max %lu ms, %lu skipped\n", (unsigned long)st.runs,
+           st.runs ? (double)st.lateSumMs / st.runs : 0.0, (unsigned long)st.lateMaxMs, (unsigned long)st.skipped);
+}
+
+static std::vector<int> fired;
+
+static void recordTask(void *ctx)
+{
+    fired.push_back((int)(intptr_t)ctx);
+}
+
+// One-shots whose deadlines sit on both sides of the wrap must fire in deadline order
+static void oneshot()
+{
+    printf("== oneshot\n");
+    Scheduler s;
+    fired.clear();
+    simNow = 0xFFFFFFFFUL - 2500;
+    const uint32_t delays[] = {4000, 500, 2499, 2500, 2501, 0, 3000};
+    const int order[] = {5, 1, 2, 3, 4, 6, 0}; // Sorted by delay
+    for (int i = 0; i < 7; i++)
+        s.after(simNow, delays[i], recordTask, (void *)(intptr_t)i);
+    CHECK(s.run(simNow) == 1, "only the zero-delay task is due at once");
+    uint32_t deadline;
+    CHECK(s.nextDeadline(deadline) && deadline == simNow + 500, "next deadline before the wrap");
+    for (int step = 0; step < 5000; step++)
+    {
+        simNow++;
+        s.run(simNow);
+    }
+    CHECK(fired.size() == 7, "%zu of 7 one-shots fired", fired.size());
+    for (size_t i = 0; i < fired.size() && i < 7; i++)
+        CHECK(fired[i] == order[i], "position %zu: task %d, expected %d", i, fired[i], order[i]);
+    CHECK(s.size() == 0, "table empty afterwards");
+    printf("   %zu one-shots across the wrap fired in deadline order\n", fired.size());
+}
+
+// Random inserts, cancels and time steps against a reference model
+static void fuzz(unsigned seed)
+{
+    printf("== fuzz (seed %u)\n", seed);
+    std::mt19937 rng(seed);
+    Scheduler s;
+    fired.clear();
+    simNow = 0xFFFFFFFFUL - 100000;
+    std::map<int, std::pair<SchedId, uint32_t>> live; // token -> id, deadline
+    std::vector<SchedId> stale;
+    int token = 0;
+    uint32_t ops = 0, cancels = 0, staleOk = 0;
+    for (int i = 0; i < 200000; i++)
+    {
+        uint32_t r = rng() % 10;
+        if (r < 5 && live.size() < SCHED_MAX_TASKS)
+        {
+            uint32_t delay = rng() % 5000;
+            SchedId id = s.after(simNow, delay, recordTask, (void *)(intptr_t)token);
+            CHECK(id != 0, "insert rejected with %zu live", live.size());
+            live[token++] = {id, simNow + delay};
+        }
+        else if (r < 7 && !live.empty())
+        {
+            auto it = live.begin();
+            std::advance(it, rng() % live.size());
+            CHECK(s.cancel(it->second.first), "cancel of a live task failed");
+            stale.push_back(it->second.first);
+            live.erase(it);
+            cancels++;
+        }
+        else if (r < 8 && !stale.empty())
+        {
+            SchedId id = stale[rng() % stale.size()];
+            bool reused = false;
+            for (auto &kv : live)
+                reused |= kv.second.first == id;
+            if (!reused)
+            { // Same slot and generation only after 255 reuses of that slot
+                CHECK(!s.cancel(id), "stale id cancelled a live task");
+                staleOk++;
+            }
+        }
+        else
+        {
+            simNow += rng() % 400;
+            fired.clear();
+            s.run(simNow);
+            uint32_t prev = 0;
+            for (size_t k = 0; k < fired.size(); k++)
+            {
+                auto it = live.find(fired[k]);
+                CHECK(it != live.end(), "task %d ran after cancel or twice", fired[k]);
+                if (it == live.end())
+                    continue;
+                uint32_t d = it->second.second;
+                CHECK((int32_t)(simNow - d) >= 0, "task %d ran %ld ms early", fired[k], (long)(int32_t)(d - simNow));
+                CHECK(k == 0 || (int32_t)(d - prev) >= 0, "task %d ran out of deadline order", fired[k]);
+                prev = d;
+                stale.push_back(it->second.first);
+                live.erase(it);
+            }
+            for (auto &kv : live)
+                CHECK((int32_t)(simNow - kv.second.second) < 0, "task %d due but not run", kv.first);
+        }
+        if (stale.size() > 64)
+            stale.erase(stale.begin(), stale.begin() + 32);
+        ops++;
+        CHECK(s.size() == live.size(), "size %u, model %zu", s.size(), live.size());
+        if (failures > 20)
+            break;
+    }
+    printf("   %lu ops, %d inserts, %lu cancels, %lu stale cancels rejected\n", (unsigned long)ops, token,
+           (unsigned long)cancels, (unsigned long)staleOk);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned seed = argc > 1 ? (unsigned)atoi(argv[1]) : 1;
+    periodic(seed);
+    oneshot();
+    fuzz(seed);
+    printf(failures ? "FAILED (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}